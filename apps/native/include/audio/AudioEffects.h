@@ -0,0 +1,277 @@
+/**
+ * @file AudioEffects.h
+ * @brief Real-time effect chain for the audio path
+ *
+ * Low-pass sweep (low health), feedback echo (milestones) and a master
+ * limiter. Everything is block processed on the stream thread: parameters
+ * are read from atomics once per block and smoothed there, and all buffers
+ * are allocated up front so process() never allocates.
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "audio/AudioKernels.h"
+
+/**
+ * @brief Second-order low-pass filter (RBJ cookbook, transposed direct form II)
+ */
+class Biquad {
+   private:
+    float mB0, mB1, mB2, mA1, mA2;
+    float mZ1[2];
+    float mZ2[2];
+
+   public:
+    Biquad() : mB0(1.f), mB1(0.f), mB2(0.f), mA1(0.f), mA2(0.f) {
+        reset();
+    }
+
+    void reset() {
+        mZ1[0] = mZ1[1] = 0.f;
+        mZ2[0] = mZ2[1] = 0.f;
+    }
+
+    /**
+     * @brief Recompute low-pass coefficients
+     * @param cutoff Cutoff frequency in Hz
+     * @param sampleRate Sample rate in Hz
+     * @param q Resonance (0.707 = Butterworth)
+     */
+    void setLowPass(float cutoff, float sampleRate, float q = 0.707f) {
+        const float w0 = 2.f * 3.14159265f * cutoff / sampleRate;
+        const float cosW0 = std::cos(w0);
+        const float alpha = std::sin(w0) / (2.f * q);
+        const float a0 = 1.f + alpha;
+
+        mB0 = (1.f - cosW0) * 0.5f / a0;
+        mB1 = (1.f - cosW0) / a0;
+        mB2 = mB0;
+        mA1 = -2.f * cosW0 / a0;
+        mA2 = (1.f - alpha) / a0;
+    }
+
+    /**
+     * @brief Filter an interleaved block in place
+     * @param channels 1 or 2
+     */
+    void process(float* data, std::size_t frames, unsigned channels) {
+#ifdef FALLING_FURY_AUDIO_SSE
+        if (channels == 2) {
+            // Both channels advance together in the low two lanes
+            const __m128 b0 = _mm_set1_ps(mB0), b1 = _mm_set1_ps(mB1),
+                         b2 = _mm_set1_ps(mB2), a1 = _mm_set1_ps(mA1),
+                         a2 = _mm_set1_ps(mA2);
+            __m128 z1 = _mm_set_ps(0.f, 0.f, mZ1[1], mZ1[0]);
+            __m128 z2 = _mm_set_ps(0.f, 0.f, mZ2[1], mZ2[0]);
+            for (std::size_t i = 0; i < frames; ++i) {
+                __m64* frame = reinterpret_cast<__m64*>(data + i * 2);
+                __m128 x = _mm_loadl_pi(_mm_setzero_ps(), frame);
+                __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), z1);
+                z1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)),
+                                z2);
+                z2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+                _mm_storel_pi(frame, y);
+            }
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, z1);
+            mZ1[0] = lanes[0];
+            mZ1[1] = lanes[1];
+            _mm_store_ps(lanes, z2);
+            mZ2[0] = lanes[0];
+            mZ2[1] = lanes[1];
+            return;
+        }
+#endif
+        for (unsigned c = 0; c < channels && c < 2; ++c) {
+            float z1 = mZ1[c];
+            float z2 = mZ2[c];
+            for (std::size_t i = 0; i < frames; ++i) {
+                float& sample = data[i * channels + c];
+                float x = sample;
+                float y = mB0 * x + z1;
+                z1 = mB1 * x - mA1 * y + z2;
+                z2 = mB2 * x - mA2 * y;
+                sample = y;
+            }
+            mZ1[c] = z1;
+            mZ2[c] = z2;
+        }
+    }
+};
+
+/**
+ * @brief Feedback echo on a preallocated delay line
+ */
+class EchoDelay {
+   private:
+    std::vector<float> mLine;  // Interleaved, exactly one delay long
+    std::size_t mWrite;
+    float mSend;
+
+   public:
+    /**
+     * @param delaySeconds Echo time
+     * @param sampleRate Sample rate in Hz
+     * @param channels Interleaved channel count
+     */
+    EchoDelay(float delaySeconds, unsigned sampleRate, unsigned channels)
+        : mLine(static_cast<std::size_t>(delaySeconds * sampleRate) * channels,
+                0.f),
+          mWrite(0),
+          mSend(0.f) {}
+
+    /**
+     * @brief Process a block in place
+     * @param targetSend Dry level fed into the echo; ramped across the block
+     */
+    void process(float* data, std::size_t count, float targetSend, float wet,
+                 float feedback) {
+        const float sendStep =
+            count > 0 ? (targetSend - mSend) / static_cast<float>(count) : 0.f;
+        float send = mSend;
+
+        std::size_t done = 0;
+        while (done < count) {
+            // Split where the ring wraps so each run is contiguous
+            std::size_t run = std::min(count - done, mLine.size() - mWrite);
+            AudioKernels::echo(data + done, mLine.data() + mWrite, run, send,
+                               sendStep, wet, feedback);
+            send += sendStep * static_cast<float>(run);
+            done += run;
+            mWrite = (mWrite + run) % mLine.size();
+        }
+        mSend = targetSend;
+    }
+
+    void clear() {
+        std::fill(mLine.begin(), mLine.end(), 0.f);
+        mSend = 0.f;
+    }
+};
+
+/**
+ * @brief Peak limiter with instant attack and smoothed release
+ */
+class Limiter {
+   private:
+    float mThreshold;
+    float mRelease;  // Per-block recovery towards unity gain
+    float mGain;
+
+   public:
+    explicit Limiter(float threshold = 0.9f, float release = 0.05f)
+        : mThreshold(threshold), mRelease(release), mGain(1.f) {}
+
+    void process(float* data, std::size_t count) {
+        const float blockPeak = AudioKernels::peak(data, count);
+        const float needed =
+            blockPeak > mThreshold ? mThreshold / blockPeak : 1.f;
+
+        if (needed < mGain) {
+            // Clamp the whole block; ramping down would let the peak through
+            mGain = needed;
+            AudioKernels::scale(data, mGain, count);
+        } else {
+            float next = mGain + (needed - mGain) * mRelease;
+            AudioKernels::scaleRamp(data, mGain, next, count);
+            mGain = next;
+        }
+    }
+
+    float getGain() const { return mGain; }
+};
+
+/**
+ * @brief Low-pass -> echo -> limiter chain with game-thread controls
+ */
+class EffectChain {
+   private:
+    static constexpr float OPEN_CUTOFF = 18000.f;
+    static constexpr float CLOSED_CUTOFF = 500.f;
+    static constexpr float ECHO_SECONDS = 0.18f;
+    static constexpr float ECHO_FEEDBACK = 0.45f;
+    static constexpr float ECHO_WET = 0.6f;
+    static constexpr float ECHO_HOLD_SECONDS = 1.2f;
+
+    // Written by the game thread
+    std::atomic<float> mLowPassTarget;
+    std::atomic<unsigned> mEchoTriggers;
+
+    // Stream thread state
+    unsigned mSampleRate;
+    unsigned mChannels;
+    float mLowPassAmount;
+    unsigned mSeenEchoTriggers;
+    float mEchoSend;
+
+    Biquad mLowPass;
+    EchoDelay mEcho;
+    Limiter mLimiter;
+
+   public:
+    EffectChain(unsigned sampleRate, unsigned channels)
+        : mLowPassTarget(0.f),
+          mEchoTriggers(0),
+          mSampleRate(sampleRate),
+          mChannels(channels),
+          mLowPassAmount(0.f),
+          mSeenEchoTriggers(0),
+          mEchoSend(0.f),
+          mEcho(ECHO_SECONDS, sampleRate, channels) {
+        mLowPass.setLowPass(OPEN_CUTOFF, static_cast<float>(sampleRate));
+    }
+
+    /**
+     * @brief Set how muffled the mix is (game thread)
+     * @param amount 0 = open, 1 = fully low-passed
+     */
+    void setLowPassAmount(float amount) {
+        mLowPassTarget.store(std::max(0.f, std::min(1.f, amount)),
+                             std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Start a short echo tail (game thread)
+     */
+    void triggerEcho() { mEchoTriggers.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Run the chain over one interleaved block (stream thread)
+     */
+    void process(float* data, std::size_t frames) {
+        const std::size_t count = frames * mChannels;
+        const float blockSeconds = static_cast<float>(frames) / mSampleRate;
+
+        // Low-pass: glide towards the target, one coefficient update per block
+        const float target = mLowPassTarget.load(std::memory_order_relaxed);
+        mLowPassAmount += (target - mLowPassAmount) *
+                          std::min(1.f, blockSeconds / 0.25f);
+        if (mLowPassAmount > 0.001f) {
+            float cutoff = OPEN_CUTOFF * std::pow(CLOSED_CUTOFF / OPEN_CUTOFF,
+                                                  mLowPassAmount);
+            mLowPass.setLowPass(cutoff, static_cast<float>(mSampleRate));
+            mLowPass.process(data, frames, mChannels);
+        } else {
+            mLowPass.reset();
+        }
+
+        // Echo: each trigger opens the send, which then fades out
+        const unsigned triggers = mEchoTriggers.load(std::memory_order_relaxed);
+        if (triggers != mSeenEchoTriggers) {
+            mSeenEchoTriggers = triggers;
+            mEchoSend = 1.f;
+        } else {
+            mEchoSend = std::max(0.f, mEchoSend - blockSeconds / ECHO_HOLD_SECONDS);
+        }
+        mEcho.process(data, count, mEchoSend, ECHO_WET, ECHO_FEEDBACK);
+
+        mLimiter.process(data, count);
+    }
+
+    float getLimiterGain() const { return mLimiter.getGain(); }
+};
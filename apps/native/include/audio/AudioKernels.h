@@ -0,0 +1,317 @@
+/**
+ * @file AudioKernels.h
+ * @brief Block-processing float kernels for the audio path
+ *
+ * SSE versions are used when the target supports them, with scalar
+ * fallbacks for everything else (including the wasm build)
+ */
+
+#pragma once
+#include <SFML/Config.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FALLING_FURY_AUDIO_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace AudioKernels {
+
+/**
+ * @brief Zero a block of samples
+ */
+inline void clear(float* dst, std::size_t count) {
+    std::fill(dst, dst + count, 0.f);
+}
+
+/**
+ * @brief dst += src * gain
+ */
+inline void mixAdd(float* dst, const float* src, float gain,
+                   std::size_t count) {
+    std::size_t i = 0;
+#ifdef FALLING_FURY_AUDIO_SSE
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        __m128 d = _mm_loadu_ps(dst + i);
+        __m128 s = _mm_loadu_ps(src + i);
+        _mm_storeu_ps(dst + i, _mm_add_ps(d, _mm_mul_ps(s, g)));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] += src[i] * gain;
+    }
+}
+
+/**
+ * @brief dst *= gain
+ */
+inline void scale(float* dst, float gain, std::size_t count) {
+    std::size_t i = 0;
+#ifdef FALLING_FURY_AUDIO_SSE
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), g));
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] *= gain;
+    }
+}
+
+/**
+ * @brief Convert float samples in [-1, 1] to saturated 16-bit PCM
+ */
+inline void toInt16(const float* src, sf::Int16* dst, std::size_t count) {
+    std::size_t i = 0;
+#ifdef FALLING_FURY_AUDIO_SSE
+    const __m128 k = _mm_set1_ps(32767.f);
+    for (; i + 8 <= count; i += 8) {
+        __m128i lo = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i), k));
+        __m128i hi =
+            _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i + 4), k));
+        // packs saturates to [-32768, 32767]
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_packs_epi32(lo, hi));
+    }
+#endif
+    for (; i < count; ++i) {
+        float s = std::max(-1.f, std::min(1.f, src[i]));
+        dst[i] = static_cast<sf::Int16>(s * 32767.f);
+    }
+}
+
+/**
+ * @brief Linearly resample interleaved stereo into dst, advancing position
+ * @param src Interleaved stereo source, followed by one guard frame
+ * @param srcFrames Number of frames in src (excluding the guard frame)
+ * @param position Fractional read position in frames (updated)
+ * @param step Source frames consumed per output frame
+ * @param dst Interleaved stereo destination
+ * @param frames Maximum frames to write
+ * @return Frames actually written (less than frames when src runs out)
+ */
+inline std::size_t resampleStereo(const float* src, std::size_t srcFrames,
+                                  double& position, double step, float* dst,
+                                  std::size_t frames) {
+    std::size_t written = 0;
+    while (written < frames) {
+        std::size_t index = static_cast<std::size_t>(position);
+        if (index >= srcFrames) break;
+
+        float t = static_cast<float>(position - static_cast<double>(index));
+        const float* a = src + index * 2;
+        dst[written * 2] = a[0] + (a[2] - a[0]) * t;
+        dst[written * 2 + 1] = a[1] + (a[3] - a[1]) * t;
+
+        position += step;
+        ++written;
+    }
+    return written;
+}
+
+/**
+ * @brief Wrap a phase into [0, 1)
+ */
+inline float wrapPhase(float phase) {
+    return phase - static_cast<float>(static_cast<int>(phase));
+}
+
+/**
+ * @brief Add a decaying pulse (square) wave to dst
+ * @param phase Oscillator phase in cycles (updated)
+ * @param increment Cycles per sample
+ * @param duty Fraction of the cycle spent high
+ * @param amplitude Current envelope level (updated)
+ * @param decay Per-sample envelope multiplier
+ */
+inline void addPulse(float* dst, std::size_t count, float& phase,
+                     float increment, float duty, float& amplitude,
+                     float decay) {
+    std::size_t i = 0;
+#ifdef FALLING_FURY_AUDIO_SSE
+    if (count >= 4) {
+        const float d2 = decay * decay;
+        __m128 ph = _mm_add_ps(
+            _mm_set1_ps(phase),
+            _mm_mul_ps(_mm_set_ps(3.f, 2.f, 1.f, 0.f), _mm_set1_ps(increment)));
+        __m128 env = _mm_mul_ps(_mm_set1_ps(amplitude),
+                                _mm_set_ps(d2 * decay, d2, decay, 1.f));
+        const __m128 step = _mm_set1_ps(increment * 4.f);
+        const __m128 decay4 = _mm_set1_ps(d2 * d2);
+        const __m128 dutyV = _mm_set1_ps(duty);
+        const __m128 one = _mm_set1_ps(1.f);
+        const __m128 minusOne = _mm_set1_ps(-1.f);
+        for (; i + 4 <= count; i += 4) {
+            __m128 frac = _mm_sub_ps(ph, _mm_cvtepi32_ps(_mm_cvttps_epi32(ph)));
+            __m128 high = _mm_cmplt_ps(frac, dutyV);
+            __m128 wave = _mm_or_ps(_mm_and_ps(high, one),
+                                    _mm_andnot_ps(high, minusOne));
+            _mm_storeu_ps(dst + i,
+                          _mm_add_ps(_mm_loadu_ps(dst + i),
+                                     _mm_mul_ps(wave, env)));
+            ph = _mm_add_ps(frac, step);
+            env = _mm_mul_ps(env, decay4);
+        }
+        phase = wrapPhase(_mm_cvtss_f32(ph));
+        amplitude = _mm_cvtss_f32(env);
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] += (phase < duty ? 1.f : -1.f) * amplitude;
+        phase = wrapPhase(phase + increment);
+        amplitude *= decay;
+    }
+}
+
+/**
+ * @brief Add a decaying triangle wave to dst
+ * @see addPulse
+ */
+inline void addTriangle(float* dst, std::size_t count, float& phase,
+                        float increment, float& amplitude, float decay) {
+    std::size_t i = 0;
+#ifdef FALLING_FURY_AUDIO_SSE
+    if (count >= 4) {
+        const float d2 = decay * decay;
+        __m128 ph = _mm_add_ps(
+            _mm_set1_ps(phase),
+            _mm_mul_ps(_mm_set_ps(3.f, 2.f, 1.f, 0.f), _mm_set1_ps(increment)));
+        __m128 env = _mm_mul_ps(_mm_set1_ps(amplitude),
+                                _mm_set_ps(d2 * decay, d2, decay, 1.f));
+        const __m128 step = _mm_set1_ps(increment * 4.f);
+        const __m128 decay4 = _mm_set1_ps(d2 * d2);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 four = _mm_set1_ps(4.f);
+        const __m128 one = _mm_set1_ps(1.f);
+        const __m128 signMask = _mm_set1_ps(-0.f);
+        for (; i + 4 <= count; i += 4) {
+            __m128 frac = _mm_sub_ps(ph, _mm_cvtepi32_ps(_mm_cvttps_epi32(ph)));
+            // 4 * |frac - 0.5| - 1
+            __m128 wave = _mm_sub_ps(
+                _mm_mul_ps(four, _mm_andnot_ps(signMask, _mm_sub_ps(frac, half))),
+                one);
+            _mm_storeu_ps(dst + i,
+                          _mm_add_ps(_mm_loadu_ps(dst + i),
+                                     _mm_mul_ps(wave, env)));
+            ph = _mm_add_ps(frac, step);
+            env = _mm_mul_ps(env, decay4);
+        }
+        phase = wrapPhase(_mm_cvtss_f32(ph));
+        amplitude = _mm_cvtss_f32(env);
+    }
+#endif
+    for (; i < count; ++i) {
+        float centered = phase - 0.5f;
+        dst[i] += (4.f * (centered < 0.f ? -centered : centered) - 1.f) *
+                  amplitude;
+        phase = wrapPhase(phase + increment);
+        amplitude *= decay;
+    }
+}
+
+/**
+ * @brief Add decaying white noise to dst
+ * @param state xorshift32 state (updated, must be non-zero)
+ */
+inline void addNoise(float* dst, std::size_t count, std::uint32_t& state,
+                     float& amplitude, float decay) {
+    for (std::size_t i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        float white = static_cast<float>(state) * (2.f / 4294967296.f) - 1.f;
+        dst[i] += white * amplitude;
+        amplitude *= decay;
+    }
+}
+
+/**
+ * @brief dst *= gain ramped linearly from startGain towards endGain
+ */
+inline void scaleRamp(float* dst, float startGain, float endGain,
+                      std::size_t count) {
+    if (count == 0) return;
+    const float step = (endGain - startGain) / static_cast<float>(count);
+    std::size_t i = 0;
+#ifdef FALLING_FURY_AUDIO_SSE
+    __m128 gain = _mm_add_ps(
+        _mm_set1_ps(startGain),
+        _mm_mul_ps(_mm_set_ps(3.f, 2.f, 1.f, 0.f), _mm_set1_ps(step)));
+    const __m128 gainStep = _mm_set1_ps(step * 4.f);
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), gain));
+        gain = _mm_add_ps(gain, gainStep);
+    }
+#endif
+    for (; i < count; ++i) {
+        dst[i] *= startGain + step * static_cast<float>(i);
+    }
+}
+
+/**
+ * @brief Largest absolute sample value in a block
+ */
+inline float peak(const float* src, std::size_t count) {
+    float result = 0.f;
+    std::size_t i = 0;
+#ifdef FALLING_FURY_AUDIO_SSE
+    const __m128 signMask = _mm_set1_ps(-0.f);
+    __m128 maxV = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        maxV = _mm_max_ps(maxV, _mm_andnot_ps(signMask, _mm_loadu_ps(src + i)));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, maxV);
+    result = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+#endif
+    for (; i < count; ++i) {
+        result = std::max(result, src[i] < 0.f ? -src[i] : src[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Feedback echo over a delay-line segment, in place
+ *
+ * line[i] holds the sample written one delay length ago; it is read and
+ * then overwritten with the new send + feedback value. Because the delay
+ * is at least as long as the segment, every lane is independent.
+ * @param io Dry signal in, dry + wet out
+ * @param line Delay-line segment aligned with io
+ * @param send Amount of dry signal fed into the line, ramped by sendStep
+ * @param wet Amount of delayed signal added to the output
+ * @param feedback Amount of delayed signal fed back into the line
+ */
+inline void echo(float* io, float* line, std::size_t count, float send,
+                 float sendStep, float wet, float feedback) {
+    std::size_t i = 0;
+#ifdef FALLING_FURY_AUDIO_SSE
+    __m128 sendV = _mm_add_ps(
+        _mm_set1_ps(send),
+        _mm_mul_ps(_mm_set_ps(3.f, 2.f, 1.f, 0.f), _mm_set1_ps(sendStep)));
+    const __m128 sendInc = _mm_set1_ps(sendStep * 4.f);
+    const __m128 wetV = _mm_set1_ps(wet);
+    const __m128 feedbackV = _mm_set1_ps(feedback);
+    for (; i + 4 <= count; i += 4) {
+        __m128 dry = _mm_loadu_ps(io + i);
+        __m128 delayed = _mm_loadu_ps(line + i);
+        _mm_storeu_ps(io + i, _mm_add_ps(dry, _mm_mul_ps(delayed, wetV)));
+        _mm_storeu_ps(line + i, _mm_add_ps(_mm_mul_ps(dry, sendV),
+                                           _mm_mul_ps(delayed, feedbackV)));
+        sendV = _mm_add_ps(sendV, sendInc);
+    }
+#endif
+    for (; i < count; ++i) {
+        float dry = io[i];
+        float delayed = line[i];
+        float currentSend = send + sendStep * static_cast<float>(i);
+        io[i] = dry + delayed * wet;
+        line[i] = dry * currentSend + delayed * feedback;
+    }
+}
+
+}  // namespace AudioKernels
@@ -0,0 +1,471 @@
+/**
+ * @file AudioMixer.h
+ * @brief Software voice mixer running on its own audio thread
+ *
+ * The game thread only ever pushes small commands into a lock-free queue;
+ * all voice state lives on the stream thread that SFML drives through
+ * onGetData(). Mixing is done in float and converted to 16-bit at the end.
+ */
+
+#pragma once
+#include <SFML/Audio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "audio/AudioEffects.h"
+#include "audio/AudioKernels.h"
+#include "systems/SpscQueue.h"
+
+/**
+ * @brief Command sent from the game thread to the mixer thread
+ */
+struct MixerCommand {
+    enum class Type : std::uint8_t {
+        PLAY,
+        STOP,
+        SET_VOLUME,
+        SET_PITCH,
+        SET_MASTER_VOLUME,
+        STOP_ALL
+    };
+
+    Type type = Type::STOP_ALL;
+    std::uint32_t voice = 0;
+    int clip = -1;
+    float volume = 1.f;
+    float pitch = 1.f;
+    std::int64_t enqueuedAtNs = 0;
+};
+
+/**
+ * @brief Trigger-to-mix latency measurements
+ */
+struct MixerLatencyStats {
+    float lastCommandMs;     // Last PLAY command queue->mix delay
+    float maxCommandMs;      // Worst PLAY command queue->mix delay
+    float averageCommandMs;  // Mean PLAY command queue->mix delay
+    float blockMs;           // Duration of one mix block
+    unsigned droppedCommands;
+};
+
+class AudioMixer : public sf::SoundStream {
+   public:
+    using ClipId = int;
+    using VoiceId = std::uint32_t;
+
+    static const unsigned SAMPLE_RATE = 44100;
+    static const unsigned CHANNELS = 2;
+    static const int MAX_VOICES = 32;
+    static const int MAX_CLIPS = 64;
+    static const std::size_t QUEUE_CAPACITY = 256;
+
+   private:
+    /**
+     * @brief Immutable sample data, written once on the game thread
+     */
+    struct Clip {
+        std::vector<float> samples;  // Interleaved stereo
+        std::size_t frames = 0;
+        unsigned sampleRate = SAMPLE_RATE;
+    };
+
+    /**
+     * @brief Playing voice (mixer thread only)
+     */
+    struct Voice {
+        VoiceId id = 0;
+        const Clip* clip = nullptr;
+        double position = 0.0;
+        float volume = 1.f;
+        float pitch = 1.f;
+        bool active = false;
+    };
+
+    // Clip storage (game thread writes before publishing a clip id)
+    std::array<Clip, MAX_CLIPS> mClips;
+    int mClipCount;
+
+    // Slot reuse after replaceClip(): a retired slot may be overwritten
+    // once the mixer has started every PLAY sent for it and no voice
+    // reads it any more
+    std::array<bool, MAX_CLIPS> mClipRetired;                // Game thread
+    std::array<std::uint64_t, MAX_CLIPS> mClipPlaysSent;     // Game thread
+    std::array<std::atomic<std::uint64_t>, MAX_CLIPS> mClipPlaysStarted;
+    std::array<std::atomic<int>, MAX_CLIPS> mClipVoices;
+
+    // Command channel
+    SpscQueue<MixerCommand, QUEUE_CAPACITY> mCommands;
+    VoiceId mNextVoiceId;
+    std::atomic<unsigned> mDroppedCommands;
+
+    // Mixer thread state
+    std::array<Voice, MAX_VOICES> mVoices;
+    float mMasterVolume;
+    std::size_t mBlockFrames;
+    std::vector<float> mMixBuffer;
+    std::vector<float> mScratch;
+    std::vector<sf::Int16> mOutput;
+    EffectChain mEffects;
+
+    // Latency statistics (written by mixer thread, read anywhere)
+    std::atomic<float> mLastLatencyMs;
+    std::atomic<float> mMaxLatencyMs;
+    std::atomic<float> mLatencySumMs;
+    std::atomic<unsigned> mLatencySamples;
+
+    static std::int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    bool send(const MixerCommand& command) {
+        MixerCommand stamped = command;
+        stamped.enqueuedAtNs = nowNs();
+        if (!mCommands.tryPush(stamped)) {
+            // Never block the game thread; the command is simply lost
+            mDroppedCommands.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    std::size_t clipIndex(const Clip* clip) const {
+        return static_cast<std::size_t>(clip - mClips.data());
+    }
+
+    /**
+     * @brief Silence a voice and let go of its clip (mixer thread)
+     */
+    void endVoice(Voice& voice) {
+        if (!voice.active) return;
+        voice.active = false;
+        // Release: the clip's samples are no longer read after this
+        mClipVoices[clipIndex(voice.clip)].fetch_sub(
+            1, std::memory_order_release);
+    }
+
+    bool isClipFree(int clip) const {
+        return mClipRetired[clip] &&
+               mClipPlaysStarted[clip].load(std::memory_order_acquire) ==
+                   mClipPlaysSent[clip] &&
+               mClipVoices[clip].load(std::memory_order_acquire) == 0;
+    }
+
+    /**
+     * @brief A never-used slot, or a retired one nothing plays any more
+     * @return -1 if every slot is taken
+     */
+    int takeClipSlot() {
+        for (int clip = 0; clip < mClipCount; ++clip) {
+            if (isClipFree(clip)) {
+                mClipRetired[clip] = false;
+                return clip;
+            }
+        }
+        return mClipCount < MAX_CLIPS ? mClipCount++ : -1;
+    }
+
+    void recordLatency(std::int64_t enqueuedAtNs) {
+        float ms = static_cast<float>(nowNs() - enqueuedAtNs) / 1.0e6f;
+        mLastLatencyMs.store(ms, std::memory_order_relaxed);
+        if (ms > mMaxLatencyMs.load(std::memory_order_relaxed)) {
+            mMaxLatencyMs.store(ms, std::memory_order_relaxed);
+        }
+        mLatencySumMs.store(mLatencySumMs.load(std::memory_order_relaxed) + ms,
+                            std::memory_order_relaxed);
+        mLatencySamples.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Voice* findVoice(VoiceId id) {
+        for (auto& voice : mVoices) {
+            if (voice.active && voice.id == id) return &voice;
+        }
+        return nullptr;
+    }
+
+    Voice& allocateVoice() {
+        // Free slot first, otherwise steal the oldest voice
+        Voice* oldest = &mVoices[0];
+        for (auto& voice : mVoices) {
+            if (!voice.active) return voice;
+            if (voice.id < oldest->id) oldest = &voice;
+        }
+        return *oldest;
+    }
+
+    /**
+     * @brief Apply all pending commands (mixer thread)
+     */
+    void processCommands() {
+        MixerCommand command;
+        while (mCommands.tryPop(command)) {
+            switch (command.type) {
+                case MixerCommand::Type::PLAY: {
+                    Voice& voice = allocateVoice();
+                    endVoice(voice);
+                    mClipVoices[command.clip].fetch_add(
+                        1, std::memory_order_relaxed);
+                    mClipPlaysStarted[command.clip].fetch_add(
+                        1, std::memory_order_release);
+                    voice.id = command.voice;
+                    voice.clip = &mClips[command.clip];
+                    voice.position = 0.0;
+                    voice.volume = command.volume;
+                    voice.pitch = command.pitch;
+                    voice.active = true;
+                    recordLatency(command.enqueuedAtNs);
+                    break;
+                }
+                case MixerCommand::Type::STOP:
+                    if (Voice* voice = findVoice(command.voice)) {
+                        endVoice(*voice);
+                    }
+                    break;
+                case MixerCommand::Type::SET_VOLUME:
+                    if (Voice* voice = findVoice(command.voice)) {
+                        voice->volume = command.volume;
+                    }
+                    break;
+                case MixerCommand::Type::SET_PITCH:
+                    if (Voice* voice = findVoice(command.voice)) {
+                        voice->pitch = command.pitch;
+                    }
+                    break;
+                case MixerCommand::Type::SET_MASTER_VOLUME:
+                    mMasterVolume = command.volume;
+                    break;
+                case MixerCommand::Type::STOP_ALL:
+                    for (auto& voice : mVoices) {
+                        endVoice(voice);
+                    }
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Mix one voice into the mix buffer (mixer thread)
+     */
+    void mixVoice(Voice& voice) {
+        const Clip& clip = *voice.clip;
+        const double step =
+            voice.pitch * static_cast<double>(clip.sampleRate) / SAMPLE_RATE;
+
+        std::size_t frames;
+        if (step == 1.0) {
+            // Unpitched fast path: mix straight from the clip
+            std::size_t start = static_cast<std::size_t>(voice.position);
+            frames = std::min(mBlockFrames,
+                              clip.frames > start ? clip.frames - start : 0);
+            AudioKernels::mixAdd(mMixBuffer.data(),
+                                 clip.samples.data() + start * CHANNELS,
+                                 voice.volume, frames * CHANNELS);
+            voice.position += static_cast<double>(frames);
+        } else {
+            frames = AudioKernels::resampleStereo(
+                clip.samples.data(), clip.frames, voice.position, step,
+                mScratch.data(), mBlockFrames);
+            AudioKernels::mixAdd(mMixBuffer.data(), mScratch.data(),
+                                 voice.volume, frames * CHANNELS);
+        }
+
+        if (frames < mBlockFrames) {
+            endVoice(voice);
+        }
+    }
+
+   protected:
+    /**
+     * @brief Produce the next block of audio (mixer thread)
+     */
+    bool onGetData(Chunk& data) override {
+        processCommands();
+
+        AudioKernels::clear(mMixBuffer.data(), mMixBuffer.size());
+        for (auto& voice : mVoices) {
+            if (voice.active) mixVoice(voice);
+        }
+        AudioKernels::scale(mMixBuffer.data(), mMasterVolume,
+                            mMixBuffer.size());
+        mEffects.process(mMixBuffer.data(), mBlockFrames);
+        AudioKernels::toInt16(mMixBuffer.data(), mOutput.data(),
+                              mOutput.size());
+
+        data.samples = mOutput.data();
+        data.sampleCount = mOutput.size();
+        return true;  // Endless stream
+    }
+
+    void onSeek(sf::Time) override {}
+
+   public:
+    /**
+     * @brief Constructor
+     * @param blockFrames Frames mixed per block; smaller means lower latency
+     */
+    explicit AudioMixer(std::size_t blockFrames = 512)
+        : mClipCount(0),
+          mClipRetired(),
+          mClipPlaysSent(),
+          mNextVoiceId(1),
+          mDroppedCommands(0),
+          mMasterVolume(1.f),
+          mBlockFrames(blockFrames),
+          mMixBuffer(blockFrames * CHANNELS),
+          mScratch(blockFrames * CHANNELS),
+          mOutput(blockFrames * CHANNELS),
+          mEffects(SAMPLE_RATE, CHANNELS),
+          mLastLatencyMs(0.f),
+          mMaxLatencyMs(0.f),
+          mLatencySumMs(0.f),
+          mLatencySamples(0) {
+        for (int clip = 0; clip < MAX_CLIPS; ++clip) {
+            mClipPlaysStarted[clip].store(0, std::memory_order_relaxed);
+            mClipVoices[clip].store(0, std::memory_order_relaxed);
+        }
+        initialize(CHANNELS, SAMPLE_RATE);
+    }
+
+    ~AudioMixer() override { stop(); }
+
+    /**
+     * @brief Convert a sound buffer into a mixer clip (game thread)
+     * @param buffer Source buffer (mono or stereo 16-bit)
+     * @return Clip id, or -1 if the clip table is full
+     */
+    ClipId addClip(const sf::SoundBuffer& buffer) {
+        const int id = takeClipSlot();
+        if (id < 0) {
+            std::cerr << "ERROR::AUDIOMIXER::Clip table full\n";
+            return -1;
+        }
+
+        Clip& clip = mClips[id];
+        const sf::Int16* samples = buffer.getSamples();
+        const unsigned channels = buffer.getChannelCount();
+        const std::size_t frames =
+            channels > 0 ? buffer.getSampleCount() / channels : 0;
+
+        // One silent guard frame keeps the interpolator in bounds
+        clip.samples.assign((frames + 1) * CHANNELS, 0.f);
+        for (std::size_t i = 0; i < frames; ++i) {
+            float left = samples[i * channels] / 32768.f;
+            float right =
+                channels > 1 ? samples[i * channels + 1] / 32768.f : left;
+            clip.samples[i * CHANNELS] = left;
+            clip.samples[i * CHANNELS + 1] = right;
+        }
+        clip.frames = frames;
+        clip.sampleRate = buffer.getSampleRate();
+
+        // The PLAY command's release store publishes the clip data
+        return id;
+    }
+
+    /**
+     * @brief New sample data for a clip (game thread, e.g. hot reload)
+     *
+     * Voices already playing finish on the old data; its slot is recycled
+     * by a later addClip() or replaceClip() once they have.
+     * @return Id to play the new data with, or -1 if the table is full
+     */
+    ClipId replaceClip(ClipId old, const sf::SoundBuffer& buffer) {
+        const ClipId clip = addClip(buffer);
+        if (clip >= 0 && old >= 0 && old < mClipCount && old != clip) {
+            mClipRetired[old] = true;
+        }
+        return clip;
+    }
+
+    /**
+     * @brief Start a voice (game thread, never blocks)
+     * @return Handle usable with stopVoice/setVoiceVolume/setVoicePitch
+     */
+    VoiceId playClip(ClipId clip, float volume = 1.f, float pitch = 1.f) {
+        if (clip < 0 || clip >= mClipCount || mClipRetired[clip]) return 0;
+
+        MixerCommand command;
+        command.type = MixerCommand::Type::PLAY;
+        command.voice = mNextVoiceId++;
+        command.clip = clip;
+        command.volume = volume;
+        command.pitch = pitch;
+        if (!send(command)) return 0;
+        ++mClipPlaysSent[clip];
+        return command.voice;
+    }
+
+    void stopVoice(VoiceId voice) {
+        MixerCommand command;
+        command.type = MixerCommand::Type::STOP;
+        command.voice = voice;
+        send(command);
+    }
+
+    void setVoiceVolume(VoiceId voice, float volume) {
+        MixerCommand command;
+        command.type = MixerCommand::Type::SET_VOLUME;
+        command.voice = voice;
+        command.volume = volume;
+        send(command);
+    }
+
+    void setVoicePitch(VoiceId voice, float pitch) {
+        MixerCommand command;
+        command.type = MixerCommand::Type::SET_PITCH;
+        command.voice = voice;
+        command.pitch = pitch;
+        send(command);
+    }
+
+    /**
+     * @brief Set the gain applied to the whole mix
+     * @param volume Linear gain (0-1)
+     */
+    void setMasterVolume(float volume) {
+        MixerCommand command;
+        command.type = MixerCommand::Type::SET_MASTER_VOLUME;
+        command.volume = volume;
+        send(command);
+    }
+
+    void stopAllVoices() {
+        MixerCommand command;
+        command.type = MixerCommand::Type::STOP_ALL;
+        send(command);
+    }
+
+    /**
+     * @brief Get latency statistics
+     *
+     * Command latency is queue-to-mix time; the device adds roughly
+     * (SFML buffer count) x blockMs on top of that.
+     */
+    MixerLatencyStats getLatencyStats() const {
+        MixerLatencyStats stats;
+        unsigned samples = mLatencySamples.load(std::memory_order_relaxed);
+        stats.lastCommandMs = mLastLatencyMs.load(std::memory_order_relaxed);
+        stats.maxCommandMs = mMaxLatencyMs.load(std::memory_order_relaxed);
+        stats.averageCommandMs =
+            samples > 0
+                ? mLatencySumMs.load(std::memory_order_relaxed) / samples
+                : 0.f;
+        stats.blockMs = 1000.f * mBlockFrames / SAMPLE_RATE;
+        stats.droppedCommands =
+            mDroppedCommands.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /**
+     * @brief Master-bus effects; its setters are safe from the game thread
+     */
+    EffectChain& getEffects() { return mEffects; }
+
+    std::size_t getBlockFrames() const { return mBlockFrames; }
+    int getClipCount() const { return mClipCount; }
+};
@@ -0,0 +1,270 @@
+/**
+ * @file MusicGenerator.h
+ * @brief Procedural chiptune background music
+ *
+ * Synthesizes a looping four-bar progression in real time on the stream
+ * thread, so the game ships no music assets. Intensity (0-1) raises the
+ * tempo and brings in extra layers; changes are latched on bar boundaries
+ * so the groove never stutters.
+ */
+
+#pragma once
+#include <SFML/Audio.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "audio/AudioEffects.h"
+#include "audio/AudioKernels.h"
+
+class MusicGenerator : public sf::SoundStream {
+   public:
+    static const unsigned SAMPLE_RATE = 44100;
+    static const int STEPS_PER_BAR = 16;
+    static const int BARS = 4;
+
+   private:
+    static constexpr float MIN_BPM = 100.f;
+    static constexpr float MAX_BPM = 160.f;
+
+    /**
+     * @brief One decaying oscillator voice
+     */
+    struct Tone {
+        float phase = 0.f;
+        float increment = 0.f;
+        float amplitude = 0.f;
+        float decay = 1.f;
+    };
+
+    // Layers, in the order intensity unlocks them
+    enum Layer { BASS, DRUMS, ARP, LEAD, LAYER_COUNT };
+
+    // Shared with the game thread
+    std::atomic<float> mIntensity;
+    std::atomic<float> mCpuLoad;
+
+    // Stream thread state
+    float mBarIntensity;  // Intensity latched at the last bar line
+    float mBpm;
+    int mStep;  // 0 .. STEPS_PER_BAR * BARS - 1
+    std::size_t mSamplesUntilStep;
+    std::array<float, LAYER_COUNT> mLayerGain;
+
+    Tone mBass;
+    Tone mArp;
+    Tone mLead;
+    Tone mKick;
+    float mNoiseAmplitude;
+    float mNoiseDecay;
+    std::uint32_t mNoiseState;
+
+    std::vector<float> mMix;
+    std::vector<sf::Int16> mOutput;
+    EffectChain mEffects;
+
+    static float midiToFrequency(int note) {
+        return 440.f * std::pow(2.f, (note - 69) / 12.f);
+    }
+
+    static float decayFor(float seconds) {
+        // Multiplier that reaches -60 dB after the given time
+        return std::pow(0.001f, 1.f / (seconds * SAMPLE_RATE));
+    }
+
+    void trigger(Tone& tone, int note, float level, float seconds) {
+        tone.increment = midiToFrequency(note) / SAMPLE_RATE;
+        tone.amplitude = level;
+        tone.decay = decayFor(seconds);
+    }
+
+    std::size_t samplesPerStep() const {
+        // Sixteenth notes
+        return static_cast<std::size_t>(SAMPLE_RATE * 60.f / (mBpm * 4.f));
+    }
+
+    /**
+     * @brief Fire the notes that start on the current step
+     */
+    void onStep() {
+        // Am - F - C - G, one chord per bar
+        static const int ROOTS[BARS] = {45, 41, 48, 43};
+        static const int THIRDS[BARS] = {3, 4, 4, 4};
+        // Pentatonic lead line, -1 = rest
+        static const int LEAD_LINE[STEPS_PER_BAR] = {
+            12, -1, 15, -1, 19, -1, 17, 15, -1, 12, -1, 10, 12, -1, -1, -1};
+
+        const int bar = mStep / STEPS_PER_BAR;
+        const int step = mStep % STEPS_PER_BAR;
+        const int root = ROOTS[bar];
+
+        if (step == 0) {
+            // Tempo and layer changes only happen on the bar line
+            mBarIntensity = mIntensity.load(std::memory_order_relaxed);
+            mBpm = MIN_BPM + (MAX_BPM - MIN_BPM) * mBarIntensity;
+        }
+
+        // Bass: root on the beat, fifth on the offbeat eighths
+        if (step % 4 == 0) {
+            trigger(mBass, root - 12, 1.f, 0.35f);
+        } else if (step % 4 == 2 && mBarIntensity > 0.4f) {
+            trigger(mBass, root - 5, 0.7f, 0.2f);
+        }
+
+        // Drums: kick, snare-ish noise, hats
+        if (step % 8 == 0 || (mBarIntensity > 0.6f && step % 4 == 0)) {
+            trigger(mKick, 33, 1.f, 0.12f);
+        }
+        if (step % 8 == 4) {
+            mNoiseAmplitude = 0.6f;
+            mNoiseDecay = decayFor(0.15f);
+        } else if (step % 2 == 0 || mBarIntensity > 0.8f) {
+            mNoiseAmplitude = 0.2f;
+            mNoiseDecay = decayFor(0.03f);
+        }
+
+        // Arpeggio over the chord, two octaves up
+        const int arpTones[4] = {0, THIRDS[bar], 7, THIRDS[bar]};
+        trigger(mArp, root + 24 + arpTones[step % 4], 0.5f, 0.09f);
+
+        // Lead melody
+        if (LEAD_LINE[step] >= 0) {
+            trigger(mLead, root + 12 + LEAD_LINE[step], 0.6f, 0.25f);
+        }
+    }
+
+    /**
+     * @brief Render a run of samples that contains no step boundary
+     */
+    void renderSegment(float* dst, std::size_t count) {
+        float bassAmp = mBass.amplitude * mLayerGain[BASS];
+        AudioKernels::addTriangle(dst, count, mBass.phase, mBass.increment,
+                                  bassAmp, mBass.decay);
+        mBass.amplitude *= std::pow(mBass.decay, static_cast<float>(count));
+
+        float kickAmp = mKick.amplitude * mLayerGain[DRUMS];
+        AudioKernels::addTriangle(dst, count, mKick.phase, mKick.increment,
+                                  kickAmp, mKick.decay);
+        mKick.amplitude *= std::pow(mKick.decay, static_cast<float>(count));
+
+        float noiseAmp = mNoiseAmplitude * mLayerGain[DRUMS];
+        AudioKernels::addNoise(dst, count, mNoiseState, noiseAmp, mNoiseDecay);
+        mNoiseAmplitude *= std::pow(mNoiseDecay, static_cast<float>(count));
+
+        float arpAmp = mArp.amplitude * mLayerGain[ARP];
+        AudioKernels::addPulse(dst, count, mArp.phase, mArp.increment, 0.25f,
+                               arpAmp, mArp.decay);
+        mArp.amplitude *= std::pow(mArp.decay, static_cast<float>(count));
+
+        float leadAmp = mLead.amplitude * mLayerGain[LEAD];
+        AudioKernels::addPulse(dst, count, mLead.phase, mLead.increment, 0.5f,
+                               leadAmp, mLead.decay);
+        mLead.amplitude *= std::pow(mLead.decay, static_cast<float>(count));
+    }
+
+    void updateLayerGains() {
+        // Each layer fades in over its own quarter of the intensity range
+        for (int layer = 0; layer < LAYER_COUNT; ++layer) {
+            float threshold = layer * 0.25f;
+            float target =
+                layer == BASS
+                    ? 1.f
+                    : std::max(0.f,
+                               std::min(1.f, (mBarIntensity - threshold) * 8.f));
+            mLayerGain[layer] += (target - mLayerGain[layer]) * 0.05f;
+        }
+    }
+
+   protected:
+    bool onGetData(Chunk& data) override {
+        auto start = std::chrono::steady_clock::now();
+
+        AudioKernels::clear(mMix.data(), mMix.size());
+        updateLayerGains();
+
+        std::size_t offset = 0;
+        while (offset < mMix.size()) {
+            if (mSamplesUntilStep == 0) {
+                onStep();
+                mStep = (mStep + 1) % (STEPS_PER_BAR * BARS);
+                mSamplesUntilStep = samplesPerStep();
+            }
+            std::size_t run =
+                std::min(mSamplesUntilStep, mMix.size() - offset);
+            renderSegment(mMix.data() + offset, run);
+            offset += run;
+            mSamplesUntilStep -= run;
+        }
+
+        AudioKernels::scale(mMix.data(), 0.2f, mMix.size());
+        mEffects.process(mMix.data(), mMix.size());
+        AudioKernels::toInt16(mMix.data(), mOutput.data(), mOutput.size());
+
+        // Fraction of real time spent synthesizing
+        float elapsed = std::chrono::duration<float>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+        float audio = static_cast<float>(mMix.size()) / SAMPLE_RATE;
+        mCpuLoad.store(elapsed / audio, std::memory_order_relaxed);
+
+        data.samples = mOutput.data();
+        data.sampleCount = mOutput.size();
+        return true;
+    }
+
+    void onSeek(sf::Time) override {
+        mStep = 0;
+        mSamplesUntilStep = 0;
+    }
+
+   public:
+    /**
+     * @brief Constructor
+     * @param blockSamples Samples synthesized per stream buffer
+     */
+    explicit MusicGenerator(std::size_t blockSamples = 2048)
+        : mIntensity(0.f),
+          mCpuLoad(0.f),
+          mBarIntensity(0.f),
+          mBpm(MIN_BPM),
+          mStep(0),
+          mSamplesUntilStep(0),
+          mLayerGain{},
+          mNoiseAmplitude(0.f),
+          mNoiseDecay(1.f),
+          mNoiseState(0x9E3779B9u),
+          mMix(blockSamples),
+          mOutput(blockSamples),
+          mEffects(SAMPLE_RATE, 1) {
+        initialize(1, SAMPLE_RATE);
+    }
+
+    ~MusicGenerator() override { stop(); }
+
+    /**
+     * @brief Set musical intensity (game thread, lock-free)
+     * @param intensity 0 = calm, 1 = full tempo with all layers
+     */
+    void setIntensity(float intensity) {
+        mIntensity.store(std::max(0.f, std::min(1.f, intensity)),
+                         std::memory_order_relaxed);
+    }
+
+    float getIntensity() const {
+        return mIntensity.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Effects applied to the music; setters are safe from the game thread
+     */
+    EffectChain& getEffects() { return mEffects; }
+
+    /**
+     * @brief Synthesis time as a fraction of one core (0.01 = 1%)
+     */
+    float getCpuLoad() const { return mCpuLoad.load(std::memory_order_relaxed); }
+};
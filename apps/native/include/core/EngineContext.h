@@ -0,0 +1,139 @@
+/**
+ * @file EngineContext.h
+ * @brief What a game world may use, passed in instead of reached through
+ * singletons
+ *
+ * EngineContext is the part of the process that worlds share: loaded
+ * resources, which are only read once loading is done (ResourceManager
+ * lookups take no lock), and the audio device. WorldContext is one world's
+ * own state: its Simulation, its ScoreManager and whether it is heard.
+ * A world touches nothing global, so N of them (split-screen, batch
+ * simulation, a session host) can be stepped on N threads at once, as
+ * long as each world is only stepped by one thread at a time.
+ *
+ * A headless engine has no resources at all: worlds that are never drawn
+ * need none, and the ResourceManager's upload thread wants a GL context.
+ *
+ * There is one audio device per process and AudioMixer takes commands
+ * from a single thread, so sound is only reachable from the thread that
+ * created the engine, and only for the world marked audible.
+ */
+
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+#include "managers/ResourceManager.h"
+#include "managers/ScoreManager.h"
+#include "managers/SoundManager.h"
+#include "sim/Simulation.h"
+
+class EngineContext {
+   private:
+    ResourceManager* mResources;  // nullptr: headless
+    bool mAudio;  // Off for headless hosts: no device is ever opened
+    std::thread::id mAudioThread;
+
+   public:
+    /**
+     * @param resources Loaded before worlds start and shared by all of
+     * them; nullptr for worlds that are never drawn
+     * @param audio Whether worlds may reach the process' SoundManager
+     */
+    EngineContext(ResourceManager* resources, bool audio)
+        : mResources(resources),
+          mAudio(audio),
+          mAudioThread(std::this_thread::get_id()) {}
+
+    /**
+     * @brief No resources, no audio: for simulation and session hosts
+     */
+    static EngineContext headless() { return EngineContext(nullptr, false); }
+
+    EngineContext(const EngineContext&) = delete;
+    EngineContext& operator=(const EngineContext&) = delete;
+
+    bool hasResources() const { return mResources != nullptr; }
+
+    /**
+     * @throws std::runtime_error for a headless engine
+     */
+    ResourceManager& getResources() const {
+        if (mResources == nullptr) {
+            throw std::runtime_error(
+                "ERROR::ENGINECONTEXT::Headless engine has no resources");
+        }
+        return *mResources;
+    }
+
+    /**
+     * @brief Whether the calling thread may use getSound()
+     */
+    bool canPlayAudio() const {
+        return mAudio && std::this_thread::get_id() == mAudioThread;
+    }
+
+    /**
+     * @brief The process audio device; only when canPlayAudio()
+     *
+     * Created on first use, so a game can defer it past its first frame.
+     */
+    SoundManager& getSound() const { return SoundManager::getInstance(); }
+};
+
+class WorldContext {
+   private:
+    const EngineContext& mEngine;
+    unsigned mId;
+    Simulation mSim;
+    ScoreManager mScores;
+    bool mAudible;
+
+   public:
+    WorldContext(const EngineContext& engine, unsigned id,
+                 const SimConfig& config, std::uint64_t seed)
+        : mEngine(engine),
+          mId(id),
+          mSim(config, seed),
+          mScores(ScoreManager::InMemory()),
+          mAudible(false) {}
+
+    WorldContext(const WorldContext&) = delete;
+    WorldContext& operator=(const WorldContext&) = delete;
+
+    const EngineContext& getEngine() const { return mEngine; }
+    unsigned getId() const { return mId; }
+
+    Simulation& getSim() { return mSim; }
+    const Simulation& getSim() const { return mSim; }
+    ScoreManager& getScores() { return mScores; }
+    const ScoreManager& getScores() const { return mScores; }
+
+    /**
+     * @brief A shared font; read-only, so any world's thread may use it
+     * @throws std::runtime_error if the font is not loaded or the engine
+     * is headless
+     */
+    const sf::Font& getFont(ResourceId id) const {
+        return mEngine.getResources().getFont(id);
+    }
+
+    /**
+     * @brief At most one world should be audible at a time
+     */
+    void setAudible(bool audible) { mAudible = audible; }
+    bool isAudible() const { return mAudible; }
+
+    /**
+     * @brief Whether this world's sounds reach the speakers from here
+     */
+    bool canPlayAudio() const { return mAudible && mEngine.canPlayAudio(); }
+
+    /**
+     * @brief Play a sound effect if this world is heard; otherwise nothing
+     */
+    void playSound(ResourceId id, float pitch = 1.f) {
+        if (canPlayAudio()) mEngine.getSound().playSound(id, pitch);
+    }
+};
@@ -7,13 +7,27 @@
 #include <algorithm>
 #include <ctime>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
 
-#include "managers/ResourceManager.h"
+#include "core/EngineContext.h"
+#include "sim/Bot.h"
+#include "sim/SfmlAdapter.h"
+#include "sim/Simulation.h"
+#include "systems/CVarRegistry.h"
+#include "systems/FrameAllocations.h"
+#include "systems/ParticleSystem.h"
+#include "ui/AtlasText.h"
+#include "ui/DevConsole.h"
+#include "ui/GlyphAtlas.h"
+
+#ifdef FALLING_FURY_HOT_RELOAD
+#include "systems/HotReloader.h"
+#endif
 
 class Game {
     // Local variable: variableName;
@@ -24,6 +38,9 @@ class Game {
 
    private:
     // Variables
+    // Resources and audio, as every world sees them
+    EngineContext mEngine;
+
     // Window
     sf::VideoMode mVideoMode;
     std::unique_ptr<sf::RenderWindow> mWindow;
@@ -33,23 +50,25 @@ class Game {
     sf::Vector2i mMousePosWindow;
     sf::Vector2f mMousePosView;
 
-    // Text
-    sf::Text mUiText;
-    sf::Text mMaxpointText;
-    sf::Text mRestartText;
-
-    // Game Logic
+    // Text (drawn from the prewarmed glyph atlas; replaced whole when the
+    // font is hot reloaded)
+    std::unique_ptr<GlyphAtlas> mGlyphAtlas;
+    AtlasText mUiText;
+    AtlasText mMaxpointText;
+    AtlasText mRestartText;
+    AtlasText mAllocText;  // show_allocs overlay
+
+    // Game Logic (rules and state live in the window-free core)
+    Simulation mSim;
+    Bot mBot;  // Plays instead of the mouse when autoplay is on
+    bool mAutoplay = false;
     unsigned mMaxPoint;
-    unsigned mPoints;
-    int mHealth;
-
-    float mEnemySpawnTimer;
-    float mEnemySpawnTimerMax;
-    const int MAX_ENEMIES = 30;
-    bool mMouseHeld;
-    bool mEndGame;
-    float mGravity = 120.f;  // Pixels per second
-    unsigned mDistance = 0;
+    const float POINTS_FOR_MAX_INTENSITY = 50.f;  // Music fully ramped up
+    const int LOW_HEALTH = 3;             // Audio starts to muffle below this
+    const unsigned POINTS_PER_MILESTONE = 10;  // Echo cue interval
+    // Game text, then Button and Slider labels
+    const std::vector<unsigned> GLYPH_SIZES = {50, 40, 24, 18};
+    const std::vector<unsigned> UI_TEXT_SIZES = {24, 18};  // Still sf::Text
 
     // Delta Time
     sf::Clock mDeltaClock;
@@ -60,18 +79,56 @@ class Game {
     int mSpeed = 50;
 
     // Game object
-    std::vector<sf::RectangleShape> mEnemies;
-    sf::RectangleShape mEnemy;
+    sf::RectangleShape mEnemy;  // Stamp for the unbatched path
+    sf::VertexArray mEnemyVertices;  // Batched enemy quads
+    ParticleSystem mParticles;
+
+    // Tuning, editable in the dev console (F1) and saved to the profile
+    CVarRegistry mCVars;
+    std::unique_ptr<DevConsole> mConsole;
+    unsigned mFrameLimit;
+    bool mVsync = false;
+    bool mBatchEnemies = true;
+    int mParticlePoolSize = 200;
+    const std::string PROFILE_PATH = "data/profile.cfg";
+
+    // Heap allocations per frame, by subsystem
+    FrameAllocationMonitor mFrameAllocations;
+    bool mAllocAssert = false;
+    bool mShowAllocs = false;
+    bool mFrameSteady = false;  // Gameplay only: nothing should allocate
+
+    // Startup: audio comes up after the first frame is on screen
+    bool mFirstFrameShown;
+    bool mExitAfterFirstFrame;  // Startup benchmark child
+
+#ifdef FALLING_FURY_HOT_RELOAD
+    // Development builds pick up edited assets without a restart
+    std::unique_ptr<HotReloader> mHotReloader;
+    // A font edit rebuilds the atlas on a worker while the new font's
+    // sf::Text glyphs are rasterized a few per frame; all text switches
+    // over in the frame both are done
+    static const std::size_t FONT_GLYPHS_PER_FRAME = 16;
+    std::future<std::unique_ptr<GlyphAtlas>> mAtlasRebuild;
+    std::string mQueuedFontPath;     // Edited again during a rebuild
+    std::size_t mFontGlyphsWarmed = 0;
+    void initHotReload();
+    void startAtlasRebuild(const std::string& fontPath);
+    void updateFontReload();
+#endif
 
     // Privet Functions
     void initWindow();
+    void initGlyphs();
     void initText();
     void initMaxPoint();
     void initEnemies();
+    void initCVars();
+    void onFirstFrame();
 
    public:
     // Constructors
-    Game();
+    explicit Game(bool exitAfterFirstFrame = false, bool autoplay = false);
     virtual ~Game();
 
     // accessors
@@ -79,8 +136,6 @@ class Game {
     const bool getEndGame() const;
 
     // functions
-    void spawnEnemy();
-
     void nextColor();
     void updateDeltaTime();
 
@@ -94,6 +149,7 @@ class Game {
     // std::string resetData();
     void renderMaxPoint();
     void renderText();
+    void renderAllocations();
     void renderEnemies();
     void render();
 };
\ No newline at end of file
@@ -1,154 +1,122 @@
 /**
  * @file PlayingState.h
  * @brief The main gameplay state
+ *
+ * Plays one WorldContext: its Simulation holds the rules and its
+ * ScoreManager the combo score. Input comes in through setInput(), from
+ * the mouse (updateWithWindow), a Bot or the network, and update() steps
+ * the world with it. Stepping reaches nothing outside the world, so
+ * several PlayingStates can be updated on different threads at once;
+ * only render() needs the window and the shared font.
  */
 
 #pragma once
-#include <sstream>
-#include <vector>
+#include <cstdio>
 
+#include "core/EngineContext.h"
 #include "core/GameState.h"
-#include "managers/ResourceManager.h"
+#include "sim/SfmlAdapter.h"
 
 class PlayingState : public GameState {
    private:
-    // Game objects
-    std::vector<sf::RectangleShape> mEnemies;
-    sf::RectangleShape mEnemy;
+    WorldContext& mWorld;
+    SimInput mInput;  // Applied by the next update()
+    const unsigned POINTS_PER_MILESTONE = 10;  // Echo cue interval
 
-    // UI
+    // Drawing only
+    sf::RectangleShape mEnemy;
     sf::Text mUiText;
+    bool mTextReady;  // The font is bound on first render
+    char mHud[64];
 
-    // Game logic
-    unsigned mPoints;
-    int mHealth;
-    float mEnemySpawnTimer;
-    float mEnemySpawnTimerMax;
-    const int MAX_ENEMIES = 30;
-    bool mMouseHeld;
-    float mGravity = 200.f;
-
-    // Mouse position
-    sf::Vector2i mMousePosWindow;
-    sf::Vector2f mMousePosView;
-
-    void initEnemies() {
-        mEnemy.setPosition(10.f, 10.f);
-        mEnemy.setSize(sf::Vector2f(100.f, 100.f));
-        mEnemy.setScale(sf::Vector2f(0.5f, 0.5f));
-        mEnemy.setFillColor(sf::Color::Green);
-    }
+    void initEnemies() { mEnemy.setFillColor(sf::Color::Green); }
 
     void initText() {
-        mUiText.setFont(ResourceManager::getInstance().getFont("main"));
+        mUiText.setFont(mWorld.getFont(ResourceIds::MAIN_FONT));
         mUiText.setCharacterSize(50);
         mUiText.setFillColor(sf::Color::Cyan);
         mUiText.setPosition(170.f, 30.f);
-        mUiText.setString("Health: 10 | Points: 0");
-    }
-
-    void spawnEnemy(sf::RenderWindow& window) {
-        float x = static_cast<float>(rand() % 900);
-        float y = -100.f;
-
-        mEnemy.setPosition(x, y);
-        mEnemy.setFillColor(sf::Color::Green);
-        mEnemies.push_back(mEnemy);
+        mTextReady = true;
     }
 
-    void updateEnemies(float deltaTime, sf::RenderWindow& window) {
-        // Spawn enemies
-        if (mEnemies.size() < MAX_ENEMIES) {
-            if (mEnemySpawnTimer >= mEnemySpawnTimerMax) {
-                spawnEnemy(window);
-                mEnemySpawnTimer = 0.f;
-            } else {
-                mEnemySpawnTimer += 1.f;
-            }
-        }
-
-        // Move and check enemies
-        for (int i = 0; i < mEnemies.size(); i++) {
-            mEnemies[i].move(0.f, mGravity * deltaTime);
-
-            // Remove if off screen
-            if (mEnemies[i].getPosition().y > window.getSize().y) {
-                mHealth--;
-                mEnemies.erase(mEnemies.begin() + i);
-                i--;
-
-                // Check for game over
-                if (mHealth <= 0) {
-                    // TODO: Transition to Game Over state
-                    mQuit = true;
-                }
-            }
-        }
-    }
-
-    void handleClick(sf::RenderWindow& window) {
-        if (sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
-            if (!mMouseHeld) {
-                mMouseHeld = true;
-                bool deleted = false;
-
-                mMousePosWindow = sf::Mouse::getPosition(window);
-                mMousePosView = window.mapPixelToCoords(mMousePosWindow);
-
-                for (int i = 0; i < mEnemies.size() && !deleted; i++) {
-                    if (mEnemies[i].getGlobalBounds().contains(mMousePosView)) {
-                        deleted = true;
-                        mEnemies.erase(mEnemies.begin() + i);
-                        mHealth++;
-                        mPoints++;
+    /**
+     * @brief Score what the last step did: hits build the combo, a miss
+     * breaks it, game over keeps the best score
+     */
+    void handleEvents() {
+        const Simulation& sim = mWorld.getSim();
+        ScoreManager& scores = mWorld.getScores();
+        for (const SimEvent& event : sim.getEvents()) {
+            switch (event.type) {
+                case SimEventType::HIT:
+                    scores.addPoints(1);
+                    if (sim.getPoints() % POINTS_PER_MILESTONE == 0 &&
+                        mWorld.canPlayAudio()) {
+                        mWorld.getEngine().getSound().triggerMilestoneEcho();
                     }
-                }
+                    break;
+                case SimEventType::MISS:
+                    scores.breakCombo();
+                    break;
+                case SimEventType::GAME_OVER:
+                    scores.saveHighScore();
+                    mQuit = true;
+                    break;
             }
-        } else {
-            mMouseHeld = false;
         }
     }
 
     void updateText() {
-        std::stringstream ss;
-        ss << "Health: " << mHealth << " | Points: " << mPoints;
-        mUiText.setString(ss.str());
+        std::snprintf(mHud, sizeof(mHud), "Health: %d | Points: %u",
+                      mWorld.getSim().getHealth(),
+                      mWorld.getScores().getCurrentScore());
+        mUiText.setString(mHud);
     }
 
    public:
-    PlayingState(Game* game)
-        : GameState(game),
-          mPoints(0),
-          mHealth(10),
-          mEnemySpawnTimer(0.f),
-          mEnemySpawnTimerMax(10.f),
-          mMouseHeld(false) {
+    PlayingState(WorldContext& world, Game* game = nullptr)
+        : GameState(game), mWorld(world), mTextReady(false), mHud() {
         initEnemies();
-        initText();
     }
 
+    /**
+     * @brief Input for the next update()
+     */
+    void setInput(const SimInput& input) { mInput = input; }
+
     void update(float deltaTime) override {
-        if (mPaused) return;
+        Simulation& sim = mWorld.getSim();
+        if (mPaused || sim.isOver()) return;
 
-        // Access window through Game class would be needed
-        // For now, we'll handle this in Game class
+        sim.step(deltaTime, mInput);
+        handleEvents();
     }
 
+    /**
+     * @brief Update with the mouse over @p window as input
+     */
     void updateWithWindow(float deltaTime, sf::RenderWindow& window) {
-        if (mPaused) return;
-
-        updateEnemies(deltaTime, window);
-        handleClick(window);
-        updateText();
+        SimInput input;
+        input.mouse = toSim(
+            window.mapPixelToCoords(sf::Mouse::getPosition(window)));
+        input.mouseDown = sf::Mouse::isButtonPressed(sf::Mouse::Left);
+        setInput(input);
+        update(deltaTime);
     }
 
     void render(sf::RenderWindow& window) override {
         // Render enemies
-        for (auto& enemy : mEnemies) {
-            window.draw(enemy);
+        for (const SimEnemy& enemy : mWorld.getSim().getEnemies()) {
+            mEnemy.setPosition(enemy.bounds.left, enemy.bounds.top);
+            mEnemy.setSize(
+                sf::Vector2f(enemy.bounds.width, enemy.bounds.height));
+            mEnemy.setFillColor(toSfml(enemy.color));
+            window.draw(mEnemy);
         }
 
         // Render UI
+        if (!mTextReady) initText();
+        updateText();
         window.draw(mUiText);
     }
 
@@ -164,6 +132,8 @@ class PlayingState : public GameState {
 
     StateType getType() const override { return StateType::PLAYING; }
 
-    unsigned getPoints() const { return mPoints; }
-    int getHealth() const { return mHealth; }
+    WorldContext& getWorld() { return mWorld; }
+    unsigned getPoints() const { return mWorld.getSim().getPoints(); }
+    int getHealth() const { return mWorld.getSim().getHealth(); }
+    unsigned getScore() const { return mWorld.getScores().getCurrentScore(); }
 };
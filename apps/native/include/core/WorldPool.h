@@ -0,0 +1,86 @@
+/**
+ * @file WorldPool.h
+ * @brief Many independent PlayingState worlds, updated in parallel
+ *
+ * Each world is a WorldContext plus the PlayingState that plays it, all
+ * sharing one EngineContext. update() hands the worlds out to the
+ * threads one at a time from an atomic index, so a world is only ever
+ * stepped by one thread per update and a slow world does not hold up a
+ * whole batch. With zero threads every world is updated inline.
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "core/EngineContext.h"
+#include "core/PlayingState.h"
+#include "systems/ThreadPool.h"
+
+class WorldPool {
+   private:
+    const EngineContext& mEngine;
+    std::vector<std::unique_ptr<WorldContext>> mWorlds;
+    std::vector<std::unique_ptr<PlayingState>> mStates;
+    ThreadPool mThreads;
+    std::vector<std::future<void>> mRunning;  // Reused every update
+
+   public:
+    WorldPool(const EngineContext& engine, std::size_t threadCount)
+        : mEngine(engine), mThreads(threadCount) {}
+
+    WorldPool(const WorldPool&) = delete;
+    WorldPool& operator=(const WorldPool&) = delete;
+
+    /**
+     * @brief Add a world; its id is its index
+     */
+    PlayingState& add(const SimConfig& config, std::uint64_t seed) {
+        const unsigned id = static_cast<unsigned>(mWorlds.size());
+        mWorlds.push_back(
+            std::make_unique<WorldContext>(mEngine, id, config, seed));
+        mStates.push_back(std::make_unique<PlayingState>(*mWorlds.back()));
+        return *mStates.back();
+    }
+
+    std::size_t size() const { return mStates.size(); }
+    std::size_t getThreadCount() const { return mThreads.getThreadCount(); }
+    PlayingState& get(std::size_t index) { return *mStates[index]; }
+    WorldContext& getWorld(std::size_t index) { return *mWorlds[index]; }
+
+    /**
+     * @brief Update every world once with its pending input; returns
+     * when all are done
+     */
+    void update(float deltaTime) {
+        update(deltaTime, [](std::size_t, PlayingState&) {});
+    }
+
+    /**
+     * @brief Update every world once, calling @p before(index, state) on
+     * the same thread just before, e.g. to let a bot set the input
+     */
+    template <typename Before>
+    void update(float deltaTime, Before&& before) {
+        std::atomic<std::size_t> next{0};
+        auto worker = [this, &next, &before, deltaTime] {
+            for (std::size_t i = next++; i < mStates.size(); i = next++) {
+                before(i, *mStates[i]);
+                mStates[i]->update(deltaTime);
+            }
+        };
+
+        mRunning.clear();
+        const std::size_t workers =
+            std::min(std::max<std::size_t>(mThreads.getThreadCount(), 1),
+                     mStates.size());
+        for (std::size_t i = 0; i < workers; ++i) {
+            mRunning.push_back(mThreads.submit(worker));
+        }
+        for (std::future<void>& done : mRunning) done.get();
+    }
+};
@@ -8,8 +8,12 @@
 
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdlib>
 #include <memory>
 
+#include "systems/ObjectPool.h"
+
 /**
  * @brief Enemy type enumeration
  */
@@ -32,15 +36,10 @@ class Enemy {
     int mPointValue;   // Points when clicked
     bool mActive;
 
-   public:
     /**
-     * @brief Constructor
-     * @param type Type of enemy
-     * @param position Starting position
+     * @brief Speed, values, size and colour for mType
      */
-    Enemy(EnemyType type, const sf::Vector2f& position)
-        : mType(type), mActive(true) {
-        mShape.setPosition(position);
+    void applyType() {
         mShape.setSize(sf::Vector2f(100.f, 100.f));
         mShape.setScale(sf::Vector2f(0.5f, 0.5f));
 
@@ -79,8 +78,30 @@ class Enemy {
         }
     }
 
+   public:
+    /**
+     * @brief Constructor
+     * @param type Type of enemy
+     * @param position Starting position
+     */
+    Enemy(EnemyType type, const sf::Vector2f& position)
+        : mType(type), mActive(true) {
+        mShape.setPosition(position);
+        applyType();
+    }
+
     virtual ~Enemy() = default;
 
+    /**
+     * @brief Make a used enemy as good as a newly constructed one
+     * @param position Starting position
+     */
+    virtual void respawn(const sf::Vector2f& position) {
+        mActive = true;
+        mShape.setPosition(position);
+        applyType();
+    }
+
     /**
      * @brief Update enemy position
      * @param deltaTime Time since last frame
@@ -173,6 +194,11 @@ class BonusEnemy : public Enemy {
     BonusEnemy(const sf::Vector2f& position)
         : Enemy(EnemyType::BONUS, position), mLifetime(0.f) {}
 
+    void respawn(const sf::Vector2f& position) override {
+        Enemy::respawn(position);
+        mLifetime = 0.f;
+    }
+
     void update(float deltaTime) override {
         Enemy::update(deltaTime);
 
@@ -232,16 +258,89 @@ class EnemyFactory {
      */
     static std::unique_ptr<Enemy> createRandomEnemy(
         const sf::Vector2f& position) {
+        return createEnemy(randomType(), position);
+    }
+
+    /**
+     * @brief Pick a type: 50% Normal, 25% Fast, 20% Tank, 5% Bonus
+     */
+    static EnemyType randomType() {
         int randomType = rand() % 100;
 
-        // 50% Normal, 25% Fast, 20% Tank, 5% Bonus
         if (randomType < 50)
-            return createEnemy(EnemyType::NORMAL, position);
+            return EnemyType::NORMAL;
         else if (randomType < 75)
-            return createEnemy(EnemyType::FAST, position);
+            return EnemyType::FAST;
         else if (randomType < 95)
-            return createEnemy(EnemyType::TANK, position);
+            return EnemyType::TANK;
         else
-            return createEnemy(EnemyType::BONUS, position);
+            return EnemyType::BONUS;
+    }
+};
+
+/**
+ * @brief Reusable enemies, one ObjectPool per type
+ *
+ * Spawning through the factory costs a heap allocation per enemy; the
+ * pool hands back a released enemy of the same type, respawned, so a
+ * game that spawns and kills enemies every frame stops allocating once
+ * each pool has reached its working size.
+ */
+class EnemyPool {
+   private:
+    ObjectPool<Enemy> mNormal;
+    ObjectPool<Enemy> mFast;
+    ObjectPool<Enemy> mTank;
+    ObjectPool<Enemy> mBonus;
+
+    static ObjectPool<Enemy> makePool(EnemyType type, size_t size) {
+        return ObjectPool<Enemy>(size, [type] {
+            return EnemyFactory::createEnemy(type, sf::Vector2f());
+        });
+    }
+
+    ObjectPool<Enemy>& poolFor(EnemyType type) {
+        switch (type) {
+            case EnemyType::FAST:
+                return mFast;
+            case EnemyType::TANK:
+                return mTank;
+            case EnemyType::BONUS:
+                return mBonus;
+            default:
+                return mNormal;
+        }
+    }
+
+   public:
+    /**
+     * @param sizePerType Enemies preallocated of each type
+     */
+    explicit EnemyPool(size_t sizePerType = 32)
+        : mNormal(makePool(EnemyType::NORMAL, sizePerType)),
+          mFast(makePool(EnemyType::FAST, sizePerType)),
+          mTank(makePool(EnemyType::TANK, sizePerType)),
+          mBonus(makePool(EnemyType::BONUS, sizePerType)) {}
+
+    /**
+     * @brief A respawned enemy of @p type (the pool grows if it is empty)
+     */
+    Enemy* acquire(EnemyType type, const sf::Vector2f& position) {
+        Enemy* enemy = poolFor(type).acquire();
+        if (enemy != nullptr) enemy->respawn(position);
+        return enemy;
+    }
+
+    Enemy* acquireRandom(const sf::Vector2f& position) {
+        return acquire(EnemyFactory::randomType(), position);
+    }
+
+    void release(Enemy* enemy) {
+        if (enemy != nullptr) poolFor(enemy->getType()).release(enemy);
+    }
+
+    size_t getInUseCount() const {
+        return mNormal.getInUseCount() + mFast.getInUseCount() +
+               mTank.getInUseCount() + mBonus.getInUseCount();
     }
 };
@@ -0,0 +1,92 @@
+/**
+ * @file AssetManifest.h
+ * @brief Reader for assets/assets.manifest
+ *
+ * The manifest lists every packed resource, one per line:
+ *   <font|texture|sound> <name> <path> [lz4]
+ * Paths are relative to the manifest. Shared by the pack builder and the
+ * development hot reloader, which uses it to map a changed file back to
+ * the resource built from it.
+ */
+
+#pragma once
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "managers/AssetPack.h"
+
+struct ManifestItem {
+    PackEntryKind kind;
+    std::string name;
+    std::string path;  // Manifest directory prepended
+    bool compress;
+};
+
+namespace AssetManifest {
+
+inline bool parseKind(const std::string& text, PackEntryKind& kind) {
+    if (text == "font") {
+        kind = PackEntryKind::FONT;
+    } else if (text == "texture") {
+        kind = PackEntryKind::TEXTURE;
+    } else if (text == "sound") {
+        kind = PackEntryKind::SOUND;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Parse a manifest file
+ * @param manifestPath Path to the manifest
+ * @param items Receives one item per resource line
+ * @return false if the file cannot be read or a line is invalid
+ */
+inline bool read(const std::string& manifestPath,
+                 std::vector<ManifestItem>& items) {
+    std::ifstream file(manifestPath);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::MANIFEST::Cannot open manifest: " << manifestPath
+                  << "\n";
+        return false;
+    }
+
+    const std::size_t slash = manifestPath.find_last_of("/\\");
+    const std::string baseDir =
+        slash == std::string::npos ? "" : manifestPath.substr(0, slash + 1);
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        std::string kind, name, path, option;
+        if (!(fields >> kind >> name >> path)) continue;
+        fields >> option;
+
+        ManifestItem item;
+        if (!parseKind(kind, item.kind)) {
+            std::cerr << "ERROR::MANIFEST::" << manifestPath << ":"
+                      << lineNumber << ": unknown kind '" << kind << "'\n";
+            return false;
+        }
+        if (name.size() >= PACK_NAME_LENGTH) {
+            std::cerr << "ERROR::MANIFEST::" << manifestPath << ":"
+                      << lineNumber << ": name too long\n";
+            return false;
+        }
+        item.name = name;
+        item.path = baseDir + path;
+        item.compress = option == "lz4";
+        items.push_back(item);
+    }
+    return true;
+}
+
+}  // namespace AssetManifest
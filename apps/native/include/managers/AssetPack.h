@@ -0,0 +1,224 @@
+/**
+ * @file AssetPack.h
+ * @brief Single-file asset archive, memory mapped at runtime
+ *
+ * Layout (all integers little-endian):
+ *   PackHeader
+ *   PackEntry[entryCount]          table of contents
+ *   entry data, each PACK_ALIGNMENT aligned, optionally LZ4 compressed
+ *
+ * The archive is written by the FallingFuryPacker tool and read here with a
+ * single open + mmap; uncompressed entries are handed to SFML as slices of
+ * the mapping without any copy.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "managers/ResourceId.h"
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define FALLING_FURY_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char PACK_MAGIC[4] = {'F', 'F', 'P', 'K'};
+const std::uint32_t PACK_VERSION = 1;
+const std::uint64_t PACK_ALIGNMENT = 16;
+const std::size_t PACK_NAME_LENGTH = 48;
+
+/**
+ * @brief Kind of resource stored in an entry
+ */
+enum class PackEntryKind : std::uint8_t { FONT = 0, TEXTURE = 1, SOUND = 2 };
+
+/**
+ * @brief Per-entry flags
+ */
+enum PackEntryFlags : std::uint8_t { PACK_ENTRY_LZ4 = 1 << 0 };
+
+struct PackHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t reserved;
+};
+
+struct PackEntry {
+    std::uint32_t id;  // ResourceId of the name
+    PackEntryKind kind;
+    std::uint8_t flags;
+    std::uint16_t reserved;
+    std::uint64_t offset;      // From start of file, PACK_ALIGNMENT aligned
+    std::uint64_t storedSize;  // Bytes in the file
+    std::uint64_t rawSize;     // Bytes after decompression
+    char name[PACK_NAME_LENGTH];
+
+    bool isCompressed() const { return (flags & PACK_ENTRY_LZ4) != 0; }
+};
+
+static_assert(sizeof(PackHeader) == 16, "PackHeader layout changed");
+static_assert(sizeof(PackEntry) == 80, "PackEntry layout changed");
+
+/**
+ * @brief Read-only view of a pack file
+ */
+class AssetPack {
+   private:
+    const std::uint8_t* mData;
+    std::size_t mSize;
+    bool mMapped;
+    std::vector<std::uint8_t> mFallback;  // Used where mmap is unavailable
+
+    const PackEntry* mEntries;
+    std::uint32_t mEntryCount;
+
+    bool validate(const std::string& filepath) {
+        if (mSize < sizeof(PackHeader)) {
+            std::cerr << "ERROR::ASSETPACK::Truncated pack: " << filepath
+                      << "\n";
+            return false;
+        }
+
+        const auto* header = reinterpret_cast<const PackHeader*>(mData);
+        if (std::memcmp(header->magic, PACK_MAGIC, 4) != 0 ||
+            header->version != PACK_VERSION) {
+            std::cerr << "ERROR::ASSETPACK::Bad header in pack: " << filepath
+                      << "\n";
+            return false;
+        }
+
+        const std::size_t tocEnd =
+            sizeof(PackHeader) + header->entryCount * sizeof(PackEntry);
+        if (tocEnd > mSize) {
+            std::cerr << "ERROR::ASSETPACK::Truncated table of contents: "
+                      << filepath << "\n";
+            return false;
+        }
+
+        mEntries =
+            reinterpret_cast<const PackEntry*>(mData + sizeof(PackHeader));
+        mEntryCount = header->entryCount;
+
+        for (std::uint32_t i = 0; i < mEntryCount; ++i) {
+            const PackEntry& entry = mEntries[i];
+            if (entry.offset > mSize || entry.storedSize > mSize - entry.offset) {
+                std::cerr << "ERROR::ASSETPACK::Entry out of bounds: "
+                          << entry.name << "\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void unmap() {
+#ifdef FALLING_FURY_HAS_MMAP
+        if (mMapped && mData != nullptr) {
+            munmap(const_cast<std::uint8_t*>(mData), mSize);
+        }
+#endif
+        mData = nullptr;
+        mSize = 0;
+        mMapped = false;
+        mFallback.clear();
+        mEntries = nullptr;
+        mEntryCount = 0;
+    }
+
+   public:
+    AssetPack()
+        : mData(nullptr),
+          mSize(0),
+          mMapped(false),
+          mEntries(nullptr),
+          mEntryCount(0) {}
+
+    ~AssetPack() { unmap(); }
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    /**
+     * @brief Map a pack file
+     * @param filepath Path to the .ffpk file
+     * @return true if the pack is mapped and its TOC is valid
+     */
+    bool open(const std::string& filepath) {
+        unmap();
+
+#ifdef FALLING_FURY_HAS_MMAP
+        int fd = ::open(filepath.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* mapping = mmap(nullptr, static_cast<std::size_t>(info.st_size),
+                             PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // The mapping keeps the file alive
+        if (mapping == MAP_FAILED) {
+            std::cerr << "ERROR::ASSETPACK::mmap failed: " << filepath << "\n";
+            return false;
+        }
+
+        mData = static_cast<const std::uint8_t*>(mapping);
+        mSize = static_cast<std::size_t>(info.st_size);
+        mMapped = true;
+#else
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return false;
+
+        mFallback.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(mFallback.data()),
+                  static_cast<std::streamsize>(mFallback.size()));
+        mData = mFallback.data();
+        mSize = mFallback.size();
+#endif
+
+        if (!validate(filepath)) {
+            unmap();
+            return false;
+        }
+        return true;
+    }
+
+    bool isOpen() const { return mData != nullptr; }
+
+    std::uint32_t getEntryCount() const { return mEntryCount; }
+
+    const PackEntry& getEntry(std::uint32_t index) const {
+        return mEntries[index];
+    }
+
+    /**
+     * @brief Find an entry by resource id
+     * @return Entry, or nullptr if the pack has no such resource
+     */
+    const PackEntry* findEntry(ResourceId id) const {
+        for (std::uint32_t i = 0; i < mEntryCount; ++i) {
+            if (mEntries[i].id == id.value) return &mEntries[i];
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Stored (possibly compressed) bytes of an entry
+     */
+    const std::uint8_t* getData(const PackEntry& entry) const {
+        return mData + entry.offset;
+    }
+
+    std::size_t getFileSize() const { return mSize; }
+};
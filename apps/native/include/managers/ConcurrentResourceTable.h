@@ -0,0 +1,544 @@
+/**
+ * @file ConcurrentResourceTable.h
+ * @brief Fixed-capacity resource table with lock-free lookups
+ *
+ * Writers (loaders) serialize on a mutex; readers never lock. Each slot's
+ * key and value are published with release stores, and the table never
+ * rehashes, so a reader can probe it while loads are still landing.
+ *
+ * Each slot also remembers how to load its value again, how many bytes it
+ * holds and who is using it. Values nobody references can be evicted,
+ * least recently used first, when the table goes over its memory budget,
+ * and are reloaded the next time they are asked for.
+ */
+
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "managers/ResourceId.h"
+
+/**
+ * @brief Memory use of one resource class
+ */
+struct ResourceMemoryStats {
+    std::size_t residentBytes;  // Currently loaded
+    std::size_t evictedBytes;   // Known resources currently unloaded
+    std::size_t budgetBytes;    // 0 = unlimited
+    std::size_t evictions;      // Since startup
+};
+
+template <typename T>
+class ResourceHandle;
+
+template <typename T>
+class ConcurrentResourceTable {
+   public:
+    /**
+     * @brief A freshly loaded value plus what it costs to keep
+     */
+    struct Loaded {
+        std::unique_ptr<T> value;
+        std::size_t bytes = 0;
+        // Data the value reads from in place (font files)
+        std::vector<std::uint8_t> backing;
+    };
+
+    /**
+     * @brief Produces the value again after eviction
+     */
+    using Loader = std::function<Loaded()>;
+
+   private:
+    struct Slot {
+        std::atomic<std::uint32_t> key{0};  // 0 = empty
+        std::atomic<T*> value{nullptr};     // nullptr = loading or evicted
+
+        // Guarded by the write mutex
+        std::string name;
+        std::shared_future<T*> ready;
+        Loader loader;
+        std::unique_ptr<T> owner;
+        std::vector<std::uint8_t> backing;
+        std::size_t bytes = 0;
+
+        std::atomic<int> refs{0};         // EVICTING while trim() drops it
+        std::atomic<bool> pinned{false};  // Raw references handed out
+        std::atomic<std::uint64_t> lastUse{0};
+    };
+
+    struct Retired {
+        std::unique_ptr<T> value;
+        std::vector<std::uint8_t> backing;
+    };
+
+    std::unique_ptr<Slot[]> mSlots;
+    std::size_t mCapacity;
+    std::size_t mCount;
+    mutable std::mutex mWriteMutex;
+
+    // Values replaced while readers may still hold references to them
+    std::vector<Retired> mRetired;
+
+    // Memory accounting
+    std::atomic<std::size_t> mResidentBytes;
+    std::atomic<std::size_t> mEvictedBytes;
+    std::atomic<std::size_t> mEvictions;
+    std::atomic<std::size_t> mBudget;
+    std::atomic<std::uint64_t> mClock;
+
+    // Claimed by trim(): no reference can be taken until it is done
+    static constexpr int EVICTING = -(1 << 30);
+
+    std::size_t mask() const { return mCapacity - 1; }
+
+    /**
+     * @brief Count a reference, waiting out an eviction in progress
+     *
+     * Once counted, trim() cannot claim the slot, so a value read after
+     * this stays alive until the reference is dropped.
+     */
+    void addRef(Slot& slot) {
+        int refs = slot.refs.load(std::memory_order_acquire);
+        for (;;) {
+            if (refs == EVICTING) {
+                // trim() holds the write mutex until the slot is released
+                { std::lock_guard<std::mutex> wait(mWriteMutex); }
+                refs = slot.refs.load(std::memory_order_acquire);
+                continue;
+            }
+            if (slot.refs.compare_exchange_weak(refs, refs + 1,
+                                                std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+    }
+
+    const Slot* findSlot(ResourceId id) const {
+        std::size_t index = id.value & mask();
+        for (std::size_t probes = 0; probes < mCapacity; ++probes) {
+            std::uint32_t key = mSlots[index].key.load(std::memory_order_acquire);
+            if (key == 0) return nullptr;
+            if (key == id.value) return &mSlots[index];
+            index = (index + 1) & mask();
+        }
+        return nullptr;
+    }
+
+    Slot* findSlot(ResourceId id) {
+        return const_cast<Slot*>(
+            static_cast<const ConcurrentResourceTable*>(this)->findSlot(id));
+    }
+
+    void touch(Slot& slot) {
+        slot.lastUse.store(
+            mClock.fetch_add(1, std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Drop a slot's value, keeping its key and loader
+     */
+    void evictLocked(Slot& slot) {
+        slot.value.store(nullptr, std::memory_order_release);
+        slot.owner.reset();
+        std::vector<std::uint8_t>().swap(slot.backing);
+        slot.ready = std::shared_future<T*>();
+
+        mResidentBytes.fetch_sub(slot.bytes, std::memory_order_relaxed);
+        mEvictedBytes.fetch_add(slot.bytes, std::memory_order_relaxed);
+        mEvictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    friend class ResourceHandle<T>;
+
+   public:
+    /**
+     * @param capacity Maximum resources of this kind (power of two)
+     */
+    explicit ConcurrentResourceTable(std::size_t capacity = 256)
+        : mSlots(new Slot[capacity]),
+          mCapacity(capacity),
+          mCount(0),
+          mResidentBytes(0),
+          mEvictedBytes(0),
+          mEvictions(0),
+          mBudget(0),
+          mClock(0) {
+        assert(isPowerOfTwo(capacity));
+    }
+
+    /**
+     * @brief Claim a slot for a resource about to be loaded
+     * @param name Resource name
+     * @param ready Future resolved when the load finishes
+     * @param loader How to load it again after eviction (may be empty)
+     * @return false on hash collision, zero hash or a full table
+     */
+    bool reserve(const std::string& name, std::shared_future<T*> ready,
+                 Loader loader = nullptr) {
+        ResourceId id(name);
+        if (id.value == 0) {
+            std::cerr << "ERROR::RESOURCETABLE::Reserved hash for \"" << name
+                      << "\"\n";
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+        if (Slot* existing = findSlot(id)) {
+            if (existing->name != name) {
+                std::cerr << "ERROR::RESOURCETABLE::Hash collision between \""
+                          << name << "\" and \"" << existing->name << "\"\n";
+                return false;
+            }
+            // Reload of a known resource
+            if (!existing->ready.valid()) existing->ready = std::move(ready);
+            if (loader) existing->loader = std::move(loader);
+            return true;
+        }
+
+        // Keep the load factor under 3/4 so probes stay short
+        if ((mCount + 1) * 4 > mCapacity * 3) {
+            std::cerr << "ERROR::RESOURCETABLE::Table full, cannot add \""
+                      << name << "\"\n";
+            return false;
+        }
+
+        std::size_t index = id.value & mask();
+        while (mSlots[index].key.load(std::memory_order_relaxed) != 0) {
+            index = (index + 1) & mask();
+        }
+        Slot& slot = mSlots[index];
+        slot.name = name;
+        slot.ready = std::move(ready);
+        slot.loader = std::move(loader);
+        slot.key.store(id.value, std::memory_order_release);
+        ++mCount;
+        return true;
+    }
+
+    /**
+     * @brief Make a loaded value visible to readers
+     * @param name Name previously passed to reserve()
+     * @param loaded Loaded resource
+     * @return Pointer to the published value (owned by the table)
+     */
+    T* publish(const std::string& name, Loaded loaded) {
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+        Slot* slot = findSlot(ResourceId(name));
+        if (slot == nullptr || !loaded.value) return nullptr;
+
+        if (slot->owner) {
+            mResidentBytes.fetch_sub(slot->bytes, std::memory_order_relaxed);
+            mRetired.push_back(
+                {std::move(slot->owner), std::move(slot->backing)});
+        } else if (slot->bytes > 0) {
+            // Coming back from eviction
+            mEvictedBytes.fetch_sub(slot->bytes, std::memory_order_relaxed);
+        }
+
+        T* raw = loaded.value.get();
+        slot->owner = std::move(loaded.value);
+        slot->backing = std::move(loaded.backing);
+        slot->bytes = loaded.bytes;
+        mResidentBytes.fetch_add(slot->bytes, std::memory_order_relaxed);
+        touch(*slot);
+        slot->value.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    /**
+     * @brief Reserve and publish an already-loaded value
+     */
+    T* insert(const std::string& name, Loaded loaded, Loader loader = nullptr) {
+        std::promise<T*> promise;
+        promise.set_value(loaded.value.get());
+        if (!reserve(name, promise.get_future().share(), std::move(loader))) {
+            return nullptr;
+        }
+        return publish(name, std::move(loaded));
+    }
+
+    /**
+     * @brief Lock-free lookup
+     *
+     * The pointer is only guaranteed to stay valid while the resource is
+     * pinned or a ResourceHandle to it is alive.
+     * @return The resource, or nullptr if unknown, loading or evicted
+     */
+    T* find(ResourceId id) const {
+        const Slot* slot = findSlot(id);
+        return slot ? slot->value.load(std::memory_order_acquire) : nullptr;
+    }
+
+    /**
+     * @brief Future for a resource that is being loaded
+     * @return Invalid future if the id is unknown or evicted
+     */
+    std::shared_future<T*> getPending(ResourceId id) const {
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+        const Slot* slot = findSlot(id);
+        return slot ? slot->ready : std::shared_future<T*>();
+    }
+
+    /**
+     * @brief Load an evicted resource again (blocks the caller)
+     *
+     * One load per slot at a time: a caller that finds a load already in
+     * flight waits for it instead of publishing a second copy, which would
+     * retire the first while its handles still point at it.
+     * @return The resource, or nullptr if it cannot be reloaded
+     */
+    T* restore(ResourceId id) {
+        Loader loader;
+        std::string name;
+        std::promise<T*> loading;
+        std::shared_future<T*> inFlight;
+        {
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            Slot* slot = findSlot(id);
+            if (slot == nullptr) return nullptr;
+            if (T* value = slot->value.load(std::memory_order_acquire)) {
+                return value;
+            }
+            if (slot->ready.valid()) {
+                inFlight = slot->ready;
+            } else {
+                if (!slot->loader) return nullptr;
+                loader = slot->loader;
+                name = slot->name;
+                slot->ready = loading.get_future().share();
+            }
+        }
+        if (inFlight.valid()) return inFlight.get();
+
+        T* value = publish(name, loader());
+        if (value == nullptr) {
+            // Let the next caller try again rather than wait on a failure
+            std::lock_guard<std::mutex> lock(mWriteMutex);
+            if (Slot* slot = findSlot(id)) {
+                slot->ready = std::shared_future<T*>();
+            }
+        }
+        loading.set_value(value);
+        return value;
+    }
+
+    /**
+     * @brief Look up and mark as never evictable
+     *
+     * Used for plain references whose lifetime the table cannot track.
+     */
+    T* pin(ResourceId id) {
+        Slot* slot = findSlot(id);
+        if (slot == nullptr) return nullptr;
+        // Held across the flag, so trim() either sees the pin or has
+        // already finished evicting
+        addRef(*slot);
+        slot->pinned.store(true, std::memory_order_relaxed);
+        touch(*slot);
+        T* value = slot->value.load(std::memory_order_acquire);
+        slot->refs.fetch_sub(1, std::memory_order_release);
+        return value;
+    }
+
+    /**
+     * @brief Take a counted reference, reloading if evicted
+     */
+    ResourceHandle<T> acquire(ResourceId id);
+
+    /**
+     * @brief Set the memory budget (0 = unlimited)
+     */
+    void setBudget(std::size_t bytes) {
+        mBudget.store(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Evict unreferenced values, least recently used first, until
+     * the table fits its budget
+     *
+     * Call from the game thread between frames.
+     * @return Number of values evicted
+     */
+    std::size_t trim() {
+        const std::size_t budget = mBudget.load(std::memory_order_relaxed);
+        if (budget == 0 ||
+            mResidentBytes.load(std::memory_order_relaxed) <= budget) {
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+        std::size_t evicted = 0;
+        while (mResidentBytes.load(std::memory_order_relaxed) > budget) {
+            Slot* oldest = nullptr;
+            for (std::size_t i = 0; i < mCapacity; ++i) {
+                Slot& slot = mSlots[i];
+                if (!slot.owner || !slot.loader ||
+                    slot.refs.load(std::memory_order_acquire) > 0 ||
+                    slot.pinned.load(std::memory_order_relaxed)) {
+                    continue;
+                }
+                if (oldest == nullptr ||
+                    slot.lastUse.load(std::memory_order_relaxed) <
+                        oldest->lastUse.load(std::memory_order_relaxed)) {
+                    oldest = &slot;
+                }
+            }
+            if (oldest == nullptr) break;  // Everything left is in use
+
+            // Claim it: an acquire() or pin() that got in first wins
+            int unused = 0;
+            if (!oldest->refs.compare_exchange_strong(
+                    unused, EVICTING, std::memory_order_acq_rel)) {
+                touch(*oldest);  // In use after all
+                continue;
+            }
+            if (oldest->pinned.load(std::memory_order_relaxed)) {
+                oldest->refs.store(0, std::memory_order_release);
+                continue;
+            }
+            evictLocked(*oldest);
+            oldest->refs.store(0, std::memory_order_release);
+            ++evicted;
+        }
+        return evicted;
+    }
+
+    /**
+     * @brief Free every value replaced by publish() since the last call
+     *
+     * Only once nothing holds a plain reference to them any more, i.e.
+     * after the reload listeners have re-bound their users.
+     * @return Number of values freed
+     */
+    std::size_t releaseRetired() {
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+        const std::size_t released = mRetired.size();
+        mRetired.clear();
+        return released;
+    }
+
+    ResourceMemoryStats getStats() const {
+        return {mResidentBytes.load(std::memory_order_relaxed),
+                mEvictedBytes.load(std::memory_order_relaxed),
+                mBudget.load(std::memory_order_relaxed),
+                mEvictions.load(std::memory_order_relaxed)};
+    }
+
+    /**
+     * @brief Visit every published value (writers must be idle)
+     */
+    template <typename Func>
+    void forEach(Func&& func) {
+        for (std::size_t i = 0; i < mCapacity; ++i) {
+            if (T* value = mSlots[i].value.load(std::memory_order_acquire)) {
+                func(*value);
+            }
+        }
+    }
+
+    /**
+     * @brief Drop everything (no loads or readers may be active)
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(mWriteMutex);
+        mSlots.reset(new Slot[mCapacity]);
+        mRetired.clear();
+        mCount = 0;
+        mResidentBytes.store(0, std::memory_order_relaxed);
+        mEvictedBytes.store(0, std::memory_order_relaxed);
+        mEvictions.store(0, std::memory_order_relaxed);
+    }
+
+    std::size_t size() const { return mCount; }
+};
+
+/**
+ * @brief Counted reference that keeps a resource from being evicted
+ * @tparam T Resource type
+ */
+template <typename T>
+class ResourceHandle {
+   private:
+    ConcurrentResourceTable<T>* mTable;
+    ResourceId mId;
+    T* mValue;
+
+    void release() {
+        if (mValue == nullptr) return;
+        if (auto* slot = mTable->findSlot(mId)) {
+            mTable->touch(*slot);
+            slot->refs.fetch_sub(1, std::memory_order_release);
+        }
+        mValue = nullptr;
+    }
+
+   public:
+    ResourceHandle() : mTable(nullptr), mId(), mValue(nullptr) {}
+
+    /**
+     * @param table Owning table
+     * @param id Resource id
+     * @param value Value whose slot already counts this reference
+     */
+    ResourceHandle(ConcurrentResourceTable<T>* table, ResourceId id, T* value)
+        : mTable(table), mId(id), mValue(value) {}
+
+    ResourceHandle(const ResourceHandle& other)
+        : mTable(other.mTable), mId(other.mId), mValue(other.mValue) {
+        if (mValue) {
+            mTable->findSlot(mId)->refs.fetch_add(1,
+                                                  std::memory_order_relaxed);
+        }
+    }
+
+    ResourceHandle(ResourceHandle&& other) noexcept
+        : mTable(other.mTable), mId(other.mId), mValue(other.mValue) {
+        other.mValue = nullptr;
+    }
+
+    ResourceHandle& operator=(ResourceHandle other) noexcept {
+        std::swap(mTable, other.mTable);
+        std::swap(mId, other.mId);
+        std::swap(mValue, other.mValue);
+        return *this;
+    }
+
+    ~ResourceHandle() { release(); }
+
+    explicit operator bool() const { return mValue != nullptr; }
+    T& operator*() const { return *mValue; }
+    T* operator->() const { return mValue; }
+    T* get() const { return mValue; }
+    ResourceId getId() const { return mId; }
+};
+
+template <typename T>
+ResourceHandle<T> ConcurrentResourceTable<T>::acquire(ResourceId id) {
+    Slot* slot = findSlot(id);
+    if (slot == nullptr) return ResourceHandle<T>();
+
+    // Counted before the value is read: trim() cannot claim the slot now
+    addRef(*slot);
+    T* value = slot->value.load(std::memory_order_acquire);
+    if (value == nullptr) {
+        std::shared_future<T*> pending = getPending(id);
+        value = pending.valid() ? pending.get() : restore(id);
+    }
+    if (value == nullptr) {
+        slot->refs.fetch_sub(1, std::memory_order_release);
+        return ResourceHandle<T>();
+    }
+
+    touch(*slot);
+    return ResourceHandle<T>(this, id, value);
+}
@@ -0,0 +1,235 @@
+/**
+ * @file ResourceId.h
+ * @brief Hashed resource identifiers and the flat table they index
+ *
+ * Resource names are hashed with 32-bit FNV-1a. A ResourceId built from a
+ * literal in a constexpr context costs nothing at runtime, so hot lookups
+ * become a masked index plus a key compare instead of a string-keyed map
+ * walk. Hash collisions are caught when a resource is registered.
+ */
+
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 32-bit FNV-1a hash, usable at compile time
+ */
+constexpr std::uint32_t fnv1a32(const char* text, std::size_t length) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<std::uint8_t>(text[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+constexpr std::size_t constLength(const char* text) {
+    std::size_t length = 0;
+    while (text[length] != '\0') ++length;
+    return length;
+}
+
+constexpr bool isPowerOfTwo(std::size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+/**
+ * @brief Hashed resource name
+ *
+ * Implicitly constructible from names so existing call sites such as
+ * getFont("main") keep working; prefer the constexpr constants in
+ * ResourceIds for per-frame paths. Debug builds also carry the start of
+ * the name, so a failed lookup can say what was asked for.
+ */
+struct ResourceId {
+#ifndef NDEBUG
+    static constexpr std::size_t DEBUG_NAME_LENGTH = 31;
+#endif
+
+    std::uint32_t value;
+#ifndef NDEBUG
+    char debugName[DEBUG_NAME_LENGTH + 1] = {};
+#endif
+
+    constexpr ResourceId() : value(0) {}
+    constexpr ResourceId(const char* name)
+        : value(fnv1a32(name, constLength(name))) {
+        keepName(name, constLength(name));
+    }
+    ResourceId(const std::string& name)
+        : value(fnv1a32(name.data(), name.size())) {
+        keepName(name.data(), name.size());
+    }
+
+    constexpr bool operator==(const ResourceId& other) const {
+        return value == other.value;
+    }
+    constexpr bool operator!=(const ResourceId& other) const {
+        return value != other.value;
+    }
+
+    /**
+     * @brief Printable form for error messages: the hash, plus the name in
+     * debug builds
+     */
+    std::string toString() const {
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "#%08x", value);
+#ifndef NDEBUG
+        if (debugName[0] != '\0') {
+            return "\"" + std::string(debugName) + "\" (" + buffer + ")";
+        }
+#endif
+        return buffer;
+    }
+
+   private:
+    constexpr void keepName(const char* name, std::size_t length) {
+#ifndef NDEBUG
+        for (std::size_t i = 0; i < length && i < DEBUG_NAME_LENGTH; ++i) {
+            debugName[i] = name[i];
+        }
+#else
+        (void)name;
+        (void)length;
+#endif
+    }
+};
+
+/**
+ * @brief Well-known resource ids, hashed at compile time
+ */
+namespace ResourceIds {
+constexpr ResourceId MAIN_FONT("main");
+}  // namespace ResourceIds
+
+/**
+ * @brief Open-addressing hash table keyed by ResourceId
+ * @tparam T Stored value type
+ *
+ * Linear probing over a power-of-two array. Registration keeps the original
+ * name so two different names hashing to the same id are rejected instead
+ * of silently aliasing each other.
+ */
+template <typename T>
+class ResourceTable {
+   private:
+    struct Slot {
+        std::uint32_t key = 0;
+        bool used = false;
+        std::string name;
+        T value{};
+    };
+
+    std::vector<Slot> mSlots;
+    std::size_t mCount;
+
+    std::size_t mask() const { return mSlots.size() - 1; }
+
+    void grow() {
+        std::vector<Slot> old = std::move(mSlots);
+        mSlots = std::vector<Slot>(old.size() * 2);
+        mCount = 0;
+        for (auto& slot : old) {
+            if (slot.used) {
+                insertSlot(slot.key, std::move(slot.name),
+                           std::move(slot.value));
+            }
+        }
+    }
+
+    void insertSlot(std::uint32_t key, std::string&& name, T&& value) {
+        std::size_t index = key & mask();
+        while (mSlots[index].used) {
+            index = (index + 1) & mask();
+        }
+        Slot& slot = mSlots[index];
+        slot.key = key;
+        slot.used = true;
+        slot.name = std::move(name);
+        slot.value = std::move(value);
+        ++mCount;
+    }
+
+    Slot* findSlot(ResourceId id) {
+        std::size_t index = id.value & mask();
+        while (mSlots[index].used) {
+            if (mSlots[index].key == id.value) return &mSlots[index];
+            index = (index + 1) & mask();
+        }
+        return nullptr;
+    }
+
+   public:
+    /**
+     * @param initialCapacity Starting slot count (power of two; the probe
+     * mask depends on it)
+     */
+    explicit ResourceTable(std::size_t initialCapacity = 16)
+        : mSlots(initialCapacity), mCount(0) {
+        assert(isPowerOfTwo(initialCapacity));
+    }
+
+    /**
+     * @brief Insert or replace a value
+     * @param name Resource name; must hash to a unique id
+     * @return false if name collides with a different registered name
+     */
+    bool insert(const std::string& name, T value) {
+        ResourceId id(name);
+        if (Slot* existing = findSlot(id)) {
+            if (existing->name != name) {
+                std::cerr << "ERROR::RESOURCETABLE::Hash collision between \""
+                          << name << "\" and \"" << existing->name << "\"\n";
+                return false;
+            }
+            existing->value = std::move(value);
+            return true;
+        }
+
+        // Keep the load factor under 1/2 so probes stay short
+        if ((mCount + 1) * 2 > mSlots.size()) {
+            grow();
+        }
+        insertSlot(id.value, std::string(name), std::move(value));
+        return true;
+    }
+
+    /**
+     * @brief Look up a value
+     * @return Pointer to the value, or nullptr if not registered
+     */
+    T* find(ResourceId id) {
+        Slot* slot = findSlot(id);
+        return slot ? &slot->value : nullptr;
+    }
+
+    const T* find(ResourceId id) const {
+        return const_cast<ResourceTable*>(this)->find(id);
+    }
+
+    /**
+     * @brief Visit every stored value
+     */
+    template <typename Func>
+    void forEach(Func&& func) {
+        for (auto& slot : mSlots) {
+            if (slot.used) func(slot.value);
+        }
+    }
+
+    void clear() {
+        for (auto& slot : mSlots) {
+            slot = Slot();
+        }
+        mCount = 0;
+    }
+
+    std::size_t size() const { return mCount; }
+};
@@ -3,34 +3,496 @@
  * @brief Singleton class for managing game resources (fonts, textures, sounds)
  *
  * This class ensures only one instance exists and provides centralized
- * resource loading and access throughout the game.
+ * resource loading and access throughout the game. Resources are looked up
+ * by hashed ResourceId rather than by string, and can come either from
+ * individual files or from a memory-mapped asset pack.
+ *
+ * Loading is asynchronous: load*Async() returns a LoadHandle immediately,
+ * decoding runs on a worker pool and texture uploads go through a loader
+ * thread with its own shared GL context. Lookups never take a lock.
+ *
+ * Resources can be reloaded while the game runs: requestReload() decodes
+ * in the background and applyReloads() swaps the results in at a frame
+ * boundary, then tells listeners so they can re-bind.
+ *
+ * Each resource class has a memory budget. Resources held through
+ * acquire*() handles are reference counted; once unreferenced they may be
+ * evicted (least recently used first) by trimToBudget() and are reloaded
+ * transparently on next use. get*() hands out plain references, so those
+ * resources are pinned and never evicted.
  */
 
 #pragma once
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
-#include <map>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <vector>
+
+#include "managers/AssetPack.h"
+#include "managers/ConcurrentResourceTable.h"
+#include "managers/ResourceId.h"
+#include "systems/Lz4Lite.h"
+#include "systems/ThreadPool.h"
+#include "systems/TraceRecorder.h"
+
+/**
+ * @brief Handle to a resource that may still be loading
+ *
+ * The pointer is not counted; use acquire*() to keep a resource resident.
+ * @tparam T Resource type
+ */
+template <typename T>
+class LoadHandle {
+   private:
+    ResourceId mId;
+    std::shared_future<T*> mFuture;
+
+   public:
+    LoadHandle() = default;
+    LoadHandle(ResourceId id, std::shared_future<T*> future)
+        : mId(id), mFuture(std::move(future)) {}
+
+    bool valid() const { return mFuture.valid(); }
+
+    /**
+     * @brief Check without blocking whether the load has finished
+     */
+    bool isReady() const {
+        return mFuture.valid() &&
+               mFuture.wait_for(std::chrono::seconds(0)) ==
+                   std::future_status::ready;
+    }
+
+    /**
+     * @brief Wait for the load
+     * @return The resource, or nullptr if loading failed
+     */
+    T* get() const { return mFuture.valid() ? mFuture.get() : nullptr; }
+
+    ResourceId getId() const { return mId; }
+};
+
+/**
+ * @brief Snapshot of outstanding loads, for a loading screen
+ */
+struct LoadProgress {
+    unsigned requested;
+    unsigned completed;
+    unsigned failed;
+
+    bool isDone() const { return completed + failed >= requested; }
+
+    float getFraction() const {
+        return requested == 0
+                   ? 1.f
+                   : static_cast<float>(completed + failed) / requested;
+    }
+};
+
+/**
+ * @brief Called on the game thread after a resource was swapped
+ */
+using ReloadListener =
+    std::function<void(PackEntryKind kind, const std::string& name,
+                       const std::string& filepath)>;
 
 class ResourceManager {
+   public:
+    // Default budgets, sized so a 512 MB kiosk keeps headroom
+    static constexpr std::size_t FONT_BUDGET = 8u << 20;
+    static constexpr std::size_t TEXTURE_BUDGET = 128u << 20;
+    static constexpr std::size_t SOUND_BUDGET = 48u << 20;
+
    private:
+    using FontTable = ConcurrentResourceTable<sf::Font>;
+    using TextureTable = ConcurrentResourceTable<sf::Texture>;
+    using SoundTable = ConcurrentResourceTable<sf::SoundBuffer>;
+
     // Singleton instance
     inline static ResourceManager* sInstance = nullptr;
 
     // Resource containers
-    std::map<std::string, std::unique_ptr<sf::Font>> mFonts;
-    std::map<std::string, std::unique_ptr<sf::Texture>> mTextures;
-    std::map<std::string, std::unique_ptr<sf::SoundBuffer>> mSoundBuffers;
+    FontTable mFonts;
+    TextureTable mTextures;
+    SoundTable mSoundBuffers;
+
+    // Mapped packs; pack resources reload from these after eviction
+    std::mutex mPackMutex;
+    std::vector<std::unique_ptr<AssetPack>> mPacks;
+
+    // Load bookkeeping
+    std::atomic<unsigned> mRequested;
+    std::atomic<unsigned> mCompleted;
+    std::atomic<unsigned> mFailed;
+    std::mutex mLoadMutex;
+    std::condition_variable mLoadDone;
+
+    // Finished reloads waiting for the next frame boundary
+    struct PendingReload {
+        PackEntryKind kind;
+        std::string name;
+        std::string filepath;
+        FontTable::Loaded font;
+        TextureTable::Loaded texture;
+        SoundTable::Loaded sound;
+    };
+    std::mutex mReloadMutex;
+    std::vector<PendingReload> mPendingReloads;
+    std::vector<ReloadListener> mReloadListeners;
+
+    // Workers are declared last so they are joined before the tables die
+    ThreadPool mDecodePool;
+    ThreadPool mUploadPool;
+
+    /**
+     * @brief A pack entry after the parallel decode stage
+     */
+    struct StagedEntry {
+        const std::uint8_t* data = nullptr;
+        std::size_t size = 0;
+        std::vector<std::uint8_t> inflated;
+        sf::Image image;
+        std::unique_ptr<sf::SoundBuffer> sound;
+        bool ok = true;
+    };
 
     // Private constructor for singleton
-    ResourceManager() = default;
+    ResourceManager()
+        : mRequested(0),
+          mCompleted(0),
+          mFailed(0),
+          mDecodePool(ThreadPool::defaultThreadCount()),
+          mUploadPool(ThreadPool::defaultThreadCount() > 0 ? 1 : 0, [] {
+              // Shares its objects with the window's context
+              static thread_local sf::Context context;
+              (void)context;
+          }) {
+        mFonts.setBudget(FONT_BUDGET);
+        mTextures.setBudget(TEXTURE_BUDGET);
+        mSoundBuffers.setBudget(SOUND_BUDGET);
+    }
 
     // Delete copy constructor and assignment operator
     ResourceManager(const ResourceManager&) = delete;
     ResourceManager& operator=(const ResourceManager&) = delete;
 
+    void beginLoad() { mRequested.fetch_add(1, std::memory_order_relaxed); }
+
+    void finishLoad(bool success) {
+        {
+            std::lock_guard<std::mutex> lock(mLoadMutex);
+            (success ? mCompleted : mFailed)
+                .fetch_add(1, std::memory_order_relaxed);
+        }
+        mLoadDone.notify_all();
+    }
+
+    /**
+     * @brief Queue a load job and publish its result
+     * @param table Destination table
+     * @param loader Runs on a worker; kept for reloading after eviction
+     */
+    template <typename T>
+    LoadHandle<T> startLoad(ConcurrentResourceTable<T>& table,
+                            const std::string& name, const char* kind,
+                            typename ConcurrentResourceTable<T>::Loader loader) {
+        auto promise = std::make_shared<std::promise<T*>>();
+        std::shared_future<T*> future = promise->get_future().share();
+        beginLoad();
+
+        if (!table.reserve(name, future, loader)) {
+            promise->set_value(nullptr);
+            finishLoad(false);
+            return LoadHandle<T>(ResourceId(name), future);
+        }
+
+        const std::int64_t queuedUs = TraceRecorder::getInstance().nowUs();
+        mDecodePool.submit([&table, name, kind, loader, promise, queuedUs,
+                            this]() {
+            TraceRecorder& trace = TraceRecorder::getInstance();
+            trace.record(std::string(kind) + " " + name, "queued", queuedUs,
+                         trace.nowUs());
+            ScopedTrace span(std::string(kind) + " " + name, "load");
+
+            T* published = table.publish(name, loader());
+            if (published) {
+                std::cout << "Successfully loaded " << kind << ": " << name
+                          << "\n";
+            }
+            promise->set_value(published);
+            finishLoad(published != nullptr);
+        });
+
+        return LoadHandle<T>(ResourceId(name), future);
+    }
+
+    /**
+     * @brief Pinning lookup: waits if mid-load, reloads if evicted
+     */
+    template <typename T>
+    static T& getLoaded(ConcurrentResourceTable<T>& table, ResourceId id,
+                        const char* kind) {
+        T* resource = table.pin(id);
+        if (resource == nullptr) {
+            std::shared_future<T*> pending = table.getPending(id);
+            resource = pending.valid() ? pending.get() : table.restore(id);
+            if (resource) table.pin(id);
+        }
+        if (resource == nullptr) {
+            throw std::runtime_error(std::string(kind) +
+                                     " not found: " + id.toString());
+        }
+        return *resource;
+    }
+
+    /**
+     * @brief Upload an image on the loader thread that owns a GL context
+     */
+    std::unique_ptr<sf::Texture> uploadTexture(const sf::Image& image) {
+        return mUploadPool
+            .submit([&image]() {
+                ScopedTrace span("texture upload", "upload");
+                auto texture = std::make_unique<sf::Texture>();
+                if (!texture->loadFromImage(image)) texture.reset();
+                return texture;
+            })
+            .get();
+    }
+
+    static std::size_t textureBytes(const sf::Texture& texture) {
+        return static_cast<std::size_t>(texture.getSize().x) *
+               texture.getSize().y * 4;
+    }
+
+    static std::size_t soundBytes(const sf::SoundBuffer& buffer) {
+        return static_cast<std::size_t>(buffer.getSampleCount()) *
+               sizeof(sf::Int16);
+    }
+
+    /**
+     * @brief Font that reads its file data in place
+     * @param backing Owned copy of the data; empty if data is mapped
+     */
+    static FontTable::Loaded makeFont(const std::uint8_t* data,
+                                      std::size_t size,
+                                      std::vector<std::uint8_t> backing) {
+        FontTable::Loaded loaded;
+        if (!backing.empty()) {
+            data = backing.data();
+            size = backing.size();
+        }
+        auto font = std::make_unique<sf::Font>();
+        if (!font->loadFromMemory(data, size)) return loaded;
+
+        loaded.value = std::move(font);
+        loaded.bytes = size;
+        loaded.backing = std::move(backing);
+        return loaded;
+    }
+
+    TextureTable::Loaded makeTexture(const sf::Image& image) {
+        TextureTable::Loaded loaded;
+        loaded.value = uploadTexture(image);
+        if (loaded.value) loaded.bytes = textureBytes(*loaded.value);
+        return loaded;
+    }
+
+    static SoundTable::Loaded makeSound(
+        std::unique_ptr<sf::SoundBuffer> buffer) {
+        SoundTable::Loaded loaded;
+        if (buffer) loaded.bytes = soundBytes(*buffer);
+        loaded.value = std::move(buffer);
+        return loaded;
+    }
+
+    static FontTable::Loader fontFileLoader(const std::string& filepath) {
+        return [filepath]() {
+            // Read it ourselves so the bytes can be accounted for
+            std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+            std::vector<std::uint8_t> data;
+            if (file.is_open()) {
+                data.resize(static_cast<std::size_t>(file.tellg()));
+                file.seekg(0);
+                file.read(reinterpret_cast<char*>(data.data()),
+                          static_cast<std::streamsize>(data.size()));
+            }
+            if (!file || data.empty()) {
+                std::cerr << "ERROR::RESOURCEMANAGER::Failed to load font: "
+                          << filepath << "\n";
+                return FontTable::Loaded();
+            }
+            FontTable::Loaded loaded = makeFont(nullptr, 0, std::move(data));
+            if (!loaded.value) {
+                std::cerr << "ERROR::RESOURCEMANAGER::Failed to load font: "
+                          << filepath << "\n";
+            }
+            return loaded;
+        };
+    }
+
+    TextureTable::Loader textureFileLoader(const std::string& filepath) {
+        return [this, filepath]() {
+            sf::Image image;
+            if (!image.loadFromFile(filepath)) {
+                std::cerr << "ERROR::RESOURCEMANAGER::Failed to load texture: "
+                          << filepath << "\n";
+                return TextureTable::Loaded();
+            }
+            return makeTexture(image);
+        };
+    }
+
+    static SoundTable::Loader soundFileLoader(const std::string& filepath) {
+        return [filepath]() {
+            auto soundBuffer = std::make_unique<sf::SoundBuffer>();
+            if (!soundBuffer->loadFromFile(filepath)) {
+                std::cerr << "ERROR::RESOURCEMANAGER::Failed to load sound: "
+                          << filepath << "\n";
+                soundBuffer.reset();
+            }
+            return makeSound(std::move(soundBuffer));
+        };
+    }
+
+    /**
+     * @brief Decompress and CPU-decode one entry (runs on a worker thread)
+     */
+    static void stageEntry(const AssetPack& pack, const PackEntry& entry,
+                           StagedEntry& staged) {
+        staged.data = pack.getData(entry);
+        staged.size = static_cast<std::size_t>(entry.storedSize);
+
+        if (entry.isCompressed()) {
+            staged.inflated.resize(static_cast<std::size_t>(entry.rawSize));
+            if (!Lz4Lite::decompress(staged.data, staged.size,
+                                     staged.inflated.data(),
+                                     staged.inflated.size())) {
+                staged.ok = false;
+                return;
+            }
+            staged.data = staged.inflated.data();
+            staged.size = staged.inflated.size();
+        }
+
+        switch (entry.kind) {
+            case PackEntryKind::TEXTURE:
+                staged.ok = staged.image.loadFromMemory(staged.data, staged.size);
+                break;
+            case PackEntryKind::SOUND:
+                staged.sound = std::make_unique<sf::SoundBuffer>();
+                staged.ok = staged.sound->loadFromMemory(staged.data, staged.size);
+                break;
+            case PackEntryKind::FONT:
+                break;  // Fonts parse lazily from the bytes in place
+        }
+    }
+
+    /**
+     * @brief Create and register the resource for a staged pack entry
+     *
+     * The registered loader re-stages the entry from the mapped pack, so an
+     * evicted pack resource comes back without touching the file system.
+     */
+    bool registerPackEntry(const AssetPack& pack, const PackEntry& entry,
+                           StagedEntry& item) {
+        if (!item.ok) return false;
+        const AssetPack* source = &pack;
+        const PackEntry* sourceEntry = &entry;
+
+        switch (entry.kind) {
+            case PackEntryKind::FONT:
+                return mFonts.insert(
+                    entry.name,
+                    makeFont(item.data, item.size, std::move(item.inflated)),
+                    [source, sourceEntry]() {
+                        StagedEntry again;
+                        stageEntry(*source, *sourceEntry, again);
+                        return again.ok ? makeFont(again.data, again.size,
+                                                   std::move(again.inflated))
+                                        : FontTable::Loaded();
+                    });
+            case PackEntryKind::TEXTURE:
+                return mTextures.insert(
+                    entry.name, makeTexture(item.image),
+                    [this, source, sourceEntry]() {
+                        StagedEntry again;
+                        stageEntry(*source, *sourceEntry, again);
+                        return again.ok ? makeTexture(again.image)
+                                        : TextureTable::Loaded();
+                    });
+            case PackEntryKind::SOUND:
+                return mSoundBuffers.insert(
+                    entry.name, makeSound(std::move(item.sound)),
+                    [source, sourceEntry]() {
+                        StagedEntry again;
+                        stageEntry(*source, *sourceEntry, again);
+                        return makeSound(again.ok ? std::move(again.sound)
+                                                  : nullptr);
+                    });
+        }
+        return false;
+    }
+
+    /**
+     * @brief Map a pack and load all its entries (runs on a worker thread)
+     */
+    bool loadPackNow(const std::string& filepath) {
+        ScopedTrace span("pack " + filepath, "load");
+
+        auto pack = std::make_unique<AssetPack>();
+        if (!pack->open(filepath)) {
+            std::cerr << "ERROR::RESOURCEMANAGER::Failed to open pack: "
+                      << filepath << "\n";
+            return false;
+        }
+
+        const std::uint32_t count = pack->getEntryCount();
+        std::vector<StagedEntry> staged(count);
+        std::vector<std::future<void>> jobs;
+
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const PackEntry& entry = pack->getEntry(i);
+            if (entry.kind == PackEntryKind::FONT && !entry.isCompressed()) {
+                // Zero-copy: nothing to do off-thread
+                stageEntry(*pack, entry, staged[i]);
+            } else {
+                jobs.push_back(ThreadPool::async(stageEntry, std::cref(*pack),
+                                                 std::cref(entry),
+                                                 std::ref(staged[i])));
+            }
+        }
+        for (auto& job : jobs) {
+            job.wait();
+        }
+
+        bool allLoaded = true;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const PackEntry& entry = pack->getEntry(i);
+            if (!registerPackEntry(*pack, entry, staged[i])) {
+                std::cerr << "ERROR::RESOURCEMANAGER::Failed to load pack "
+                             "entry: "
+                          << entry.name << "\n";
+                allLoaded = false;
+            }
+        }
+
+        std::cout << "Loaded asset pack: " << filepath << " (" << count
+                  << " entries)\n";
+        std::lock_guard<std::mutex> lock(mPackMutex);
+        mPacks.push_back(std::move(pack));
+        return allLoaded;
+    }
+
    public:
     /**
      * @brief Get the singleton instance
@@ -54,108 +516,331 @@ class ResourceManager {
     }
 
     /**
-     * @brief Load a font from file
+     * @brief Start loading a font
+     * @param name Identifier for the font
+     * @param filepath Path to the font file
+     * @return Handle that resolves to the font, or nullptr on failure
+     */
+    LoadHandle<sf::Font> loadFontAsync(const std::string& name,
+                                       const std::string& filepath) {
+        return startLoad(mFonts, name, "font", fontFileLoader(filepath));
+    }
+
+    /**
+     * @brief Start loading a texture
+     *
+     * The image is decoded on a worker and uploaded by the loader thread.
+     * @param name Identifier for the texture
+     * @param filepath Path to the texture file
+     */
+    LoadHandle<sf::Texture> loadTextureAsync(const std::string& name,
+                                             const std::string& filepath) {
+        return startLoad(mTextures, name, "texture",
+                         textureFileLoader(filepath));
+    }
+
+    /**
+     * @brief Start loading a sound buffer
+     * @param name Identifier for the sound
+     * @param filepath Path to the sound file
+     */
+    LoadHandle<sf::SoundBuffer> loadSoundAsync(const std::string& name,
+                                               const std::string& filepath) {
+        return startLoad(mSoundBuffers, name, "sound",
+                         soundFileLoader(filepath));
+    }
+
+    /**
+     * @brief Load a font from file (blocks until done)
      * @param name Identifier for the font
      * @param filepath Path to the font file
      * @return true if loaded successfully, false otherwise
      */
     bool loadFont(const std::string& name, const std::string& filepath) {
-        auto font = std::make_unique<sf::Font>();
-        if (!font->loadFromFile(filepath)) {
-            std::cerr << "ERROR::RESOURCEMANAGER::Failed to load font: "
-                      << filepath << "\n";
-            return false;
-        }
-        mFonts[name] = std::move(font);
-        std::cout << "Successfully loaded font: " << name << "\n";
-        return true;
+        return loadFontAsync(name, filepath).get() != nullptr;
     }
 
     /**
-     * @brief Load a texture from file
+     * @brief Load a texture from file (blocks until done)
      * @param name Identifier for the texture
      * @param filepath Path to the texture file
      * @return true if loaded successfully, false otherwise
      */
     bool loadTexture(const std::string& name, const std::string& filepath) {
-        auto texture = std::make_unique<sf::Texture>();
-        if (!texture->loadFromFile(filepath)) {
-            std::cerr << "ERROR::RESOURCEMANAGER::Failed to load texture: "
-                      << filepath << "\n";
-            return false;
-        }
-        mTextures[name] = std::move(texture);
-        std::cout << "Successfully loaded texture: " << name << "\n";
-        return true;
+        return loadTextureAsync(name, filepath).get() != nullptr;
     }
 
     /**
-     * @brief Load a sound buffer from file
+     * @brief Load a sound buffer from file (blocks until done)
      * @param name Identifier for the sound
      * @param filepath Path to the sound file
      * @return true if loaded successfully, false otherwise
      */
     bool loadSound(const std::string& name, const std::string& filepath) {
-        auto soundBuffer = std::make_unique<sf::SoundBuffer>();
-        if (!soundBuffer->loadFromFile(filepath)) {
-            std::cerr << "ERROR::RESOURCEMANAGER::Failed to load sound: "
-                      << filepath << "\n";
-            return false;
+        return loadSoundAsync(name, filepath).get() != nullptr;
+    }
+
+    /**
+     * @brief Start loading every resource in an asset pack
+     *
+     * The pack is memory mapped once. Compressed entries are inflated and
+     * images/sounds decoded in parallel; textures are uploaded by the
+     * loader thread.
+     * @param filepath Path to the .ffpk file
+     * @return Future that is true if the pack opened and every entry loaded
+     */
+    std::shared_future<bool> loadPackAsync(const std::string& filepath) {
+        beginLoad();
+        return mDecodePool
+            .submit([this, filepath]() {
+                bool loaded = loadPackNow(filepath);
+                finishLoad(loaded);
+                return loaded;
+            })
+            .share();
+    }
+
+    /**
+     * @brief Load every resource in an asset pack (blocks until done)
+     */
+    bool loadPack(const std::string& filepath) {
+        return loadPackAsync(filepath).get();
+    }
+
+    /**
+     * @brief Re-decode a resource from disk in the background
+     *
+     * The running game keeps using the old value until applyReloads().
+     * @param kind Resource type
+     * @param name Identifier of the resource to replace
+     * @param filepath File to decode
+     */
+    void requestReload(PackEntryKind kind, const std::string& name,
+                       const std::string& filepath) {
+        mDecodePool.submit([this, kind, name, filepath]() {
+            ScopedTrace span("reload " + name, "load");
+            PendingReload reload{kind, name, filepath, {}, {}, {}};
+            bool loaded = false;
+
+            switch (kind) {
+                case PackEntryKind::FONT:
+                    reload.font = fontFileLoader(filepath)();
+                    loaded = reload.font.value != nullptr;
+                    break;
+                case PackEntryKind::TEXTURE:
+                    reload.texture = textureFileLoader(filepath)();
+                    loaded = reload.texture.value != nullptr;
+                    break;
+                case PackEntryKind::SOUND:
+                    reload.sound = soundFileLoader(filepath)();
+                    loaded = reload.sound.value != nullptr;
+                    break;
+            }
+
+            if (!loaded) {
+                // Keep the old resource; the file may be mid-save
+                std::cerr << "ERROR::RESOURCEMANAGER::Failed to reload: "
+                          << filepath << "\n";
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mReloadMutex);
+            mPendingReloads.push_back(std::move(reload));
+        });
+    }
+
+    /**
+     * @brief Register a callback run after each swapped-in reload
+     */
+    void addReloadListener(ReloadListener listener) {
+        mReloadListeners.push_back(std::move(listener));
+    }
+
+    /**
+     * @brief Swap finished reloads in (call on the game thread between
+     * frames)
+     *
+     * The replaced values stay alive, so anything still pointing at them
+     * keeps drawing until its listener re-binds it and calls
+     * releaseRetired(). Later evictions reload from the edited file.
+     * @return Number of resources swapped
+     */
+    std::size_t applyReloads() {
+        std::vector<PendingReload> ready;
+        {
+            std::lock_guard<std::mutex> lock(mReloadMutex);
+            if (mPendingReloads.empty()) return 0;
+            ready.swap(mPendingReloads);
+        }
+
+        for (PendingReload& reload : ready) {
+            switch (reload.kind) {
+                case PackEntryKind::FONT:
+                    mFonts.insert(reload.name, std::move(reload.font),
+                                  fontFileLoader(reload.filepath));
+                    break;
+                case PackEntryKind::TEXTURE:
+                    mTextures.insert(reload.name, std::move(reload.texture),
+                                     textureFileLoader(reload.filepath));
+                    break;
+                case PackEntryKind::SOUND:
+                    mSoundBuffers.insert(reload.name, std::move(reload.sound),
+                                         soundFileLoader(reload.filepath));
+                    break;
+            }
+            std::cout << "Reloaded: " << reload.name << "\n";
+            for (const auto& listener : mReloadListeners) {
+                listener(reload.kind, reload.name, reload.filepath);
+            }
         }
-        mSoundBuffers[name] = std::move(soundBuffer);
-        std::cout << "Successfully loaded sound: " << name << "\n";
-        return true;
+        return ready.size();
     }
 
     /**
-     * @brief Get a font by name
-     * @param name Font identifier
-     * @return Reference to the font
-     * @throws std::runtime_error if font not found
+     * @brief Free the values of one class replaced by reloads, once every
+     * plain reference to them has been re-bound (game thread)
+     * @return Number of values freed
      */
-    sf::Font& getFont(const std::string& name) {
-        auto it = mFonts.find(name);
-        if (it == mFonts.end()) {
-            throw std::runtime_error("Font not found: " + name);
+    std::size_t releaseRetired(PackEntryKind kind) {
+        switch (kind) {
+            case PackEntryKind::FONT:
+                return mFonts.releaseRetired();
+            case PackEntryKind::TEXTURE:
+                return mTextures.releaseRetired();
+            case PackEntryKind::SOUND:
+                return mSoundBuffers.releaseRetired();
         }
-        return *it->second;
+        return 0;
+    }
+
+    /**
+     * @brief Progress of all loads requested so far
+     */
+    LoadProgress getLoadProgress() const {
+        return {mRequested.load(std::memory_order_relaxed),
+                mCompleted.load(std::memory_order_relaxed),
+                mFailed.load(std::memory_order_relaxed)};
     }
 
     /**
-     * @brief Get a texture by name
-     * @param name Texture identifier
+     * @brief Block until every requested load has finished
+     */
+    void waitForLoads() {
+        std::unique_lock<std::mutex> lock(mLoadMutex);
+        mLoadDone.wait(lock, [this] { return getLoadProgress().isDone(); });
+    }
+
+    /**
+     * @brief Check whether a font is loaded
+     */
+    bool hasFont(ResourceId id) const { return mFonts.find(id) != nullptr; }
+
+    /**
+     * @brief Get a font by id (pins it in memory)
+     * @param id Font identifier (a name converts implicitly)
+     * @return Reference to the font
+     * @throws std::runtime_error if font not found
+     */
+    sf::Font& getFont(ResourceId id) { return getLoaded(mFonts, id, "Font"); }
+
+    /**
+     * @brief Get a texture by id (pins it in memory)
+     * @param id Texture identifier (a name converts implicitly)
      * @return Reference to the texture
      * @throws std::runtime_error if texture not found
      */
-    sf::Texture& getTexture(const std::string& name) {
-        auto it = mTextures.find(name);
-        if (it == mTextures.end()) {
-            throw std::runtime_error("Texture not found: " + name);
-        }
-        return *it->second;
+    sf::Texture& getTexture(ResourceId id) {
+        return getLoaded(mTextures, id, "Texture");
     }
 
     /**
-     * @brief Get a sound buffer by name
-     * @param name Sound identifier
+     * @brief Get a sound buffer by id (pins it in memory)
+     * @param id Sound identifier (a name converts implicitly)
      * @return Reference to the sound buffer
      * @throws std::runtime_error if sound not found
      */
-    sf::SoundBuffer& getSound(const std::string& name) {
-        auto it = mSoundBuffers.find(name);
-        if (it == mSoundBuffers.end()) {
-            throw std::runtime_error("Sound not found: " + name);
+    sf::SoundBuffer& getSound(ResourceId id) {
+        return getLoaded(mSoundBuffers, id, "Sound");
+    }
+
+    /**
+     * @brief Take a counted reference to a font, reloading it if evicted
+     * @return Empty handle if the font is unknown or cannot be loaded
+     */
+    ResourceHandle<sf::Font> acquireFont(ResourceId id) {
+        return mFonts.acquire(id);
+    }
+
+    /**
+     * @brief Take a counted reference to a texture, reloading it if evicted
+     * @return Empty handle if the texture is unknown or cannot be loaded
+     */
+    ResourceHandle<sf::Texture> acquireTexture(ResourceId id) {
+        return mTextures.acquire(id);
+    }
+
+    /**
+     * @brief Take a counted reference to a sound, reloading it if evicted
+     * @return Empty handle if the sound is unknown or cannot be loaded
+     */
+    ResourceHandle<sf::SoundBuffer> acquireSound(ResourceId id) {
+        return mSoundBuffers.acquire(id);
+    }
+
+    /**
+     * @brief Set the memory budget for one resource class
+     * @param kind Resource class
+     * @param bytes Budget in bytes (0 = unlimited)
+     */
+    void setMemoryBudget(PackEntryKind kind, std::size_t bytes) {
+        switch (kind) {
+            case PackEntryKind::FONT:
+                mFonts.setBudget(bytes);
+                break;
+            case PackEntryKind::TEXTURE:
+                mTextures.setBudget(bytes);
+                break;
+            case PackEntryKind::SOUND:
+                mSoundBuffers.setBudget(bytes);
+                break;
         }
-        return *it->second;
     }
 
     /**
-     * @brief Clear all loaded resources
+     * @brief Resident and evicted bytes for one resource class
+     */
+    ResourceMemoryStats getMemoryStats(PackEntryKind kind) const {
+        switch (kind) {
+            case PackEntryKind::FONT:
+                return mFonts.getStats();
+            case PackEntryKind::TEXTURE:
+                return mTextures.getStats();
+            case PackEntryKind::SOUND:
+                return mSoundBuffers.getStats();
+        }
+        return {};
+    }
+
+    /**
+     * @brief Evict unreferenced resources until every class fits its
+     * budget (call on the game thread between frames)
+     * @return Number of resources evicted
+     */
+    std::size_t trimToBudget() {
+        return mFonts.trim() + mTextures.trim() + mSoundBuffers.trim();
+    }
+
+    /**
+     * @brief Clear all loaded resources (waits for pending loads first)
      */
     void clearAll() {
+        waitForLoads();
+        mReloadListeners.clear();
         mFonts.clear();
         mTextures.clear();
         mSoundBuffers.clear();
+
+        std::lock_guard<std::mutex> lock(mPackMutex);
+        mPacks.clear();
         std::cout << "All resources cleared\n";
     }
 
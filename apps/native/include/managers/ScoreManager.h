@@ -2,7 +2,10 @@
  * @file ScoreManager.h
  * @brief Singleton class for managing game scores and persistence
  *
- * Handles score tracking, high score persistence, and combo multipliers
+ * Handles score tracking, high score persistence, and combo multipliers.
+ * getInstance() is the process' own scores, saved under data/. Each world
+ * of a multi-world host (WorldContext) has an InMemory one instead, which
+ * never touches files or the console, so hundreds can run side by side.
  */
 
 #pragma once
@@ -38,26 +41,32 @@ class ScoreManager {
 
     const std::string DATA_FILE_PATH = "data/data.txt";
     const std::string LEADERBOARD_FILE_PATH = "data/leaderboard.txt";
-    const int MAX_LEADERBOARD_ENTRIES = 10;
+    const size_t MAX_LEADERBOARD_ENTRIES = 10;
 
     unsigned mCurrentScore;
     unsigned mHighScore;
     unsigned mComboCount;
     float mComboMultiplier;
-    const float BASE_MULTIPLIER = 1.0f;
-    const float MULTIPLIER_INCREMENT = 0.5f;
-    const int COMBO_THRESHOLD = 3;  // Combo starts after 3 consecutive hits
+    static constexpr float BASE_MULTIPLIER = 1.0f;
+    static constexpr float MULTIPLIER_INCREMENT = 0.5f;
+    // Combo starts after 3 consecutive hits
+    const unsigned COMBO_THRESHOLD = 3;
 
-    std::vector<ScoreEntry> mLeaderboard;
+    // Parsed on first use so it stays off the startup path
+    mutable std::vector<ScoreEntry> mLeaderboard;
+    mutable bool mLeaderboardLoaded;
+
+    const bool mPersistent;  // Files and console output; false for InMemory
 
     // Private constructor for singleton
     ScoreManager()
         : mCurrentScore(0),
           mHighScore(0),
           mComboCount(0),
-          mComboMultiplier(BASE_MULTIPLIER) {
+          mComboMultiplier(BASE_MULTIPLIER),
+          mLeaderboardLoaded(false),
+          mPersistent(true) {
         loadHighScore();
-        loadLeaderboard();
     }
 
     // Delete copy constructor and assignment
@@ -89,9 +98,13 @@ class ScoreManager {
     }
 
     /**
-     * @brief Load leaderboard from file
+     * @brief Load leaderboard from file, once, on first access
      */
-    void loadLeaderboard() {
+    void loadLeaderboard() const {
+        if (mLeaderboardLoaded) return;
+        mLeaderboardLoaded = true;
+        if (!mPersistent) return;
+
         std::ifstream file(LEADERBOARD_FILE_PATH);
         if (file.is_open()) {
             std::string name, date;
@@ -109,6 +122,23 @@ class ScoreManager {
     }
 
    public:
+    /**
+     * @brief Tag for scores kept in memory only
+     */
+    struct InMemory {};
+
+    /**
+     * @brief Scores for one world of many: starts at zero, never reads or
+     * writes files and never logs
+     */
+    explicit ScoreManager(InMemory)
+        : mCurrentScore(0),
+          mHighScore(0),
+          mComboCount(0),
+          mComboMultiplier(BASE_MULTIPLIER),
+          mLeaderboardLoaded(false),
+          mPersistent(false) {}
+
     /**
      * @brief Get singleton instance
      */
@@ -155,6 +185,7 @@ class ScoreManager {
         int pointsToAdd = static_cast<int>(basePoints * mComboMultiplier);
         mCurrentScore += pointsToAdd;
 
+        if (!mPersistent) return;
         std::cout << "Added " << pointsToAdd << " points (combo x"
                   << mComboMultiplier << ")\n";
     }
@@ -163,7 +194,7 @@ class ScoreManager {
      * @brief Break combo (called when missing an enemy)
      */
     void breakCombo() {
-        if (mComboCount > 0) {
+        if (mComboCount > 0 && mPersistent) {
             std::cout << "Combo broken! Was at " << mComboCount << " hits\n";
         }
         mComboCount = 0;
@@ -176,6 +207,7 @@ class ScoreManager {
     void saveHighScore() {
         if (mCurrentScore > mHighScore) {
             mHighScore = mCurrentScore;
+            if (!mPersistent) return;
 
             std::ofstream file(DATA_FILE_PATH);
             if (file.is_open()) {
@@ -196,6 +228,7 @@ class ScoreManager {
      */
     void addToLeaderboard(const std::string& playerName, unsigned score,
                           const std::string& date) {
+        loadLeaderboard();
         mLeaderboard.emplace_back(playerName, score, date);
 
         // Sort by score (descending)
@@ -213,6 +246,7 @@ class ScoreManager {
      * @brief Save leaderboard to file
      */
     void saveLeaderboard() {
+        if (!mPersistent) return;
         std::ofstream file(LEADERBOARD_FILE_PATH);
         if (file.is_open()) {
             for (const auto& entry : mLeaderboard) {
@@ -230,6 +264,7 @@ class ScoreManager {
      * @brief Check if current score qualifies for leaderboard
      */
     bool qualifiesForLeaderboard() const {
+        loadLeaderboard();
         if (mLeaderboard.size() < MAX_LEADERBOARD_ENTRIES) return true;
 
         return mCurrentScore > mLeaderboard.back().score;
@@ -241,6 +276,7 @@ class ScoreManager {
     unsigned getComboCount() const { return mComboCount; }
     float getComboMultiplier() const { return mComboMultiplier; }
     const std::vector<ScoreEntry>& getLeaderboard() const {
+        loadLeaderboard();
         return mLeaderboard;
     }
 
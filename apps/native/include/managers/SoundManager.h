@@ -2,23 +2,30 @@
  * @file SoundManager.h
  * @brief Singleton class for managing game audio
  *
- * Handles sound effects and background music with volume control
+ * Handles sound effects and background music with volume control.
+ * Sound effects are routed through AudioMixer so triggering one from the
+ * game thread never touches OpenAL.
  */
 
 #pragma once
 #include <SFML/Audio.hpp>
+#include <algorithm>
 #include <iostream>
-#include <map>
 #include <memory>
 #include <string>
 
+#include "audio/AudioMixer.h"
+#include "audio/MusicGenerator.h"
+#include "managers/ResourceId.h"
+
 class SoundManager {
    private:
     inline static SoundManager* sInstance = nullptr;
 
-    // Sound resources (managed by ResourceManager)
-    std::map<std::string, sf::Sound> mSounds;
-    std::map<std::string, std::unique_ptr<sf::Music>> mMusic;
+    // Sound effects are mixed on the mixer's own thread
+    AudioMixer mMixer;
+    ResourceTable<AudioMixer::ClipId> mClips;
+    ResourceTable<std::unique_ptr<sf::Music>> mMusic;
 
     // Volume settings
     float mSoundVolume;
@@ -28,13 +35,20 @@ class SoundManager {
 
     sf::Music* mCurrentMusic;
 
+    // Procedural soundtrack (created on first use)
+    std::unique_ptr<MusicGenerator> mGenerator;
+    bool mGeneratorActive;
+
     // Private constructor for singleton
     SoundManager()
         : mSoundVolume(70.f),
           mMusicVolume(50.f),
           mSoundEnabled(true),
           mMusicEnabled(true),
-          mCurrentMusic(nullptr) {
+          mCurrentMusic(nullptr),
+          mGeneratorActive(false) {
+        mMixer.setMasterVolume(mSoundVolume / 100.f);
+        mMixer.play();
         std::cout << "SoundManager initialized\n";
     }
 
@@ -42,6 +56,13 @@ class SoundManager {
     SoundManager(const SoundManager&) = delete;
     SoundManager& operator=(const SoundManager&) = delete;
 
+    void stopGeneratedMusic() {
+        if (mGeneratorActive) {
+            mGenerator->stop();
+            mGeneratorActive = false;
+        }
+    }
+
    public:
     /**
      * @brief Get singleton instance
@@ -65,14 +86,18 @@ class SoundManager {
 
     /**
      * @brief Register a sound with a buffer
+     *
+     * Registering a known name again (hot reload) replaces its clip;
+     * the old clip's slot is recycled once its voices finish.
      * @param name Sound identifier
-     * @param buffer Sound buffer to use
+     * @param buffer Sound buffer to copy into the mixer
      */
     void registerSound(const std::string& name, const sf::SoundBuffer& buffer) {
-        sf::Sound sound;
-        sound.setBuffer(buffer);
-        sound.setVolume(mSoundVolume);
-        mSounds[name] = sound;
+        const AudioMixer::ClipId* existing = mClips.find(name);
+        AudioMixer::ClipId clip = existing
+                                      ? mMixer.replaceClip(*existing, buffer)
+                                      : mMixer.addClip(buffer);
+        if (clip < 0 || !mClips.insert(name, clip)) return;
         std::cout << "Registered sound: " << name << "\n";
     }
 
@@ -92,46 +117,103 @@ class SoundManager {
 
         music->setVolume(mMusicVolume);
         music->setLoop(true);
-        mMusic[name] = std::move(music);
+        if (!mMusic.insert(name, std::move(music))) return false;
         std::cout << "Loaded music: " << name << "\n";
         return true;
     }
 
     /**
      * @brief Play a sound effect
-     * @param name Sound identifier
+     * @param id Sound identifier (a name converts implicitly)
+     * @param pitch Playback rate multiplier
+     * @return Voice handle (0 if nothing was played)
      */
-    void playSound(const std::string& name) {
-        if (!mSoundEnabled) return;
+    AudioMixer::VoiceId playSound(ResourceId id, float pitch = 1.f) {
+        if (!mSoundEnabled) return 0;
 
-        auto it = mSounds.find(name);
-        if (it != mSounds.end()) {
-            it->second.play();
-        } else {
-            std::cerr << "Sound not found: " << name << "\n";
+        if (const AudioMixer::ClipId* clip = mClips.find(id)) {
+            return mMixer.playClip(*clip, 1.f, pitch);
         }
+        std::cerr << "Sound not found: " << id.toString() << "\n";
+        return 0;
     }
 
     /**
-     * @brief Play music by name
-     * @param name Music identifier
+     * @brief Play music by id
+     * @param id Music identifier (a name converts implicitly)
      */
-    void playMusic(const std::string& name) {
+    void playMusic(ResourceId id) {
         if (!mMusicEnabled) return;
 
-        auto it = mMusic.find(name);
-        if (it != mMusic.end()) {
+        if (auto* music = mMusic.find(id)) {
             // Stop current music if playing
             if (mCurrentMusic &&
                 mCurrentMusic->getStatus() == sf::Music::Playing) {
                 mCurrentMusic->stop();
             }
+            stopGeneratedMusic();
 
-            mCurrentMusic = it->second.get();
+            mCurrentMusic = music->get();
             mCurrentMusic->play();
-            std::cout << "Playing music: " << name << "\n";
+            std::cout << "Playing music: " << id.toString() << "\n";
         } else {
-            std::cerr << "Music not found: " << name << "\n";
+            std::cerr << "Music not found: " << id.toString() << "\n";
+        }
+    }
+
+    /**
+     * @brief Play the procedural soundtrack instead of a music file
+     */
+    void playGeneratedMusic() {
+        if (mCurrentMusic) {
+            mCurrentMusic->stop();
+            mCurrentMusic = nullptr;
+        }
+        if (!mGenerator) {
+            mGenerator = std::make_unique<MusicGenerator>();
+            mGenerator->setVolume(mMusicVolume);
+        }
+        mGeneratorActive = true;
+        if (mMusicEnabled) {
+            mGenerator->play();
+        }
+    }
+
+    /**
+     * @brief Set procedural music intensity from game difficulty
+     * @param intensity 0 (calm) to 1 (frantic); cheap enough to call per frame
+     */
+    void setMusicIntensity(float intensity) {
+        if (mGenerator) {
+            mGenerator->setIntensity(intensity);
+        }
+    }
+
+    /**
+     * @brief Get procedural music synthesis cost (fraction of one core)
+     */
+    float getMusicCpuLoad() const {
+        return mGenerator ? mGenerator->getCpuLoad() : 0.f;
+    }
+
+    /**
+     * @brief Muffle all audio as health drops
+     * @param amount 0 (healthy, no filtering) to 1 (nearly dead)
+     */
+    void setLowHealthAmount(float amount) {
+        mMixer.getEffects().setLowPassAmount(amount);
+        if (mGenerator) {
+            mGenerator->getEffects().setLowPassAmount(amount);
+        }
+    }
+
+    /**
+     * @brief Add a short echo tail to everything currently playing
+     */
+    void triggerMilestoneEcho() {
+        mMixer.getEffects().triggerEcho();
+        if (mGenerator) {
+            mGenerator->getEffects().triggerEcho();
         }
     }
 
@@ -143,6 +225,7 @@ class SoundManager {
             mCurrentMusic->stop();
             mCurrentMusic = nullptr;
         }
+        stopGeneratedMusic();
     }
 
     /**
@@ -152,6 +235,9 @@ class SoundManager {
         if (mCurrentMusic) {
             mCurrentMusic->pause();
         }
+        if (mGeneratorActive) {
+            mGenerator->pause();
+        }
     }
 
     /**
@@ -161,6 +247,9 @@ class SoundManager {
         if (mCurrentMusic && mMusicEnabled) {
             mCurrentMusic->play();
         }
+        if (mGeneratorActive && mMusicEnabled) {
+            mGenerator->play();
+        }
     }
 
     /**
@@ -169,9 +258,7 @@ class SoundManager {
      */
     void setSoundVolume(float volume) {
         mSoundVolume = std::max(0.f, std::min(100.f, volume));
-        for (auto& pair : mSounds) {
-            pair.second.setVolume(mSoundVolume);
-        }
+        mMixer.setMasterVolume(mSoundVolume / 100.f);
     }
 
     /**
@@ -180,8 +267,11 @@ class SoundManager {
      */
     void setMusicVolume(float volume) {
         mMusicVolume = std::max(0.f, std::min(100.f, volume));
-        for (auto& pair : mMusic) {
-            pair.second->setVolume(mMusicVolume);
+        mMusic.forEach([this](std::unique_ptr<sf::Music>& music) {
+            music->setVolume(mMusicVolume);
+        });
+        if (mGenerator) {
+            mGenerator->setVolume(mMusicVolume);
         }
     }
 
@@ -192,9 +282,7 @@ class SoundManager {
         mSoundEnabled = enabled;
         if (!enabled) {
             // Stop all playing sounds
-            for (auto& pair : mSounds) {
-                pair.second.stop();
-            }
+            mMixer.stopAllVoices();
         }
     }
 
@@ -208,6 +296,14 @@ class SoundManager {
         } else if (enabled && mCurrentMusic) {
             mCurrentMusic->play();
         }
+
+        if (mGeneratorActive) {
+            if (enabled) {
+                mGenerator->play();
+            } else {
+                mGenerator->stop();
+            }
+        }
     }
 
     // Getters
@@ -216,6 +312,9 @@ class SoundManager {
     bool isSoundEnabled() const { return mSoundEnabled; }
     bool isMusicEnabled() const { return mMusicEnabled; }
     bool isMusicPlaying() const {
+        if (mGeneratorActive) {
+            return mGenerator->getStatus() == sf::SoundStream::Playing;
+        }
         return mCurrentMusic &&
                mCurrentMusic->getStatus() == sf::Music::Playing;
     }
@@ -223,11 +322,12 @@ class SoundManager {
     /**
      * @brief Stop all sounds
      */
-    void stopAllSounds() {
-        for (auto& pair : mSounds) {
-            pair.second.stop();
-        }
-    }
+    void stopAllSounds() { mMixer.stopAllVoices(); }
+
+    /**
+     * @brief Get trigger-to-mix latency of sound effects
+     */
+    MixerLatencyStats getMixerStats() const { return mMixer.getLatencyStats(); }
 
     /**
      * @brief Create placeholder sounds for testing (using sin wave generation)
@@ -244,7 +344,8 @@ class SoundManager {
         std::cout << "  - miss.wav (enemy reaches bottom)\n";
         std::cout << "  - combo.wav (combo milestone reached)\n";
         std::cout << "  - gameover.wav (game over sound)\n";
-        std::cout << "  - background.ogg (background music)\n";
+        std::cout << "  - background.ogg (background music, or use "
+                     "playGeneratedMusic())\n";
     }
 
     /**
@@ -253,6 +354,7 @@ class SoundManager {
     ~SoundManager() {
         stopAllSounds();
         stopMusic();
+        mMixer.stop();
         std::cout << "SoundManager destroyed\n";
     }
 };
@@ -0,0 +1,352 @@
+/**
+ * @file LoadTestClient.h
+ * @brief Many simulated players against a TournamentServer
+ *
+ *   FallingFury --load-test N [--host H] [--port P] [--seconds S]
+ *
+ * Opens N sessions (one TCP connection each, one shared UDP socket),
+ * then for S seconds (default 30) sends every session an input per
+ * server tick: aim at the lowest enemy of its latest snapshot, pressing
+ * and releasing on alternate ticks. At the end each session leaves and
+ * waits for its authoritative result.
+ *
+ * The report shows, per session, how fast the server's tick counter
+ * advanced against its nominal rate and how many snapshots arrived. The
+ * exit code is 1 if any session's server ran below
+ * MIN_TICK_RATE_FRACTION of nominal or a result never came, so a ramp of
+ * N over runs finds how many sessions the server's cores can carry; the
+ * server's own log gives the sessions per core.
+ */
+
+#pragma once
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "server/SessionProtocol.h"
+#include "sim/Vec2.h"
+#include "systems/PerfStats.h"
+
+class LoadTestClient {
+   public:
+    static constexpr const char* FLAG = "--load-test";
+    static constexpr double MIN_TICK_RATE_FRACTION = 0.95;
+    static constexpr float CONNECT_TIMEOUT_SECONDS = 5.f;
+    static constexpr float RESULT_TIMEOUT_SECONDS = 5.f;
+
+    struct Options {
+        unsigned sessions = 0;
+        std::string host = "127.0.0.1";
+        unsigned short port = SessionProtocol::DEFAULT_PORT;
+        unsigned seconds = 30;
+    };
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Session {
+        sf::TcpSocket control;
+        SessionProtocol::Welcome welcome;
+        std::vector<Vec2> enemies;  // Top-left, from the latest snapshot
+        sf::Uint32 sequence = 0;
+        bool pressed = false;
+
+        std::uint64_t snapshots = 0;
+        sf::Uint32 firstTick = 0;
+        sf::Uint32 lastTick = 0;
+        Clock::time_point firstAt;
+        Clock::time_point lastAt;
+
+        SessionProtocol::Result result;
+        bool hasResult = false;
+    };
+
+    Options mOptions;
+    sf::UdpSocket mUdp;
+    std::vector<std::unique_ptr<Session>> mSessions;
+    std::unordered_map<sf::Uint32, Session*> mById;
+    std::uint64_t mInputsSent = 0;
+
+    /**
+     * @brief Connect and JOIN all sessions first, then collect the
+     * WELCOMEs, so the server accepts them in a few ticks, not N
+     */
+    bool connect() {
+        const sf::IpAddress host(mOptions.host);
+        for (unsigned i = 0; i < mOptions.sessions; ++i) {
+            auto session = std::make_unique<Session>();
+            if (session->control.connect(
+                    host, mOptions.port,
+                    sf::seconds(CONNECT_TIMEOUT_SECONDS)) !=
+                sf::Socket::Done) {
+                std::cerr << "ERROR::LOADTEST::Cannot connect session " << i
+                          << " to " << mOptions.host << ":" << mOptions.port
+                          << "\n";
+                return false;
+            }
+            sf::Packet join;
+            join << SessionProtocol::Message::JOIN << SessionProtocol::MAGIC
+                 << static_cast<sf::Uint64>(i + 1)
+                 << static_cast<sf::Uint16>(mUdp.getLocalPort());
+            session->control.send(join);
+            mSessions.push_back(std::move(session));
+        }
+
+        for (std::size_t i = 0; i < mSessions.size(); ++i) {
+            Session& session = *mSessions[i];
+            sf::Packet reply;
+            SessionProtocol::Message message;
+            if (!receive(session, reply, CONNECT_TIMEOUT_SECONDS) ||
+                !SessionProtocol::readMessage(reply, message)) {
+                std::cerr << "ERROR::LOADTEST::No reply to JOIN for session "
+                          << i << "\n";
+                return false;
+            }
+            if (message == SessionProtocol::Message::FULL) {
+                std::cerr << "ERROR::LOADTEST::Server full after " << i
+                          << " sessions\n";
+                return false;
+            }
+            if (message != SessionProtocol::Message::WELCOME ||
+                !(reply >> session.welcome)) {
+                std::cerr << "ERROR::LOADTEST::Bad WELCOME for session " << i
+                          << "\n";
+                return false;
+            }
+            mById[session.welcome.session] = &session;
+        }
+        return true;
+    }
+
+    static bool receive(Session& session, sf::Packet& packet, float timeout) {
+        sf::SocketSelector selector;
+        selector.add(session.control);
+        return selector.wait(sf::seconds(timeout)) &&
+               session.control.receive(packet) == sf::Socket::Done;
+    }
+
+    void receiveSnapshots() {
+        sf::Packet packet;
+        sf::IpAddress sender;
+        unsigned short senderPort = 0;
+        while (mUdp.receive(packet, sender, senderPort) == sf::Socket::Done) {
+            SessionProtocol::Message message;
+            SessionProtocol::SnapshotHeader header;
+            if (!SessionProtocol::readMessage(packet, message) ||
+                message != SessionProtocol::Message::SNAPSHOT ||
+                !(packet >> header)) {
+                continue;
+            }
+            const auto found = mById.find(header.session);
+            if (found == mById.end()) continue;
+            Session& session = *found->second;
+            // UDP may reorder; an older snapshot is no news
+            if (session.snapshots > 0 && header.tick <= session.lastTick) {
+                continue;
+            }
+
+            session.enemies.clear();
+            for (sf::Uint16 i = 0; i < header.count; ++i) {
+                sf::Int16 x = 0;
+                sf::Int16 y = 0;
+                if (!(packet >> x >> y)) break;
+                session.enemies.emplace_back(x, y);
+            }
+
+            const Clock::time_point now = Clock::now();
+            if (session.snapshots == 0) {
+                session.firstTick = header.tick;
+                session.firstAt = now;
+            }
+            session.lastTick = header.tick;
+            session.lastAt = now;
+            ++session.snapshots;
+        }
+    }
+
+    void sendInputs(const sf::IpAddress& host) {
+        sf::Packet packet;
+        for (const std::unique_ptr<Session>& session : mSessions) {
+            SessionProtocol::Input input;
+            input.session = session->welcome.session;
+            input.sequence = ++session->sequence;
+
+            // The lowest enemy is the next to fall out
+            const Vec2* lowest = nullptr;
+            for (const Vec2& enemy : session->enemies) {
+                if (lowest == nullptr || enemy.y > lowest->y) lowest = &enemy;
+            }
+            if (lowest != nullptr) {
+                input.x = lowest->x + session->welcome.enemyWidth / 2.f;
+                input.y = lowest->y + session->welcome.enemyHeight / 2.f;
+                session->pressed = !session->pressed;
+            } else {
+                session->pressed = false;
+            }
+            input.down = session->pressed;
+
+            packet.clear();
+            packet << SessionProtocol::Message::INPUT << input;
+            mUdp.send(packet, host, mOptions.port);
+            ++mInputsSent;
+        }
+    }
+
+    void collectResults() {
+        for (const std::unique_ptr<Session>& session : mSessions) {
+            sf::Packet leave;
+            leave << SessionProtocol::Message::LEAVE;
+            session->control.send(leave);
+        }
+        for (const std::unique_ptr<Session>& session : mSessions) {
+            sf::Packet reply;
+            SessionProtocol::Message message;
+            if (receive(*session, reply, RESULT_TIMEOUT_SECONDS) &&
+                SessionProtocol::readMessage(reply, message) &&
+                message == SessionProtocol::Message::RESULT &&
+                (reply >> session->result)) {
+                session->hasResult = true;
+            }
+        }
+    }
+
+    /**
+     * @return Process exit code
+     */
+    int report(double seconds) const {
+        std::vector<double> tickRates;
+        std::vector<double> snapshotRates;
+        std::vector<double> scores;
+        unsigned missing = 0;
+        unsigned gamesOver = 0;
+        double nominal = 0.0;
+        for (const std::unique_ptr<Session>& session : mSessions) {
+            nominal = session->welcome.tickRate;
+            const double span =
+                std::chrono::duration<double>(session->lastAt -
+                                              session->firstAt)
+                    .count();
+            tickRates.push_back(
+                span > 0.0 ? (session->lastTick - session->firstTick) / span
+                           : 0.0);
+            snapshotRates.push_back(session->snapshots / seconds);
+            if (!session->hasResult) {
+                ++missing;
+                continue;
+            }
+            scores.push_back(session->result.score);
+            if (session->result.gameOver) ++gamesOver;
+        }
+
+        const double slowest =
+            *std::min_element(tickRates.begin(), tickRates.end());
+        std::printf("%zu sessions for %.1f s, %.0f inputs/s sent\n",
+                    mSessions.size(), seconds, mInputsSent / seconds);
+        std::printf("Server tick rate per session: mean %.1f  min %.1f Hz "
+                    "(nominal %.0f)\n",
+                    PerfStats::mean(tickRates), slowest, nominal);
+        std::printf("Snapshots per session: mean %.1f  min %.1f /s\n",
+                    PerfStats::mean(snapshotRates),
+                    *std::min_element(snapshotRates.begin(),
+                                      snapshotRates.end()));
+        if (!scores.empty()) {
+            std::printf("Authoritative scores: p50 %.0f  max %.0f; %u "
+                        "games over\n",
+                        PerfStats::percentile(scores, 0.50),
+                        *std::max_element(scores.begin(), scores.end()),
+                        gamesOver);
+        }
+
+        bool ok = true;
+        if (missing > 0) {
+            std::cerr << "ERROR::LOADTEST::" << missing
+                      << " sessions got no result\n";
+            ok = false;
+        }
+        if (slowest < nominal * MIN_TICK_RATE_FRACTION) {
+            std::cerr << "ERROR::LOADTEST::Server fell behind: slowest "
+                         "session ticked at "
+                      << slowest << " Hz of " << nominal << "\n";
+            ok = false;
+        }
+        return ok ? 0 : 1;
+    }
+
+   public:
+    explicit LoadTestClient(const Options& options) : mOptions(options) {}
+
+    int play() {
+        if (mUdp.bind(sf::Socket::AnyPort) != sf::Socket::Done) {
+            std::cerr << "ERROR::LOADTEST::Cannot open a UDP socket\n";
+            return 1;
+        }
+        mUdp.setBlocking(false);
+        if (!connect()) return 1;
+
+        const sf::IpAddress host(mOptions.host);
+        const unsigned tickRate =
+            std::max<unsigned>(mSessions.front()->welcome.tickRate, 1);
+        const auto period = std::chrono::nanoseconds(1000000000ll / tickRate);
+        std::printf("%zu sessions joined; playing for %u s at %u Hz\n",
+                    mSessions.size(), mOptions.seconds, tickRate);
+        std::fflush(stdout);
+
+        const Clock::time_point start = Clock::now();
+        const Clock::time_point end =
+            start + std::chrono::seconds(mOptions.seconds);
+        for (Clock::time_point next = start; next < end; next += period) {
+            receiveSnapshots();
+            sendInputs(host);
+            std::this_thread::sleep_until(next + period);
+        }
+        receiveSnapshots();
+        const double seconds =
+            std::chrono::duration<double>(Clock::now() - start).count();
+
+        collectResults();
+        return report(seconds);
+    }
+
+    static int usage(const char* argv0) {
+        std::cerr << "Usage: " << argv0 << " " << FLAG
+                  << " N [--host H] [--port P] [--seconds S]\n";
+        return 1;
+    }
+
+    /**
+     * @brief Parse the whole command line; --load-test must be on it
+     */
+    static bool parse(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], FLAG) == 0 && hasValue) {
+                options.sessions = static_cast<unsigned>(std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--host") == 0 && hasValue) {
+                options.host = argv[++i];
+            } else if (std::strcmp(argv[i], "--port") == 0 && hasValue) {
+                options.port =
+                    static_cast<unsigned short>(std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue) {
+                options.seconds = static_cast<unsigned>(std::atoi(argv[++i]));
+            }
+        }
+        return options.sessions > 0 && options.seconds > 0;
+    }
+
+    static int run(int argc, char** argv) {
+        Options options;
+        if (!parse(argc, argv, options)) return usage(argv[0]);
+        LoadTestClient client(options);
+        return client.play();
+    }
+};
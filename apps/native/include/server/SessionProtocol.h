@@ -0,0 +1,149 @@
+/**
+ * @file SessionProtocol.h
+ * @brief Messages between the tournament server and its players
+ *
+ * Control goes over TCP, one connection per session:
+ *   client -> JOIN    magic, seed (Uint64), UDP port the client listens on
+ *   server -> WELCOME session id, tick rate, snapshot interval (ticks),
+ *                     enemy width and height
+ *          or FULL    no free session
+ *   client -> LEAVE   end the session
+ *   server -> RESULT  session id, points, score, frames, whether the game
+ *                     ended; sent once, at game over or on LEAVE
+ *
+ * Play goes over UDP, where a late packet is better dropped than waited for:
+ *   client -> INPUT    session id, sequence, mouse x, y, button down
+ *   server -> SNAPSHOT session id, tick, health, points, score, enemy
+ *                      count, then each enemy's top-left as Int16 x, y
+ *
+ * An INPUT holds until the next one arrives; one with a sequence not
+ * above the last is stale and ignored. Scores only ever come from the
+ * server's own simulation: a client can aim and press, nothing else.
+ */
+
+#pragma once
+#include <SFML/Network.hpp>
+#include <cmath>
+#include <cstdint>
+
+namespace SessionProtocol {
+
+constexpr unsigned short DEFAULT_PORT = 47600;
+constexpr sf::Uint32 MAGIC = 0x46465431;  // "FFT1"
+
+enum class Message : sf::Uint8 {
+    JOIN = 1,
+    WELCOME,
+    FULL,
+    LEAVE,
+    RESULT,
+    INPUT,
+    SNAPSHOT
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, Message message) {
+    return packet << static_cast<sf::Uint8>(message);
+}
+
+/**
+ * @return false if the packet is empty or not a known message
+ */
+inline bool readMessage(sf::Packet& packet, Message& message) {
+    sf::Uint8 raw = 0;
+    if (!(packet >> raw)) return false;
+    if (raw < static_cast<sf::Uint8>(Message::JOIN) ||
+        raw > static_cast<sf::Uint8>(Message::SNAPSHOT)) {
+        return false;
+    }
+    message = static_cast<Message>(raw);
+    return true;
+}
+
+struct Welcome {
+    sf::Uint32 session = 0;
+    sf::Uint16 tickRate = 0;
+    sf::Uint16 snapshotEvery = 1;
+    float enemyWidth = 0.f;
+    float enemyHeight = 0.f;
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, const Welcome& welcome) {
+    return packet << welcome.session << welcome.tickRate
+                  << welcome.snapshotEvery << welcome.enemyWidth
+                  << welcome.enemyHeight;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, Welcome& welcome) {
+    return packet >> welcome.session >> welcome.tickRate >>
+           welcome.snapshotEvery >> welcome.enemyWidth >> welcome.enemyHeight;
+}
+
+struct Result {
+    sf::Uint32 session = 0;
+    sf::Uint32 points = 0;
+    sf::Uint32 score = 0;
+    sf::Uint64 frames = 0;
+    bool gameOver = false;
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, const Result& result) {
+    return packet << result.session << result.points << result.score
+                  << result.frames << result.gameOver;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, Result& result) {
+    return packet >> result.session >> result.points >> result.score >>
+           result.frames >> result.gameOver;
+}
+
+struct Input {
+    sf::Uint32 session = 0;
+    sf::Uint32 sequence = 0;
+    float x = 0.f;
+    float y = 0.f;
+    bool down = false;
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, const Input& input) {
+    return packet << input.session << input.sequence << input.x << input.y
+                  << input.down;
+}
+
+/**
+ * @brief Fails on a short packet or a position that is not a number
+ */
+inline sf::Packet& operator>>(sf::Packet& packet, Input& input) {
+    packet >> input.session >> input.sequence >> input.x >> input.y >>
+        input.down;
+    if (packet && (!std::isfinite(input.x) || !std::isfinite(input.y))) {
+        input.x = input.y = 0.f;
+        input.down = false;
+        input.sequence = 0;  // Never newer than anything
+    }
+    return packet;
+}
+
+/**
+ * @brief A SNAPSHOT up to its enemy list, which follows as count pairs
+ */
+struct SnapshotHeader {
+    sf::Uint32 session = 0;
+    sf::Uint32 tick = 0;
+    sf::Int32 health = 0;
+    sf::Uint32 points = 0;
+    sf::Uint32 score = 0;
+    sf::Uint16 count = 0;
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet,
+                              const SnapshotHeader& header) {
+    return packet << header.session << header.tick << header.health
+                  << header.points << header.score << header.count;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, SnapshotHeader& header) {
+    return packet >> header.session >> header.tick >> header.health >>
+           header.points >> header.score >> header.count;
+}
+
+}  // namespace SessionProtocol
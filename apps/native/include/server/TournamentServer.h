@@ -0,0 +1,565 @@
+/**
+ * @file TournamentServer.h
+ * @brief Headless server hosting many game sessions at a fixed tick rate
+ *
+ *   FallingFury --serve [port] [--workers W] [--tick-rate HZ]
+ *                       [--max-sessions M] [--seconds S]
+ *
+ * Each session is one world (WorldContext + PlayingState) on a shared
+ * headless EngineContext. Players join over TCP and send their mouse over
+ * UDP (see SessionProtocol.h); the server steps every session once per
+ * tick on a WorkStealingPool of W workers (default: one per core but the
+ * one this thread runs on), sends each player a snapshot every
+ * SNAPSHOT_EVERY ticks and, at game over or when the player leaves, the
+ * authoritative result.
+ *
+ * A tick is: accept and read control messages, read all pending inputs,
+ * step the sessions in parallel (each worker also writes the snapshots of
+ * the sessions it stepped), then send. Control messages a player's TCP
+ * window cannot take yet wait in that session's outbox and are retried
+ * on later ticks; a session that takes none of it for
+ * CONTROL_STALL_SECONDS is dropped. All socket work happens on this
+ * thread while the workers are idle, so sessions need no locks. A tick
+ * that overruns its period is counted and the schedule restarts from
+ * now rather than bursting to catch up.
+ *
+ * Once a second the server prints its tick times, how many cores it kept
+ * busy and the sessions per core that implies; drive it with
+ * `FallingFury --load-test N` to find the limit. Ctrl+C (or --seconds)
+ * stops it after sending every player their result.
+ */
+
+#pragma once
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/EngineContext.h"
+#include "core/PlayingState.h"
+#include "server/SessionProtocol.h"
+#include "systems/PerfStats.h"
+#include "systems/WorkStealingPool.h"
+
+class TournamentServer {
+   public:
+    static constexpr const char* FLAG = "--serve";
+    static constexpr unsigned DEFAULT_TICK_RATE = 60;
+    static constexpr unsigned SNAPSHOT_EVERY = 2;  // Ticks per snapshot
+    static constexpr unsigned DEFAULT_MAX_SESSIONS = 1024;
+    // Bounds one tick's input reading if a client floods the port
+    static constexpr unsigned MAX_DATAGRAMS_PER_TICK = 65536;
+    static constexpr unsigned JOIN_TIMEOUT_SECONDS = 5;
+    static constexpr unsigned CONTROL_STALL_SECONDS = 5;
+    // How long a stopping server keeps flushing results
+    static constexpr unsigned SHUTDOWN_FLUSH_MS = 1000;
+
+    struct Options {
+        unsigned short port = SessionProtocol::DEFAULT_PORT;
+        unsigned workers = 0;  // 0: one per core, less this thread
+        unsigned tickRate = DEFAULT_TICK_RATE;
+        unsigned maxSessions = DEFAULT_MAX_SESSIONS;
+        unsigned seconds = 0;  // 0: until Ctrl+C
+    };
+
+   private:
+    struct Session {
+        sf::Uint32 id = 0;
+        sf::Uint32 acceptedTick = 0;
+        sf::TcpSocket control;
+        std::deque<sf::Packet> outbox;  // Control packets not fully sent
+        sf::Uint32 stalledTicks = 0;    // Flushes in a row without progress
+        sf::IpAddress address;
+        unsigned short udpPort = 0;
+        std::unique_ptr<WorldContext> world;  // Once JOIN arrived
+        std::unique_ptr<PlayingState> state;
+        sf::Uint32 lastSequence = 0;
+        sf::Packet snapshot;  // Written by the worker that stepped it
+        bool snapshotReady = false;
+        bool resultSent = false;
+        bool closed = false;
+        std::uint64_t frames = 0;
+
+        bool joined() const { return state != nullptr; }
+    };
+
+    Options mOptions;
+    const EngineContext mEngine;
+    sf::TcpListener mListener;
+    sf::UdpSocket mUdp;
+    WorkStealingPool mWorkers;
+    float mTimestep;
+
+    std::vector<std::unique_ptr<Session>> mSessions;
+    std::unordered_map<sf::Uint32, Session*> mById;
+    std::vector<Session*> mActive;  // Joined, rebuilt every tick
+    sf::Uint32 mNextId;
+    sf::Uint32 mTick;
+    std::uint64_t mResults;
+
+    // Stats since the last report
+    std::vector<double> mTickUs;
+    std::uint64_t mOverruns;
+    std::uint64_t mNetworkNs;  // This thread's time outside the workers
+    std::uint64_t mReportBusyNs;
+    std::uint64_t mReportSteals;
+    std::chrono::steady_clock::time_point mReportStart;
+
+    static std::atomic<bool>& stopRequested() {
+        static std::atomic<bool> stop{false};
+        return stop;
+    }
+
+    static void onSignal(int) { stopRequested() = true; }
+
+    static std::uint64_t nanosSince(std::chrono::steady_clock::time_point t) {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - t)
+                .count());
+    }
+
+    /**
+     * @brief Send the outbox in order, as far as the socket takes it
+     *
+     * A packet remembers how much of it was sent, so a partial send
+     * resumes where it stopped. A broken socket closes the session.
+     */
+    void flushControl(Session& session) {
+        bool progress = false;
+        while (!session.outbox.empty()) {
+            const sf::Socket::Status status =
+                session.control.send(session.outbox.front());
+            if (status == sf::Socket::Done) {
+                session.outbox.pop_front();
+                progress = true;
+            } else if (status == sf::Socket::Partial) {
+                progress = true;
+                break;
+            } else if (status == sf::Socket::NotReady) {
+                break;
+            } else {
+                session.outbox.clear();
+                session.closed = true;
+                return;
+            }
+        }
+        session.stalledTicks = progress ? 0 : session.stalledTicks + 1;
+        if (!session.outbox.empty() &&
+            session.stalledTicks > CONTROL_STALL_SECONDS * mOptions.tickRate) {
+            session.outbox.clear();  // The player stopped reading
+            session.closed = true;
+        }
+    }
+
+    /**
+     * @brief Queue @p packet behind anything still unsent, then send what
+     * the socket takes now
+     */
+    void sendControl(Session& session, const sf::Packet& packet) {
+        if (session.closed && session.outbox.empty()) return;
+        session.outbox.push_back(packet);
+        if (session.outbox.size() == 1) flushControl(session);
+    }
+
+    void acceptSessions() {
+        for (;;) {
+            auto session = std::make_unique<Session>();
+            if (mListener.accept(session->control) != sf::Socket::Done) return;
+
+            if (mSessions.size() >= mOptions.maxSessions) {
+                // Still blocking: a few bytes into an empty send buffer
+                sf::Packet full;
+                full << SessionProtocol::Message::FULL;
+                session->control.send(full);
+                continue;  // Closed as it goes out of scope
+            }
+            session->control.setBlocking(false);
+            session->id = mNextId++;
+            session->acceptedTick = mTick;
+            session->address = session->control.getRemoteAddress();
+            mById[session->id] = session.get();
+            mSessions.push_back(std::move(session));
+        }
+    }
+
+    void join(Session& session, sf::Packet& packet) {
+        sf::Uint32 magic = 0;
+        sf::Uint64 seed = 0;
+        sf::Uint16 udpPort = 0;
+        if (!(packet >> magic >> seed >> udpPort) ||
+            magic != SessionProtocol::MAGIC || session.joined()) {
+            session.closed = true;
+            return;
+        }
+
+        const SimConfig config;
+        session.udpPort = udpPort;
+        session.world = std::make_unique<WorldContext>(mEngine, session.id,
+                                                       config, seed);
+        session.state = std::make_unique<PlayingState>(*session.world);
+
+        SessionProtocol::Welcome welcome;
+        welcome.session = session.id;
+        welcome.tickRate = static_cast<sf::Uint16>(mOptions.tickRate);
+        welcome.snapshotEvery = SNAPSHOT_EVERY;
+        welcome.enemyWidth = config.enemySize.x;
+        welcome.enemyHeight = config.enemySize.y;
+        sf::Packet reply;
+        reply << SessionProtocol::Message::WELCOME << welcome;
+        sendControl(session, reply);
+    }
+
+    void sendResult(Session& session) {
+        if (session.resultSent || !session.joined()) return;
+        session.resultSent = true;
+        ++mResults;
+
+        SessionProtocol::Result result;
+        result.session = session.id;
+        result.points = session.state->getPoints();
+        result.score = session.state->getScore();
+        result.frames = session.frames;
+        result.gameOver = session.state->shouldQuit();
+        sf::Packet packet;
+        packet << SessionProtocol::Message::RESULT << result;
+        sendControl(session, packet);
+    }
+
+    void receiveControl() {
+        sf::Packet packet;
+        for (const std::unique_ptr<Session>& session : mSessions) {
+            while (!session->closed) {
+                const sf::Socket::Status status =
+                    session->control.receive(packet);
+                if (status == sf::Socket::NotReady ||
+                    status == sf::Socket::Partial) {
+                    break;
+                }
+                if (status != sf::Socket::Done) {
+                    session->closed = true;  // Gone without a LEAVE
+                    break;
+                }
+
+                SessionProtocol::Message message;
+                if (!SessionProtocol::readMessage(packet, message)) {
+                    session->closed = true;
+                } else if (message == SessionProtocol::Message::JOIN) {
+                    join(*session, packet);
+                } else if (message == SessionProtocol::Message::LEAVE) {
+                    sendResult(*session);
+                    session->closed = true;
+                }
+            }
+        }
+    }
+
+    void receiveInputs() {
+        sf::Packet packet;
+        sf::IpAddress sender;
+        unsigned short senderPort = 0;
+        for (unsigned n = 0; n < MAX_DATAGRAMS_PER_TICK; ++n) {
+            if (mUdp.receive(packet, sender, senderPort) != sf::Socket::Done) {
+                return;
+            }
+
+            SessionProtocol::Message message;
+            SessionProtocol::Input input;
+            if (!SessionProtocol::readMessage(packet, message) ||
+                message != SessionProtocol::Message::INPUT ||
+                !(packet >> input)) {
+                continue;
+            }
+            const auto found = mById.find(input.session);
+            if (found == mById.end()) continue;
+            Session& session = *found->second;
+            // Only the port the player joined from steers the session
+            if (!session.joined() || sender != session.address ||
+                senderPort != session.udpPort ||
+                input.sequence <= session.lastSequence) {
+                continue;
+            }
+            session.lastSequence = input.sequence;
+
+            const Vec2& world = session.world->getSim().getConfig().worldSize;
+            SimInput sim;
+            sim.mouse = Vec2(std::min(std::max(input.x, 0.f), world.x),
+                             std::min(std::max(input.y, 0.f), world.y));
+            sim.mouseDown = input.down;
+            session.state->setInput(sim);
+        }
+    }
+
+    /**
+     * @brief On a worker: one tick of one session, and its snapshot
+     */
+    void stepSession(Session& session) {
+        if (session.state->shouldQuit()) return;
+        session.state->update(mTimestep);
+        ++session.frames;
+        if (mTick % SNAPSHOT_EVERY != 0) return;
+
+        const Simulation& sim = session.world->getSim();
+        SessionProtocol::SnapshotHeader header;
+        header.session = session.id;
+        header.tick = mTick;
+        header.health = sim.getHealth();
+        header.points = sim.getPoints();
+        header.score = session.state->getScore();
+        header.count = static_cast<sf::Uint16>(sim.getEnemies().size());
+
+        sf::Packet& packet = session.snapshot;
+        packet.clear();
+        packet << SessionProtocol::Message::SNAPSHOT << header;
+        for (const SimEnemy& enemy : sim.getEnemies()) {
+            packet << static_cast<sf::Int16>(enemy.bounds.left)
+                   << static_cast<sf::Int16>(enemy.bounds.top);
+        }
+        session.snapshotReady = true;
+    }
+
+    void sendUpdates() {
+        for (Session* session : mActive) {
+            if (session->snapshotReady) {
+                mUdp.send(session->snapshot, session->address,
+                          session->udpPort);
+                session->snapshotReady = false;
+            }
+            if (session->state->shouldQuit()) sendResult(*session);
+        }
+    }
+
+    /**
+     * @brief Drop closed sessions once their last control packets are out
+     * (or flushControl gave up on them)
+     */
+    void reap() {
+        const sf::Uint32 joinTimeout = JOIN_TIMEOUT_SECONDS * mOptions.tickRate;
+        for (std::size_t i = 0; i < mSessions.size();) {
+            Session& session = *mSessions[i];
+            if (!session.outbox.empty()) flushControl(session);
+            if (!session.joined() &&
+                mTick - session.acceptedTick > joinTimeout) {
+                session.closed = true;
+            }
+            if (!session.closed || !session.outbox.empty()) {
+                ++i;
+                continue;
+            }
+            mById.erase(session.id);
+            mSessions[i] = std::move(mSessions.back());
+            mSessions.pop_back();
+        }
+    }
+
+    void tick() {
+        auto start = std::chrono::steady_clock::now();
+        acceptSessions();
+        receiveControl();
+        receiveInputs();
+        mActive.clear();
+        for (const std::unique_ptr<Session>& session : mSessions) {
+            if (session->joined() && !session->closed) {
+                mActive.push_back(session.get());
+            }
+        }
+        mNetworkNs += nanosSince(start);
+
+        mWorkers.run(mActive.size(),
+                     [this](std::size_t i) { stepSession(*mActive[i]); });
+
+        const auto sending = std::chrono::steady_clock::now();
+        sendUpdates();
+        reap();
+        mNetworkNs += nanosSince(sending);
+        mTickUs.push_back(nanosSince(start) / 1000.0);
+        ++mTick;
+    }
+
+    void report() {
+        const double windowNs = static_cast<double>(nanosSince(mReportStart));
+        if (windowNs < 1e9 || mTickUs.empty()) return;
+
+        const WorkStealingPool::WorkerStats totals = mWorkers.getTotals();
+        const double workerCores =
+            (totals.busyNs - mReportBusyNs) / windowNs;
+        const double networkCores = mNetworkNs / windowNs;
+        const double cores = workerCores + networkCores;
+        // Finished games wait in mActive for LEAVE but cost no stepping
+        std::size_t sessions = 0;
+        for (const Session* session : mActive) {
+            if (!session->state->shouldQuit()) ++sessions;
+        }
+        std::printf(
+            "sessions %zu | tick p50 %.2f ms p99 %.2f ms max %.2f ms | "
+            "overruns %llu | busy %.2f cores (workers %.2f, net %.2f) | "
+            "%.0f sessions/core at %u Hz | steals %llu | results %llu\n",
+            sessions, PerfStats::percentile(mTickUs, 0.50) / 1000.0,
+            PerfStats::percentile(mTickUs, 0.99) / 1000.0,
+            *std::max_element(mTickUs.begin(), mTickUs.end()) / 1000.0,
+            static_cast<unsigned long long>(mOverruns), cores, workerCores,
+            networkCores, cores > 0.0 ? sessions / cores : 0.0,
+            mOptions.tickRate,
+            static_cast<unsigned long long>(totals.steals - mReportSteals),
+            static_cast<unsigned long long>(mResults));
+        std::fflush(stdout);
+
+        mTickUs.clear();
+        mOverruns = 0;
+        mNetworkNs = 0;
+        mReportBusyNs = totals.busyNs;
+        mReportSteals = totals.steals;
+        mReportStart = std::chrono::steady_clock::now();
+    }
+
+   public:
+    explicit TournamentServer(const Options& options)
+        : mOptions(options),
+          mEngine(EngineContext::headless()),
+          mWorkers(options.workers),
+          mTimestep(1.f / std::max(options.tickRate, 1u)),
+          mNextId(1),
+          mTick(0),
+          mResults(0),
+          mOverruns(0),
+          mNetworkNs(0),
+          mReportBusyNs(0),
+          mReportSteals(0) {
+        mTickUs.reserve(options.tickRate * 2);
+        mSessions.reserve(options.maxSessions);
+        mActive.reserve(options.maxSessions);
+    }
+
+    /**
+     * @brief Open the TCP and UDP ports
+     */
+    bool listen() {
+        if (mListener.listen(mOptions.port) != sf::Socket::Done ||
+            mUdp.bind(mOptions.port) != sf::Socket::Done) {
+            std::cerr << "ERROR::TOURNAMENTSERVER::Cannot listen on port "
+                      << mOptions.port << "\n";
+            return false;
+        }
+        mListener.setBlocking(false);
+        mUdp.setBlocking(false);
+        return true;
+    }
+
+    /**
+     * @brief Tick until Ctrl+C or the time limit, then send every player
+     * their result
+     */
+    void serve() {
+        std::signal(SIGINT, onSignal);
+        const auto period = std::chrono::nanoseconds(
+            1000000000ll / std::max(mOptions.tickRate, 1u));
+        const auto begin = std::chrono::steady_clock::now();
+        auto next = begin + period;
+        mReportStart = begin;
+
+        while (!stopRequested()) {
+            if (mOptions.seconds > 0 &&
+                nanosSince(begin) >= mOptions.seconds * 1000000000ull) {
+                break;
+            }
+            tick();
+            report();
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now > next) {
+                ++mOverruns;
+                next = now + period;
+            } else {
+                std::this_thread::sleep_until(next);
+                next += period;
+            }
+        }
+
+        for (const std::unique_ptr<Session>& session : mSessions) {
+            sendResult(*session);
+        }
+        const auto flushUntil = std::chrono::steady_clock::now() +
+                                std::chrono::milliseconds(SHUTDOWN_FLUSH_MS);
+        for (bool pending = true;
+             pending && std::chrono::steady_clock::now() < flushUntil;) {
+            pending = false;
+            for (const std::unique_ptr<Session>& session : mSessions) {
+                if (session->outbox.empty()) continue;
+                flushControl(*session);
+                pending = pending || !session->outbox.empty();
+            }
+            if (pending) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        std::printf("Stopped after %u ticks; %llu results sent\n", mTick,
+                    static_cast<unsigned long long>(mResults));
+    }
+
+    static int usage(const char* argv0) {
+        std::cerr << "Usage: " << argv0 << " " << FLAG
+                  << " [port] [--workers W] [--tick-rate HZ]"
+                     " [--max-sessions M] [--seconds S]\n";
+        return 1;
+    }
+
+    /**
+     * @brief Parse the whole command line; --serve must be on it
+     */
+    static bool parse(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], FLAG) == 0) {
+                if (hasValue && std::atoi(argv[i + 1]) > 0) {
+                    options.port =
+                        static_cast<unsigned short>(std::atoi(argv[++i]));
+                }
+            } else if (std::strcmp(argv[i], "--workers") == 0 && hasValue) {
+                options.workers = static_cast<unsigned>(std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--tick-rate") == 0 && hasValue) {
+                options.tickRate =
+                    static_cast<unsigned>(std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--max-sessions") == 0 &&
+                       hasValue) {
+                options.maxSessions =
+                    static_cast<unsigned>(std::atoi(argv[++i]));
+            } else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue) {
+                options.seconds = static_cast<unsigned>(std::atoi(argv[++i]));
+            }
+        }
+        return options.tickRate > 0 && options.maxSessions > 0;
+    }
+
+    /**
+     * @return Process exit code
+     */
+    static int run(int argc, char** argv) {
+        Options options;
+        if (!parse(argc, argv, options)) return usage(argv[0]);
+        if (options.workers == 0) {
+            options.workers =
+                std::max(2u, std::thread::hardware_concurrency()) - 1;
+        }
+
+        TournamentServer server(options);
+        if (!server.listen()) return 1;
+        std::printf("Serving on port %u: %u workers, %u Hz, up to %u "
+                    "sessions\n",
+                    options.port, options.workers, options.tickRate,
+                    options.maxSessions);
+        std::fflush(stdout);
+        server.serve();
+        return 0;
+    }
+};
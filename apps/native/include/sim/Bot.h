@@ -0,0 +1,98 @@
+/**
+ * @file Bot.h
+ * @brief A simulated player that produces SimInput from the game state
+ *
+ * Every tick the bot plans a click order over the enemies it has noticed,
+ * treating each as a job with a deadline (the time until it falls out of
+ * the world) and the hand's travel time between targets as set-up time.
+ * The plan is earliest deadline first, skipping any enemy it cannot reach
+ * in time, the way a player lets a lost cause go to save the next two.
+ * The bot then moves its cursor toward the head of the plan and presses
+ * once it is over it, subject to its skill:
+ *   - reactionDelay: an enemy is only noticed this long after it spawned
+ *   - aimNoise: each press lands off target by a normal error (pixels)
+ *   - clicksPerSecond: presses are at least 1 / clicksPerSecond apart
+ *   - handSpeed: how fast the cursor crosses the screen
+ * The output is an ordinary SimInput, so the bot drives whatever a real
+ * mouse would. The same seed and the same game give the same clicks.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sim/Random.h"
+#include "sim/Simulation.h"
+#include "sim/Vec2.h"
+
+struct BotSkill {
+    float reactionDelay = 0.3f;   // Seconds
+    float aimNoise = 8.f;         // Pixels, standard deviation
+    float clicksPerSecond = 4.f;
+    float handSpeed = 1500.f;     // Pixels per second
+
+    static BotSkill novice() { return {0.45f, 14.f, 2.5f, 900.f}; }
+    static BotSkill casual() { return BotSkill(); }
+    static BotSkill expert() { return {0.18f, 3.f, 8.f, 3000.f}; }
+
+    static constexpr unsigned LEVEL_COUNT = 3;
+
+    /**
+     * @brief novice, casual, expert for 0, 1, 2; wraps around, so a run
+     * can cycle skills by game or world number
+     */
+    static BotSkill level(unsigned index);
+    static const char* levelName(unsigned index);
+
+    /**
+     * @brief "novice", "casual" or "expert"
+     * @return false for any other name
+     */
+    static bool fromName(const std::string& name, BotSkill& skill);
+};
+
+class Bot {
+   private:
+    struct Job {
+        const SimEnemy* enemy;
+        float deadline;  // Seconds until it falls out
+    };
+
+    BotSkill mSkill;
+    Random mRandom;
+    Vec2 mCursor;
+    float mClock;        // Seconds since reset
+    float mNextClickAt;  // Earliest time for the next press
+    bool mPressed;       // Pressed last tick; must release first
+    std::uint64_t mClicks;
+    std::vector<Job> mJobs;  // Reused every tick
+    std::size_t mPlanLength;
+
+    /**
+     * @return First enemy of the plan, or nullptr
+     */
+    const SimEnemy* plan(const Simulation& sim);
+    float gaussian();
+
+   public:
+    Bot(const BotSkill& skill, std::uint64_t seed);
+
+    /**
+     * @brief Forget the plan and the click cooldown; the cursor stays
+     */
+    void reset();
+
+    /**
+     * @brief This tick's input; call once per Simulation::step with the
+     * same delta
+     */
+    SimInput think(const Simulation& sim, float deltaTime);
+
+    BotSkill& getSkill() { return mSkill; }
+    const BotSkill& getSkill() const { return mSkill; }
+    const Vec2& getCursor() const { return mCursor; }
+    std::uint64_t getClicks() const { return mClicks; }
+    std::size_t getPlanLength() const { return mPlanLength; }
+};
@@ -0,0 +1,66 @@
+/**
+ * @file HeadlessGame.h
+ * @brief One game frame without a window: rules, particles, HUD text
+ *
+ * Does per frame what Game::update() does, minus input polling, audio
+ * and drawing: steps the Simulation, turns hits into particle bursts,
+ * moves the particles and formats the HUD string. Tools that replay,
+ * train or soak the game run this, so they exercise the same code paths
+ * the player does. The best score is kept in memory rather than in
+ * data/data.txt.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "sim/ParticleField.h"
+#include "sim/Simulation.h"
+
+/**
+ * @brief Wall time of each part of the last frame (when timing is on)
+ */
+struct FrameTimings {
+    double simulationUs = 0.0;
+    double particlesUs = 0.0;
+    double hudUs = 0.0;
+};
+
+class HeadlessGame {
+   private:
+    Simulation mSim;
+    ParticleField mParticles;
+    std::string mHud;
+    unsigned mMaxPoint;
+    unsigned mGamesPlayed;
+    bool mTimed;
+    FrameTimings mTimings;
+
+    void formatHud();
+
+   public:
+    HeadlessGame(const SimConfig& config, std::uint64_t seed,
+                 std::size_t particlePool = 200);
+
+    /**
+     * @brief Run one frame with @p input; nothing moves once the game is over
+     */
+    void frame(float deltaTime, const SimInput& input);
+
+    /**
+     * @brief What Enter does on the game-over screen
+     */
+    void restart();
+
+    void setTimed(bool timed) { mTimed = timed; }
+    const FrameTimings& getTimings() const { return mTimings; }
+
+    Simulation& getSim() { return mSim; }
+    const Simulation& getSim() const { return mSim; }
+    ParticleField& getParticles() { return mParticles; }
+    const ParticleField& getParticles() const { return mParticles; }
+    const std::string& getHud() const { return mHud; }
+    unsigned getMaxPoint() const { return mMaxPoint; }
+    unsigned getGamesPlayed() const { return mGamesPlayed; }
+};
@@ -0,0 +1,69 @@
+/**
+ * @file ParticleField.h
+ * @brief Particle motion and fading, without any drawing
+ *
+ * The math half of ParticleSystem: a fixed pool of plain particles that
+ * bursts are emitted into and that update() moves, shrinks and fades.
+ * ParticleSystem draws them with SFML; headless runs just step them.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sim/Random.h"
+#include "sim/Vec2.h"
+
+struct SimParticle {
+    Vec2 position;
+    Vec2 velocity;
+    float lifetime = 0.f;
+    float maxLifetime = 1.f;
+    Rgba startColor;
+    Rgba endColor;
+    float startSize = 5.f;
+    float endSize = 0.f;
+    // Current look, recomputed by update()
+    float size = 5.f;
+    Rgba color;
+    bool active = false;
+};
+
+class ParticleField {
+   private:
+    std::vector<SimParticle> mParticles;
+    Random mRandom;
+
+    void emitParticle(SimParticle& particle, const Vec2& position,
+                      const Rgba& color, float speed);
+
+   public:
+    static constexpr float GRAVITY = 300.f;
+
+    /**
+     * @param poolSize Number of particles to pre-allocate
+     */
+    explicit ParticleField(std::size_t poolSize = 100, std::uint64_t seed = 1);
+
+    /**
+     * @brief Activate up to @p count idle particles at @p position
+     */
+    void emitBurst(const Vec2& position, int count, const Rgba& color,
+                   float speed = 1.0f);
+    void emitClickEffect(const Vec2& position, const Rgba& enemyColor);
+    void emitMissEffect(const Vec2& position);
+    void emitComboEffect(const Vec2& position);
+
+    void update(float deltaTime);
+
+    /**
+     * @brief Change the pool size; active particles are dropped
+     */
+    void resize(std::size_t poolSize);
+    std::size_t getPoolSize() const { return mParticles.size(); }
+
+    void clear();
+    int getActiveCount() const;
+    const std::vector<SimParticle>& getParticles() const { return mParticles; }
+};
@@ -0,0 +1,53 @@
+/**
+ * @file Random.h
+ * @brief Seeded random numbers for the simulation core
+ *
+ * rand() is shared by the whole process and its sequence differs between
+ * C libraries. The simulation owns one of these instead, so the same seed
+ * gives the same game on every platform and in every thread.
+ */
+
+#pragma once
+#include <cstdint>
+
+class Random {
+   private:
+    std::uint64_t mState;
+
+   public:
+    explicit Random(std::uint64_t seed = 1) { reseed(seed); }
+
+    void reseed(std::uint64_t seed) {
+        // Never zero, which xorshift cannot leave
+        mState = seed * 0x9E3779B97F4A7C15ull + 0x2545F4914F6CDD1Dull;
+        if (mState == 0) mState = 1;
+    }
+
+    /**
+     * @brief xorshift64*
+     */
+    std::uint64_t next() {
+        mState ^= mState >> 12;
+        mState ^= mState << 25;
+        mState ^= mState >> 27;
+        return mState * 0x2545F4914F6CDD1Dull;
+    }
+
+    /**
+     * @brief Integer in [0, bound); the bias is negligible for game use
+     */
+    int nextInt(int bound) {
+        if (bound <= 0) return 0;
+        return static_cast<int>((next() >> 33) % static_cast<std::uint64_t>(bound));
+    }
+
+    /**
+     * @brief Float in [0, 1)
+     */
+    float nextFloat() {
+        return static_cast<float>(next() >> 40) / static_cast<float>(1 << 24);
+    }
+
+    std::uint64_t getState() const { return mState; }
+    void setState(std::uint64_t state) { mState = state ? state : 1; }
+};
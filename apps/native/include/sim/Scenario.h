@@ -0,0 +1,102 @@
+/**
+ * @file Scenario.h
+ * @brief Scripted games: settings, spawns and clicks per frame
+ *
+ * A scenario is a small text file that fixes everything a run depends
+ * on, so it plays out identically every time at a fixed timestep:
+ *
+ *   # Comments start with '#'
+ *   seed 42
+ *   frames 3600            # Length of the run
+ *   timestep 0.0166667     # Seconds per frame
+ *   set gravity 200        # gravity, spawn_interval, max_enemies,
+ *                          # start_health, auto_spawn, particle_pool,
+ *                          # restart (start a new game when one ends)
+ *   spawn 120 450          # Frame, x: add an enemy
+ *   click 300 512 410      # Frame, x, y: press there this frame
+ *   aim 600 3000 20        # First, last, every: click the lowest enemy
+ *   bot casual 0 3600      # Skill, first, last: a Bot plays these frames
+ *                          # (novice, casual or expert)
+ *
+ * A press lasts one frame; presses on consecutive frames count as one
+ * held click, as they would with a real mouse.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sim/Bot.h"
+#include "sim/HeadlessGame.h"
+#include "sim/Simulation.h"
+#include "sim/Vec2.h"
+
+struct ScenarioAction {
+    enum class Kind { SPAWN, CLICK };
+
+    std::uint64_t frame;
+    Kind kind;
+    Vec2 position;  // SPAWN uses x only
+};
+
+struct ScenarioAim {
+    std::uint64_t first;
+    std::uint64_t last;
+    std::uint64_t every;
+};
+
+struct ScenarioBot {
+    BotSkill skill;
+    std::uint64_t first;
+    std::uint64_t last;
+};
+
+struct Scenario {
+    std::string name;  // File name without extension
+    std::uint64_t seed = 1;
+    std::uint64_t frames = 3600;
+    float timestep = 1.f / 60.f;
+    SimConfig config;
+    std::size_t particlePool = 200;
+    bool restartOnGameOver = true;
+    std::vector<ScenarioAction> actions;  // Sorted by frame
+    std::vector<ScenarioAim> aims;
+    std::vector<ScenarioBot> bots;
+
+    /**
+     * @brief Parse @p path; errors name the file and line
+     * @return false if the file is missing or has a bad line
+     */
+    static bool load(const std::string& path, Scenario& scenario);
+
+    /**
+     * @brief All *.scenario files in @p directory, sorted by name
+     */
+    static std::vector<std::string> list(const std::string& directory);
+};
+
+/**
+ * @brief Feeds a scenario to a HeadlessGame frame by frame
+ */
+class ScenarioPlayer {
+   private:
+    const Scenario& mScenario;
+    std::size_t mNextAction;
+    std::uint64_t mFrame;
+    Bot mBot;  // Skill comes from whichever bot range is active
+
+    bool aimAt(const Simulation& sim, SimInput& input) const;
+
+   public:
+    explicit ScenarioPlayer(const Scenario& scenario);
+
+    bool finished() const { return mFrame >= mScenario.frames; }
+    std::uint64_t getFrame() const { return mFrame; }
+
+    /**
+     * @brief Apply this frame's spawns and run it
+     */
+    void playFrame(HeadlessGame& game);
+};
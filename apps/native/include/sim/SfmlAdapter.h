@@ -0,0 +1,24 @@
+/**
+ * @file SfmlAdapter.h
+ * @brief Conversions between the core's math types and SFML's
+ *
+ * Only for code that already uses SFML; FallingFuryCore itself never
+ * includes this header.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+
+#include "sim/Vec2.h"
+
+inline sf::Vector2f toSfml(const Vec2& v) { return sf::Vector2f(v.x, v.y); }
+
+inline sf::FloatRect toSfml(const Rect& r) {
+    return sf::FloatRect(r.left, r.top, r.width, r.height);
+}
+
+inline sf::Color toSfml(const Rgba& c) { return sf::Color(c.r, c.g, c.b, c.a); }
+
+inline Vec2 toSim(const sf::Vector2f& v) { return Vec2(v.x, v.y); }
+
+inline Rgba toSim(const sf::Color& c) { return Rgba(c.r, c.g, c.b, c.a); }
@@ -0,0 +1,116 @@
+/**
+ * @file Simulation.h
+ * @brief The game rules, independent of any window
+ *
+ * Spawning, falling, clicking, health and points, stepped with a time
+ * delta and one frame of input. This is the boundary to the platform:
+ * whoever runs the simulation (the SFML game, the wasm build, benchmarks,
+ * a headless simulator) supplies a SimInput each step and reacts to the
+ * SimEvents it produces, e.g. with particles and sound. Nothing here
+ * draws, reads the mouse or touches files.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sim/Random.h"
+#include "sim/Vec2.h"
+
+/**
+ * @brief Tuning; fields are bound to cvars, so they may change mid-game
+ */
+struct SimConfig {
+    Vec2 worldSize = Vec2(1000.f, 700.f);
+    float gravity = 120.f;        // Pixels per second
+    float spawnInterval = 40.f;   // Frames between spawns
+    int maxEnemies = 30;
+    int startHealth = 10;
+    Vec2 enemySize = Vec2(50.f, 50.f);
+    float spawnY = 100.f;
+    int spawnWidth = 900;         // Enemies spawn at x in [0, spawnWidth)
+    bool autoSpawn = true;        // Off: only spawnAt() adds enemies
+};
+
+struct SimEnemy {
+    Rect bounds;
+    Rgba color;
+};
+
+/**
+ * @brief One frame of player input, in world coordinates
+ */
+struct SimInput {
+    Vec2 mouse;
+    bool mouseDown = false;
+    bool clickBlocked = false;  // The press landed on UI, not the world
+};
+
+enum class SimEventType {
+    HIT,        // An enemy was clicked
+    MISS,       // An enemy fell out of the world
+    GAME_OVER
+};
+
+struct SimEvent {
+    SimEventType type;
+    Vec2 position;
+    Rgba color;
+};
+
+class Simulation {
+   private:
+    SimConfig mConfig;
+    Random mRandom;
+
+    std::vector<SimEnemy> mEnemies;
+    std::vector<SimEvent> mEvents;  // From the last step()
+    float mSpawnTimer;
+    float mDistance;
+    unsigned mPoints;
+    int mHealth;
+    bool mMouseHeld;
+    bool mEndGame;
+    std::uint64_t mFrame;
+
+    void spawnEnemy();
+    void moveEnemies(float deltaTime);
+    void handleClick(const SimInput& input);
+
+   public:
+    explicit Simulation(const SimConfig& config = SimConfig(),
+                        std::uint64_t seed = 1);
+
+    /**
+     * @brief Start a new game; the random sequence carries on
+     */
+    void reset();
+
+    /**
+     * @brief Add an enemy now, outside the spawn timer (scripted spawns)
+     */
+    void spawnAt(float x);
+
+    /**
+     * @brief Advance one frame; does nothing once the game is over
+     */
+    void step(float deltaTime, const SimInput& input);
+
+    const std::vector<SimEvent>& getEvents() const { return mEvents; }
+    const std::vector<SimEnemy>& getEnemies() const { return mEnemies; }
+
+    /**
+     * @brief The enemy closest to falling out, or nullptr if there is none
+     */
+    const SimEnemy* findLowestEnemy() const;
+
+    SimConfig& getConfig() { return mConfig; }
+    const SimConfig& getConfig() const { return mConfig; }
+    Random& getRandom() { return mRandom; }
+
+    unsigned getPoints() const { return mPoints; }
+    int getHealth() const { return mHealth; }
+    bool isOver() const { return mEndGame; }
+    std::uint64_t getFrame() const { return mFrame; }
+};
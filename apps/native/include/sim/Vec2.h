@@ -0,0 +1,77 @@
+/**
+ * @file Vec2.h
+ * @brief Plain math types for the simulation core
+ *
+ * The core library does not depend on SFML, so it carries its own small
+ * vector, rectangle and colour types. sim/SfmlAdapter.h converts them for
+ * code that draws with SFML.
+ */
+
+#pragma once
+#include <cstdint>
+
+struct Vec2 {
+    float x = 0.f;
+    float y = 0.f;
+
+    constexpr Vec2() = default;
+    constexpr Vec2(float x, float y) : x(x), y(y) {}
+
+    constexpr Vec2 operator+(const Vec2& other) const {
+        return Vec2(x + other.x, y + other.y);
+    }
+    constexpr Vec2 operator-(const Vec2& other) const {
+        return Vec2(x - other.x, y - other.y);
+    }
+    constexpr Vec2 operator*(float factor) const {
+        return Vec2(x * factor, y * factor);
+    }
+    Vec2& operator+=(const Vec2& other) {
+        x += other.x;
+        y += other.y;
+        return *this;
+    }
+    constexpr bool operator==(const Vec2& other) const {
+        return x == other.x && y == other.y;
+    }
+    constexpr bool operator!=(const Vec2& other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Axis-aligned rectangle; contains() matches sf::FloatRect
+ */
+struct Rect {
+    float left = 0.f;
+    float top = 0.f;
+    float width = 0.f;
+    float height = 0.f;
+
+    constexpr Rect() = default;
+    constexpr Rect(float left, float top, float width, float height)
+        : left(left), top(top), width(width), height(height) {}
+    constexpr Rect(const Vec2& position, const Vec2& size)
+        : left(position.x), top(position.y), width(size.x), height(size.y) {}
+
+    constexpr bool contains(const Vec2& point) const {
+        return point.x >= left && point.x < left + width && point.y >= top &&
+               point.y < top + height;
+    }
+    constexpr Vec2 getPosition() const { return Vec2(left, top); }
+    constexpr Vec2 getCenter() const {
+        return Vec2(left + width / 2.f, top + height / 2.f);
+    }
+};
+
+struct Rgba {
+    std::uint8_t r = 0;
+    std::uint8_t g = 0;
+    std::uint8_t b = 0;
+    std::uint8_t a = 255;
+
+    constexpr Rgba() = default;
+    constexpr Rgba(std::uint8_t r, std::uint8_t g, std::uint8_t b,
+                   std::uint8_t a = 255)
+        : r(r), g(g), b(b), a(a) {}
+};
@@ -0,0 +1,150 @@
+/**
+ * @file AllocationCounter.h
+ * @brief Process-wide heap allocation counts
+ *
+ * The global operator new/delete are replaced (src/systems/
+ * AllocationCounter.cpp) to count every allocation, so benchmarks can
+ * report allocations per frame or per interaction, and soak runs can
+ * watch the number of live blocks. Counting is a relaxed atomic add per
+ * call.
+ *
+ * Each allocation is also charged to the calling thread's current tag,
+ * set with AllocationTagScope, so a frame's allocations can be split by
+ * subsystem:
+ *
+ *   AllocationTagScope tag(AllocationTag::HUD);
+ *   updateText();  // Anything allocated here counts against HUD
+ *
+ * Replacing new/delete costs every allocation in the process, so it is
+ * only built with FALLING_FURY_ALLOC_TRACKING (off for Release; always on
+ * for bench_falling_fury and perf_gate). Without it the counters below
+ * are inline stubs that always read 0.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Subsystem an allocation is charged to
+ */
+enum class AllocationTag : unsigned char {
+    UNTAGGED,
+    SIMULATION,
+    PARTICLES,
+    HUD,
+    UI,
+    AUDIO,
+    RESOURCES,
+    SCORES,
+    RENDER,
+    PROFILER,  // The allocation overlay itself
+    COUNT
+};
+
+constexpr std::size_t ALLOCATION_TAG_COUNT =
+    static_cast<std::size_t>(AllocationTag::COUNT);
+
+namespace AllocationCounter {
+
+#ifdef FALLING_FURY_ALLOC_TRACKING
+constexpr bool ENABLED = true;
+
+/**
+ * @brief Allocations since process start
+ */
+std::uint64_t count();
+
+/**
+ * @brief Bytes requested since process start (frees are not subtracted)
+ */
+std::uint64_t bytes();
+
+/**
+ * @brief Non-null deletes since process start
+ */
+std::uint64_t frees();
+
+/**
+ * @brief Blocks currently allocated; steady growth over a long run is a
+ * leak
+ */
+inline std::uint64_t live() { return count() - frees(); }
+
+/**
+ * @brief Allocations charged to @p tag since process start (all threads)
+ */
+std::uint64_t count(AllocationTag tag);
+
+/**
+ * @brief Bytes charged to @p tag since process start (all threads)
+ */
+std::uint64_t bytes(AllocationTag tag);
+
+/**
+ * @brief Tag new allocations on the calling thread are charged to
+ * @return The previous tag
+ */
+AllocationTag setTag(AllocationTag tag);
+#else
+constexpr bool ENABLED = false;
+
+inline std::uint64_t count() { return 0; }
+inline std::uint64_t bytes() { return 0; }
+inline std::uint64_t frees() { return 0; }
+inline std::uint64_t live() { return 0; }
+inline std::uint64_t count(AllocationTag) { return 0; }
+inline std::uint64_t bytes(AllocationTag) { return 0; }
+inline AllocationTag setTag(AllocationTag) { return AllocationTag::UNTAGGED; }
+#endif
+
+/**
+ * @brief Lower-case name for reports, e.g. "hud"
+ */
+inline const char* tagName(AllocationTag tag) {
+    static const char* const NAMES[ALLOCATION_TAG_COUNT] = {
+        "untagged", "simulation", "particles", "hud",    "ui",
+        "audio",    "resources",  "scores",    "render", "profiler"};
+    const std::size_t index = static_cast<std::size_t>(tag);
+    return index < ALLOCATION_TAG_COUNT ? NAMES[index] : "?";
+}
+
+}  // namespace AllocationCounter
+
+/**
+ * @brief Allocations made between construction and the call
+ */
+class AllocationScope {
+   private:
+    std::uint64_t mStartCount;
+    std::uint64_t mStartBytes;
+
+   public:
+    AllocationScope()
+        : mStartCount(AllocationCounter::count()),
+          mStartBytes(AllocationCounter::bytes()) {}
+
+    std::uint64_t allocations() const {
+        return AllocationCounter::count() - mStartCount;
+    }
+    std::uint64_t bytes() const {
+        return AllocationCounter::bytes() - mStartBytes;
+    }
+};
+
+/**
+ * @brief Charges the calling thread's allocations to a tag until the
+ * scope ends
+ */
+class AllocationTagScope {
+   private:
+    AllocationTag mPrevious;
+
+   public:
+    explicit AllocationTagScope(AllocationTag tag)
+        : mPrevious(AllocationCounter::setTag(tag)) {}
+    ~AllocationTagScope() { AllocationCounter::setTag(mPrevious); }
+
+    AllocationTagScope(const AllocationTagScope&) = delete;
+    AllocationTagScope& operator=(const AllocationTagScope&) = delete;
+};
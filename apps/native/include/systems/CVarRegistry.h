@@ -0,0 +1,160 @@
+/**
+ * @file CVarRegistry.h
+ * @brief Typed console variables bound to live game state
+ *
+ * A cvar wraps an existing variable (gravity, frame cap, ...) by
+ * reference, with a range for the console sliders and an optional hook
+ * for settings that must be pushed somewhere when they change (e.g. the
+ * window's frame limit). Values can be saved to and loaded from a plain
+ * "name value" profile so tuning survives restarts.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+enum class CVarType { FLOAT, INT, BOOL };
+
+/**
+ * @brief One registered variable
+ */
+struct CVar {
+    std::string name;
+    std::string description;
+    CVarType type;
+    float min;
+    float max;
+    std::function<float()> get;
+    std::function<void(float)> set;  // Clamps, then runs the change hook
+};
+
+class CVarRegistry {
+   private:
+    std::vector<CVar> mVars;
+
+    template <typename T>
+    void add(const std::string& name, const std::string& description,
+             CVarType type, T& value, float min, float max,
+             std::function<void()> onChange) {
+        CVar var;
+        var.name = name;
+        var.description = description;
+        var.type = type;
+        var.min = min;
+        var.max = max;
+        var.get = [&value] { return static_cast<float>(value); };
+        var.set = [&value, type, min, max, onChange](float raw) {
+            float clamped = std::max(min, std::min(max, raw));
+            if (type != CVarType::FLOAT) clamped = std::round(clamped);
+            const T next = static_cast<T>(clamped);
+            if (next == value) return;
+            value = next;
+            if (onChange) onChange();
+        };
+        mVars.push_back(std::move(var));
+    }
+
+   public:
+    /**
+     * @brief Register a float; @p value must outlive the registry
+     */
+    void registerFloat(const std::string& name, float& value, float min,
+                       float max, const std::string& description,
+                       std::function<void()> onChange = nullptr) {
+        add(name, description, CVarType::FLOAT, value, min, max, onChange);
+    }
+
+    template <typename Int>
+    void registerInt(const std::string& name, Int& value, Int min, Int max,
+                     const std::string& description,
+                     std::function<void()> onChange = nullptr) {
+        add(name, description, CVarType::INT, value, static_cast<float>(min),
+            static_cast<float>(max), onChange);
+    }
+
+    void registerBool(const std::string& name, bool& value,
+                      const std::string& description,
+                      std::function<void()> onChange = nullptr) {
+        add(name, description, CVarType::BOOL, value, 0.f, 1.f, onChange);
+    }
+
+    CVar* find(const std::string& name) {
+        for (CVar& var : mVars) {
+            if (var.name == name) return &var;
+        }
+        return nullptr;
+    }
+
+    std::vector<CVar>& getAll() { return mVars; }
+    const std::vector<CVar>& getAll() const { return mVars; }
+
+    /**
+     * @brief Format a value the way the profile and console show it
+     */
+    static std::string format(const CVar& var) {
+        std::ostringstream out;
+        switch (var.type) {
+            case CVarType::BOOL:
+                out << (var.get() != 0.f ? "1" : "0");
+                break;
+            case CVarType::INT:
+                out << static_cast<long long>(var.get());
+                break;
+            case CVarType::FLOAT:
+                out << var.get();
+                break;
+        }
+        return out.str();
+    }
+
+    /**
+     * @brief Apply a saved profile; unknown names are reported and skipped
+     * @return false if the file could not be opened
+     */
+    bool loadProfile(const std::string& filepath) {
+        std::ifstream file(filepath);
+        if (!file.is_open()) return false;
+
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream fields(line);
+            std::string name;
+            float value;
+            if (!(fields >> name >> value)) {
+                std::cerr << "ERROR::CVARS::Bad profile line: " << line
+                          << "\n";
+                continue;
+            }
+            if (CVar* var = find(name)) {
+                var->set(value);
+            } else {
+                std::cerr << "ERROR::CVARS::Unknown cvar in profile: "
+                          << name << "\n";
+            }
+        }
+        std::cout << "Loaded profile: " << filepath << "\n";
+        return true;
+    }
+
+    bool saveProfile(const std::string& filepath) const {
+        std::ofstream file(filepath);
+        if (!file.is_open()) {
+            std::cerr << "ERROR::CVARS::Cannot write profile: " << filepath
+                      << "\n";
+            return false;
+        }
+        for (const CVar& var : mVars) {
+            file << "# " << var.description << "\n"
+                 << var.name << " " << format(var) << "\n";
+        }
+        std::cout << "Saved profile: " << filepath << "\n";
+        return true;
+    }
+};
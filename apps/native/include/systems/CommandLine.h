@@ -0,0 +1,103 @@
+/**
+ * @file CommandLine.h
+ * @brief "--name value" options for the headless tools
+ *
+ * Each option is bound to the variable it sets:
+ *
+ *   CommandLine options;
+ *   options.add("--seed", seed).add("--csv", csvPath);
+ *   if (!options.parse(argc, argv)) return usage(argv[0]);
+ *
+ * Anything else on the command line, a missing value or a value that is
+ * not a number where one is expected fails parse(), so a typo cannot
+ * quietly run with the defaults.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+class CommandLine {
+   private:
+    enum class Type { UNSIGNED, UINT64, STRING };
+
+    struct Option {
+        const char* name;
+        Type type;
+        void* target;
+    };
+
+    std::vector<Option> mOptions;
+
+    /**
+     * @brief Whole of @p text as a decimal number no larger than @p max
+     */
+    static bool toNumber(const char* text, std::uint64_t max,
+                         std::uint64_t& value) {
+        if (*text < '0' || *text > '9') return false;  // Also rejects "-1"
+        char* end = nullptr;
+        const unsigned long long parsed = std::strtoull(text, &end, 10);
+        if (*end != '\0' || parsed > max) return false;
+        value = parsed;
+        return true;
+    }
+
+    static bool set(const Option& option, const char* text) {
+        std::uint64_t value = 0;
+        switch (option.type) {
+            case Type::UNSIGNED:
+                if (!toNumber(text, std::numeric_limits<unsigned>::max(),
+                              value)) {
+                    return false;
+                }
+                *static_cast<unsigned*>(option.target) =
+                    static_cast<unsigned>(value);
+                return true;
+            case Type::UINT64:
+                if (!toNumber(text, std::numeric_limits<std::uint64_t>::max(),
+                              value)) {
+                    return false;
+                }
+                *static_cast<std::uint64_t*>(option.target) = value;
+                return true;
+            default:
+                *static_cast<std::string*>(option.target) = text;
+                return true;
+        }
+    }
+
+   public:
+    CommandLine& add(const char* name, unsigned& target) {
+        mOptions.push_back({name, Type::UNSIGNED, &target});
+        return *this;
+    }
+    CommandLine& add(const char* name, std::uint64_t& target) {
+        mOptions.push_back({name, Type::UINT64, &target});
+        return *this;
+    }
+    CommandLine& add(const char* name, std::string& target) {
+        mOptions.push_back({name, Type::STRING, &target});
+        return *this;
+    }
+
+    /**
+     * @brief Set the bound variables from @p argv
+     * @return false on an unknown argument or a missing or bad value
+     */
+    bool parse(int argc, char** argv) const {
+        for (int i = 1; i < argc; ++i) {
+            const Option* match = nullptr;
+            for (const Option& option : mOptions) {
+                if (std::strcmp(argv[i], option.name) == 0) match = &option;
+            }
+            if (!match || i + 1 >= argc || !set(*match, argv[++i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
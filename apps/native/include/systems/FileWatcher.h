@@ -0,0 +1,132 @@
+/**
+ * @file FileWatcher.h
+ * @brief Non-blocking directory watcher (inotify on Linux)
+ *
+ * Reports files that finished being written or were renamed into place,
+ * which covers both editors that write in place and ones that save to a
+ * temporary file and rename it. On other platforms watch() fails and
+ * poll() never reports anything.
+ */
+
+#pragma once
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class FileWatcher {
+   private:
+    int mFd;
+    std::unordered_map<int, std::string> mDirectories;  // watch -> path
+
+#ifdef __linux__
+    bool addDirectory(const std::string& path) {
+        const int watch = inotify_add_watch(
+            mFd, path.c_str(),
+            IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+        if (watch < 0) {
+            std::cerr << "ERROR::FILEWATCHER::Cannot watch: " << path << "\n";
+            return false;
+        }
+        mDirectories[watch] = path;
+
+        // inotify is not recursive, so watch subdirectories explicitly
+        if (DIR* dir = opendir(path.c_str())) {
+            while (dirent* entry = readdir(dir)) {
+                const std::string name = entry->d_name;
+                if (name == "." || name == "..") continue;
+                const std::string child = path + "/" + name;
+                struct stat info;
+                if (stat(child.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+                    addDirectory(child);
+                }
+            }
+            closedir(dir);
+        }
+        return true;
+    }
+#endif
+
+   public:
+    FileWatcher() : mFd(-1) {
+#ifdef __linux__
+        mFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (mFd < 0) {
+            std::cerr << "ERROR::FILEWATCHER::inotify unavailable\n";
+        }
+#endif
+    }
+
+    ~FileWatcher() {
+#ifdef __linux__
+        if (mFd >= 0) close(mFd);
+#endif
+    }
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /**
+     * @brief Watch a directory and everything below it
+     * @return false if watching is unsupported or the path is invalid
+     */
+    bool watch(const std::string& directory) {
+#ifdef __linux__
+        if (mFd < 0) return false;
+        return addDirectory(directory);
+#else
+        (void)directory;
+        return false;
+#endif
+    }
+
+    bool isWatching() const { return !mDirectories.empty(); }
+
+    /**
+     * @brief Drain pending events without blocking
+     * @return Paths of files changed since the last call, each listed once
+     */
+    std::vector<std::string> poll() {
+        std::vector<std::string> changed;
+#ifdef __linux__
+        if (mFd < 0) return changed;
+
+        alignas(inotify_event) char buffer[4096];
+        for (;;) {
+            const ssize_t length = read(mFd, buffer, sizeof(buffer));
+            if (length <= 0) break;  // EAGAIN: nothing more queued
+
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event =
+                    reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event)) +
+                          event->len;
+
+                auto dir = mDirectories.find(event->wd);
+                if (dir == mDirectories.end() || event->len == 0) continue;
+                const std::string path = dir->second + "/" + event->name;
+
+                if (event->mask & IN_ISDIR) {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                        addDirectory(path);
+                    }
+                } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                    if (std::find(changed.begin(), changed.end(), path) ==
+                        changed.end()) {
+                        changed.push_back(path);
+                    }
+                }
+            }
+        }
+#endif
+        return changed;
+    }
+};
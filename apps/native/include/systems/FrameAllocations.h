@@ -0,0 +1,113 @@
+/**
+ * @file FrameAllocations.h
+ * @brief Per-frame heap allocation profile and zero-allocation assert mode
+ *
+ * The game brackets each frame with beginFrame() and endFrame(); what was
+ * allocated in between is kept per AllocationTag for the overlay
+ * (show_allocs). With assert mode on (alloc_assert), a steady gameplay
+ * frame that allocates is reported by tag and aborts, so a regression is
+ * caught on the frame that introduced it. A frame is steady when the
+ * caller says so (playing, console closed) and the WARMUP_FRAMES before
+ * it were steady too: the first frames of a game may still grow vectors
+ * to their working size. The PROFILER tag is never charged to a frame.
+ */
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "systems/AllocationCounter.h"
+
+struct FrameAllocationStats {
+    std::uint64_t allocations = 0;  // Excluding the PROFILER tag
+    std::uint64_t bytes = 0;
+    std::array<std::uint64_t, ALLOCATION_TAG_COUNT> byTag{};
+};
+
+class FrameAllocationMonitor {
+   public:
+    static constexpr unsigned WARMUP_FRAMES = 120;
+
+   private:
+    std::array<std::uint64_t, ALLOCATION_TAG_COUNT> mStartCounts{};
+    std::array<std::uint64_t, ALLOCATION_TAG_COUNT> mStartBytes{};
+    FrameAllocationStats mLast;
+    std::uint64_t mFrame;
+    unsigned mSteadyFrames;  // Consecutive, up to and including this one
+    bool mAssert;
+
+   public:
+    FrameAllocationMonitor() : mFrame(0), mSteadyFrames(0), mAssert(false) {}
+
+    void setAssert(bool enabled) { mAssert = enabled; }
+    bool getAssert() const { return mAssert; }
+
+    void beginFrame() {
+        for (std::size_t i = 0; i < ALLOCATION_TAG_COUNT; ++i) {
+            const AllocationTag tag = static_cast<AllocationTag>(i);
+            mStartCounts[i] = AllocationCounter::count(tag);
+            mStartBytes[i] = AllocationCounter::bytes(tag);
+        }
+    }
+
+    /**
+     * @param steady Nothing this frame was allowed to allocate
+     * @return Whether a steady frame allocated (aborts in assert mode)
+     */
+    bool endFrame(bool steady) {
+        ++mFrame;
+        mLast = FrameAllocationStats();
+        for (std::size_t i = 0; i < ALLOCATION_TAG_COUNT; ++i) {
+            const AllocationTag tag = static_cast<AllocationTag>(i);
+            mLast.byTag[i] = AllocationCounter::count(tag) - mStartCounts[i];
+            if (tag == AllocationTag::PROFILER) continue;
+            mLast.allocations += mLast.byTag[i];
+            mLast.bytes += AllocationCounter::bytes(tag) - mStartBytes[i];
+        }
+
+        mSteadyFrames = steady ? mSteadyFrames + 1 : 0;
+        const bool violation =
+            mSteadyFrames > WARMUP_FRAMES && mLast.allocations > 0;
+        if (violation && mAssert) {
+            char report[256];
+            format(report, sizeof(report));
+            std::fprintf(stderr,
+                         "ERROR::ALLOCATION::Steady frame %llu allocated: %s\n",
+                         static_cast<unsigned long long>(mFrame), report);
+            std::abort();
+        }
+        return violation;
+    }
+
+    const FrameAllocationStats& getLast() const { return mLast; }
+
+    /**
+     * @brief Last frame as "3 allocs, 96 B: hud 2, ui 1", without
+     * allocating
+     */
+    void format(char* buffer, std::size_t size) const {
+        if (!AllocationCounter::ENABLED) {
+            std::snprintf(buffer, size,
+                          "allocation tracking off "
+                          "(build with FALLING_FURY_ALLOC_TRACKING)");
+            return;
+        }
+        int written = std::snprintf(
+            buffer, size, "%llu allocs, %llu B",
+            static_cast<unsigned long long>(mLast.allocations),
+            static_cast<unsigned long long>(mLast.bytes));
+        const char* separator = ": ";
+        for (std::size_t i = 0; i < ALLOCATION_TAG_COUNT; ++i) {
+            const AllocationTag tag = static_cast<AllocationTag>(i);
+            if (tag == AllocationTag::PROFILER || mLast.byTag[i] == 0) continue;
+            if (written < 0 || static_cast<std::size_t>(written) >= size) return;
+            written += std::snprintf(
+                buffer + written, size - written, "%s%s %llu", separator,
+                AllocationCounter::tagName(tag),
+                static_cast<unsigned long long>(mLast.byTag[i]));
+            separator = ", ";
+        }
+    }
+};
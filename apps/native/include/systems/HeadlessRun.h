@@ -0,0 +1,101 @@
+/**
+ * @file HeadlessRun.h
+ * @brief Plumbing shared by the windowless tools (--soak, --pgo-train,
+ * bench_falling_fury)
+ *
+ * Each runs the game's managers without a window: their console logging
+ * is swallowed, score files go to a scratch directory rather than the
+ * player's data/, and game overs are scored the way the game does it.
+ */
+
+#pragma once
+#include <filesystem>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <system_error>
+
+#include "managers/ScoreManager.h"
+
+namespace HeadlessRun {
+
+/**
+ * @brief Swallows the managers' console logging without buffering it
+ */
+class NullBuffer : public std::streambuf {
+   protected:
+    int overflow(int c) override { return c; }
+};
+
+/**
+ * @brief Works in an empty directory under the system temp directory
+ * until destroyed, then returns to where the process was
+ *
+ * Emptied on entry, so a score file left by the previous run cannot
+ * change what this one does.
+ */
+class ScratchDirectory {
+   private:
+    std::filesystem::path mPath;
+    std::filesystem::path mPrevious;
+    bool mEntered;
+
+   public:
+    /**
+     * @param name Directory name under the temp directory
+     * @param owner Error tag, e.g. "SOAK"
+     */
+    ScratchDirectory(const std::string& name, const char* owner)
+        : mEntered(false) {
+        std::error_code error;
+        mPath = std::filesystem::temp_directory_path(error) / name;
+        if (!error) std::filesystem::remove_all(mPath, error);
+        if (!error) std::filesystem::create_directories(mPath / "data", error);
+        if (!error) mPrevious = std::filesystem::current_path(error);
+        if (!error) std::filesystem::current_path(mPath, error);
+        if (error) {
+            std::cerr << "ERROR::" << owner
+                      << "::Cannot use scratch directory " << mPath << ": "
+                      << error.message() << "\n";
+            return;
+        }
+        mEntered = true;
+    }
+
+    ~ScratchDirectory() {
+        if (!mEntered) return;
+        std::error_code error;
+        std::filesystem::current_path(mPrevious, error);
+    }
+
+    ScratchDirectory(const ScratchDirectory&) = delete;
+    ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+    bool isEntered() const { return mEntered; }
+};
+
+/**
+ * @brief Game over as Game handles it: save the high score, enter the
+ * leaderboard if it qualifies, start the next score from zero
+ * @return Whether a leaderboard entry was added
+ */
+inline bool gameOver(ScoreManager& scores, const std::string& player) {
+    scores.saveHighScore();
+    const bool qualifies = scores.qualifiesForLeaderboard();
+    if (qualifies) {
+        scores.addToLeaderboard(player, scores.getCurrentScore(),
+                                "2024-01-01");
+    }
+    scores.resetScore();
+    return qualifies;
+}
+
+/**
+ * @brief Build the text the HUD would show this frame
+ */
+inline void formatHud(const ScoreManager& scores) {
+    std::string combo = scores.getComboString();
+    (void)combo;
+}
+
+}  // namespace HeadlessRun
@@ -0,0 +1,72 @@
+/**
+ * @file HotReloader.h
+ * @brief Development-build asset reloading
+ *
+ * Watches the source assets directory and, when a file listed in
+ * assets.manifest changes, asks ResourceManager to re-decode it. Call
+ * update() once per frame before anything draws; decoding happens in the
+ * background and only the pointer swap runs on the game thread.
+ */
+
+#pragma once
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "managers/AssetManifest.h"
+#include "managers/ResourceManager.h"
+#include "systems/FileWatcher.h"
+
+class HotReloader {
+   private:
+    FileWatcher mWatcher;
+    std::vector<ManifestItem> mItems;
+    std::string mAssetsDir;
+
+    static std::string normalize(const std::string& path) {
+        std::string result;
+        for (char c : path) {
+            // Collapse "//" so manifest and inotify paths compare equal
+            if (c == '/' && !result.empty() && result.back() == '/') continue;
+            result += c;
+        }
+        return result;
+    }
+
+   public:
+    /**
+     * @param assetsDir Directory holding assets.manifest
+     */
+    explicit HotReloader(const std::string& assetsDir)
+        : mAssetsDir(normalize(assetsDir)) {
+        if (!AssetManifest::read(mAssetsDir + "/assets.manifest", mItems)) {
+            return;
+        }
+        for (ManifestItem& item : mItems) {
+            item.path = normalize(item.path);
+        }
+        if (mWatcher.watch(mAssetsDir)) {
+            std::cout << "Hot reload watching: " << mAssetsDir << "\n";
+        }
+    }
+
+    bool isActive() const { return mWatcher.isWatching(); }
+
+    /**
+     * @brief Queue reloads for changed files and swap in finished ones
+     * @return Number of resources swapped this frame
+     */
+    std::size_t update() {
+        ResourceManager& resources = ResourceManager::getInstance();
+
+        for (const std::string& changed : mWatcher.poll()) {
+            const std::string path = normalize(changed);
+            for (const ManifestItem& item : mItems) {
+                if (item.path == path) {
+                    resources.requestReload(item.kind, item.name, item.path);
+                }
+            }
+        }
+        return resources.applyReloads();
+    }
+};
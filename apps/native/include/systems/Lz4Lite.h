@@ -0,0 +1,180 @@
+/**
+ * @file Lz4Lite.h
+ * @brief Minimal LZ4 block-format codec
+ *
+ * Produces and consumes standard LZ4 blocks (no frame header), which is all
+ * the asset pack needs. The compressor is a single-pass greedy hash matcher:
+ * slower ratio than reference LZ4 HC but the decoder is what matters at
+ * startup, and that is a tight copy loop.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace Lz4Lite {
+
+namespace detail {
+const std::size_t MIN_MATCH = 4;
+const std::size_t LAST_LITERALS = 5;  // Block must end with literals
+const std::size_t MF_LIMIT = 12;      // No match may start past end - 12
+const std::size_t MAX_OFFSET = 65535;
+const int HASH_BITS = 16;
+
+inline std::uint32_t read32(const std::uint8_t* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline std::uint32_t hash(std::uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_BITS);
+}
+
+inline void writeLength(std::vector<std::uint8_t>& out, std::size_t length) {
+    while (length >= 255) {
+        out.push_back(255);
+        length -= 255;
+    }
+    out.push_back(static_cast<std::uint8_t>(length));
+}
+}  // namespace detail
+
+/**
+ * @brief Worst-case compressed size for an input of the given length
+ */
+inline std::size_t maxCompressedSize(std::size_t inputSize) {
+    return inputSize + inputSize / 255 + 16;
+}
+
+/**
+ * @brief Compress a buffer into an LZ4 block
+ */
+inline std::vector<std::uint8_t> compress(const std::uint8_t* input,
+                                          std::size_t size) {
+    using namespace detail;
+
+    std::vector<std::uint8_t> out;
+    out.reserve(maxCompressedSize(size));
+    std::vector<std::uint32_t> table(std::size_t(1) << HASH_BITS, 0);
+
+    std::size_t anchor = 0;
+    std::size_t pos = 0;
+    const std::size_t matchLimit = size > MF_LIMIT ? size - MF_LIMIT : 0;
+
+    while (pos < matchLimit) {
+        const std::uint32_t sequence = read32(input + pos);
+        const std::uint32_t h = hash(sequence);
+        const std::size_t candidate = table[h];
+        table[h] = static_cast<std::uint32_t>(pos);
+
+        if (candidate >= pos || pos - candidate > MAX_OFFSET ||
+            read32(input + candidate) != sequence) {
+            ++pos;
+            continue;
+        }
+
+        // Extend the match, keeping LAST_LITERALS bytes for the tail
+        std::size_t matchLength = MIN_MATCH;
+        const std::size_t maxLength = size - LAST_LITERALS - pos;
+        while (matchLength < maxLength &&
+               input[candidate + matchLength] == input[pos + matchLength]) {
+            ++matchLength;
+        }
+
+        const std::size_t literalLength = pos - anchor;
+        const std::size_t extraMatch = matchLength - MIN_MATCH;
+        std::uint8_t token =
+            static_cast<std::uint8_t>((literalLength < 15 ? literalLength : 15)
+                                      << 4) |
+            static_cast<std::uint8_t>(extraMatch < 15 ? extraMatch : 15);
+        out.push_back(token);
+        if (literalLength >= 15) writeLength(out, literalLength - 15);
+        out.insert(out.end(), input + anchor, input + pos);
+
+        const std::size_t offset = pos - candidate;
+        out.push_back(static_cast<std::uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<std::uint8_t>(offset >> 8));
+        if (extraMatch >= 15) writeLength(out, extraMatch - 15);
+
+        pos += matchLength;
+        anchor = pos;
+    }
+
+    // Final literal-only sequence
+    const std::size_t literalLength = size - anchor;
+    out.push_back(static_cast<std::uint8_t>(
+        (literalLength < 15 ? literalLength : 15) << 4));
+    if (literalLength >= 15) writeLength(out, literalLength - 15);
+    out.insert(out.end(), input + anchor, input + size);
+
+    return out;
+}
+
+/**
+ * @brief Decompress an LZ4 block
+ * @param input Compressed block
+ * @param inputSize Size of the compressed block
+ * @param output Destination, exactly outputSize bytes
+ * @param outputSize Expected decompressed size
+ * @return true if the block decoded to exactly outputSize bytes
+ */
+inline bool decompress(const std::uint8_t* input, std::size_t inputSize,
+                       std::uint8_t* output, std::size_t outputSize) {
+    const std::uint8_t* ip = input;
+    const std::uint8_t* const inEnd = input + inputSize;
+    std::uint8_t* op = output;
+    std::uint8_t* const outEnd = output + outputSize;
+
+    auto readLength = [&](std::size_t length) -> std::size_t {
+        if (length != 15) return length;
+        std::uint8_t byte;
+        do {
+            if (ip >= inEnd) return SIZE_MAX;
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return length;
+    };
+
+    while (ip < inEnd) {
+        const std::uint8_t token = *ip++;
+
+        std::size_t literalLength = readLength(token >> 4);
+        if (literalLength == SIZE_MAX ||
+            literalLength > static_cast<std::size_t>(inEnd - ip) ||
+            literalLength > static_cast<std::size_t>(outEnd - op)) {
+            return false;
+        }
+        std::memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        if (ip >= inEnd) break;  // Last sequence has no match
+
+        if (inEnd - ip < 2) return false;
+        const std::size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<std::size_t>(op - output)) {
+            return false;
+        }
+
+        std::size_t matchLength = readLength(token & 0x0F);
+        if (matchLength == SIZE_MAX) return false;
+        matchLength += detail::MIN_MATCH;
+        if (matchLength > static_cast<std::size_t>(outEnd - op)) return false;
+
+        // Byte copy: source and destination may overlap for short offsets
+        const std::uint8_t* match = op - offset;
+        for (std::size_t i = 0; i < matchLength; ++i) {
+            op[i] = match[i];
+        }
+        op += matchLength;
+    }
+
+    return op == outEnd;
+}
+
+}  // namespace Lz4Lite
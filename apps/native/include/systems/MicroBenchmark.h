@@ -0,0 +1,182 @@
+/**
+ * @file MicroBenchmark.h
+ * @brief Small timing harness for headless micro-benchmarks
+ *
+ * Each case is a function that runs its operation @c iterations times.
+ * The harness doubles the iteration count until one repetition takes at
+ * least Options::minRepetitionMs, runs a few warmup repetitions, then
+ * times Options::repetitions more. Reported per case: median and median
+ * absolute deviation (MAD) of the time per operation, the fastest
+ * repetition, and heap allocations per operation. Median and MAD are
+ * used because a single preempted repetition should not move the result.
+ *
+ *   MicroBenchmark::Suite suite(options);
+ *   suite.run("pool/acquire_release", [&](std::uint64_t iterations) {
+ *       for (std::uint64_t i = 0; i < iterations; ++i) ...
+ *   });
+ *   suite.writeJson(std::cout);
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "systems/AllocationCounter.h"
+
+namespace MicroBenchmark {
+
+/**
+ * @brief Keep the optimizer from dropping a computed value
+ */
+template <typename T>
+inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+struct Options {
+    unsigned warmup = 3;
+    unsigned repetitions = 15;
+    double minRepetitionMs = 20.0;
+    std::string filter;  // Run only cases whose name contains this
+    std::string label;   // Free text copied to the JSON, e.g. a commit
+};
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations = 0;  // Per repetition
+    std::vector<double> nsPerOp;   // One sample per repetition
+    double medianNs = 0.0;
+    double madNs = 0.0;
+    double minNs = 0.0;
+    double allocationsPerOp = 0.0;
+};
+
+inline double median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const std::size_t half = values.size() / 2;
+    return values.size() % 2 ? values[half]
+                             : (values[half - 1] + values[half]) / 2.0;
+}
+
+class Suite {
+   public:
+    using Body = std::function<void(std::uint64_t iterations)>;
+
+   private:
+    Options mOptions;
+    std::vector<Result> mResults;
+
+    static double timeNs(const Body& body, std::uint64_t iterations) {
+        const auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        return std::chrono::duration<double, std::nano>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+   public:
+    explicit Suite(const Options& options) : mOptions(options) {}
+
+    /**
+     * @brief Time one case; skipped if it does not match the filter
+     */
+    void run(const std::string& name, const Body& body) {
+        if (!mOptions.filter.empty() &&
+            name.find(mOptions.filter) == std::string::npos) {
+            return;
+        }
+
+        // Calibrate: the first passes double as warmup for cold caches
+        const double minNs = mOptions.minRepetitionMs * 1e6;
+        std::uint64_t iterations = 1;
+        while (timeNs(body, iterations) < minNs &&
+               iterations < (std::uint64_t(1) << 40)) {
+            iterations *= 2;
+        }
+        for (unsigned i = 0; i < mOptions.warmup; ++i) timeNs(body, iterations);
+
+        Result result;
+        result.name = name;
+        result.iterations = iterations;
+        result.nsPerOp.reserve(mOptions.repetitions);
+        AllocationScope allocations;
+        for (unsigned i = 0; i < mOptions.repetitions; ++i) {
+            result.nsPerOp.push_back(timeNs(body, iterations) / iterations);
+        }
+        result.allocationsPerOp =
+            static_cast<double>(allocations.allocations()) /
+            (static_cast<double>(iterations) *
+             std::max(mOptions.repetitions, 1u));
+
+        result.medianNs = median(result.nsPerOp);
+        std::vector<double> deviations;
+        for (double sample : result.nsPerOp) {
+            deviations.push_back(sample > result.medianNs
+                                     ? sample - result.medianNs
+                                     : result.medianNs - sample);
+        }
+        result.madNs = median(deviations);
+        result.minNs = result.nsPerOp.empty()
+                           ? 0.0
+                           : *std::min_element(result.nsPerOp.begin(),
+                                               result.nsPerOp.end());
+
+        std::printf("%-40s %12.1f ns  +- %8.1f  min %12.1f  allocs %7.2f\n",
+                    name.c_str(), result.medianNs, result.madNs, result.minNs,
+                    result.allocationsPerOp);
+        std::fflush(stdout);
+        mResults.push_back(std::move(result));
+    }
+
+    const std::vector<Result>& getResults() const { return mResults; }
+
+    static void writeString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+        out << '"';
+    }
+
+    /**
+     * @brief All results as one JSON object, for diffing between commits
+     */
+    void writeJson(std::ostream& out) const {
+        out << "{\n  \"label\": ";
+        writeString(out, mOptions.label);
+        out << ",\n  \"warmup\": " << mOptions.warmup
+            << ",\n  \"repetitions\": " << mOptions.repetitions
+            << ",\n  \"results\": [";
+        for (std::size_t i = 0; i < mResults.size(); ++i) {
+            const Result& result = mResults[i];
+            out << (i ? ",\n" : "\n") << "    {\"name\": ";
+            writeString(out, result.name);
+            out << ", \"iterations\": " << result.iterations
+                << ", \"median_ns\": " << result.medianNs
+                << ", \"mad_ns\": " << result.madNs
+                << ", \"min_ns\": " << result.minNs
+                << ", \"allocs_per_op\": " << result.allocationsPerOp
+                << ", \"samples_ns\": [";
+            for (std::size_t s = 0; s < result.nsPerOp.size(); ++s) {
+                out << (s ? ", " : "") << result.nsPerOp[s];
+            }
+            out << "]}";
+        }
+        out << "\n  ]\n}\n";
+    }
+};
+
+}  // namespace MicroBenchmark
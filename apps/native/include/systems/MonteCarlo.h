@@ -0,0 +1,368 @@
+/**
+ * @file MonteCarlo.h
+ * @brief Headless balancing: many bot games per parameter set, in parallel
+ *
+ *   FallingFury --simulate N [--seed S] [--threads T] [--csv PATH]
+ *                            [--optimize ROUNDS]
+ *
+ * Plays N games of the core rules per parameter set, each with a Bot
+ * whose skill cycles novice, casual, expert, on T worker threads (default:
+ * every core). Games stop at MAX_GAME_SECONDS of game time; the survivors
+ * are marked as capped. One CSV row per game records the parameters, the
+ * skill, survival time, score and click rate; stdout gets the
+ * distribution per set and skill.
+ *
+ * With --optimize, a random search tunes spawn interval, gravity and
+ * max_enemies (the core has one enemy type, so how many may be alive at
+ * once stands in for the enemy mix) toward TARGET_SURVIVAL: typical
+ * survival per skill. The first round samples the whole parameter box,
+ * since sets where every bot survives to the cap all score the same;
+ * later rounds perturb the best set so far in log space, with a radius
+ * that shrinks when a round finds nothing better.
+ * Every candidate plays the same seeds (common random numbers), so two
+ * sets differ by their parameters, not by their luck.
+ *
+ * Game i of a set always gets the same seeds, whatever the thread count,
+ * so a run is reproducible from --seed alone.
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sim/Bot.h"
+#include "sim/Random.h"
+#include "sim/Simulation.h"
+#include "systems/CommandLine.h"
+#include "systems/PerfStats.h"
+#include "systems/ThreadPool.h"
+
+namespace MonteCarlo {
+
+constexpr const char* FLAG = "--simulate";
+constexpr float TIMESTEP = 1.f / 60.f;
+constexpr float MAX_GAME_SECONDS = 600.f;
+constexpr unsigned SKILL_COUNT = BotSkill::LEVEL_COUNT;
+// Difficulty curve the optimizer aims for: geometric mean seconds survived
+constexpr double TARGET_SURVIVAL[SKILL_COUNT] = {45.0, 120.0, 300.0};
+constexpr unsigned CANDIDATES_PER_ROUND = 8;
+// The first round covers the whole box; most of it is the flat "nobody
+// dies" plateau, so it needs more samples to land near the valley
+constexpr unsigned BOX_CANDIDATES = 32;
+
+struct Options {
+    unsigned games = 1000;  // Per parameter set
+    std::uint64_t seed = 1;
+    unsigned threads = 0;   // 0: one per core
+    std::string csvPath = "simulation.csv";
+    unsigned optimizeRounds = 0;
+};
+
+struct ParameterSet {
+    float spawnInterval;
+    float gravity;
+    int maxEnemies;
+
+    static ParameterSet defaults() {
+        const SimConfig config;
+        return {config.spawnInterval, config.gravity, config.maxEnemies};
+    }
+
+    void apply(SimConfig& config) const {
+        config.spawnInterval = spawnInterval;
+        config.gravity = gravity;
+        config.maxEnemies = maxEnemies;
+    }
+};
+
+struct GameResult {
+    float survivalSeconds = 0.f;
+    unsigned score = 0;
+    float clicksPerSecond = 0.f;
+    bool capped = false;  // Still alive at MAX_GAME_SECONDS
+};
+
+/**
+ * @brief splitmix64, to derive independent seeds from (seed, game)
+ */
+inline std::uint64_t mix(std::uint64_t value) {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+inline GameResult playGame(const ParameterSet& parameters, unsigned game,
+                           std::uint64_t seed) {
+    SimConfig config;
+    parameters.apply(config);
+    const std::uint64_t gameSeed = mix(seed ^ mix(game));
+    Simulation sim(config, gameSeed);
+    Bot bot(BotSkill::level(game), mix(gameSeed));
+
+    const std::uint64_t maxFrames =
+        static_cast<std::uint64_t>(MAX_GAME_SECONDS / TIMESTEP);
+    std::uint64_t frame = 0;
+    while (!sim.isOver() && frame < maxFrames) {
+        sim.step(TIMESTEP, bot.think(sim, TIMESTEP));
+        ++frame;
+    }
+
+    GameResult result;
+    result.survivalSeconds = frame * TIMESTEP;
+    result.score = sim.getPoints();
+    result.clicksPerSecond =
+        frame ? static_cast<float>(bot.getClicks()) / result.survivalSeconds
+              : 0.f;
+    result.capped = !sim.isOver();
+    return result;
+}
+
+/**
+ * @brief All games of one set; game i lands in slot i
+ */
+inline std::vector<GameResult> playSet(ThreadPool& pool,
+                                       const ParameterSet& parameters,
+                                       const Options& options) {
+    std::vector<GameResult> results(options.games);
+    std::atomic<unsigned> next{0};
+    auto worker = [&] {
+        for (unsigned game = next++; game < options.games; game = next++) {
+            results[game] = playGame(parameters, game, options.seed);
+        }
+    };
+
+    std::vector<std::future<void>> running;
+    for (std::size_t i = 0; i < std::max<std::size_t>(pool.getThreadCount(), 1);
+         ++i) {
+        running.push_back(pool.submit(worker));
+    }
+    for (std::future<void>& done : running) done.get();
+    return results;
+}
+
+inline std::vector<double> survivalOf(const std::vector<GameResult>& results,
+                                      unsigned skill) {
+    std::vector<double> values;
+    for (std::size_t i = skill; i < results.size(); i += SKILL_COUNT) {
+        values.push_back(results[i].survivalSeconds);
+    }
+    return values;
+}
+
+/**
+ * @brief Distance from TARGET_SURVIVAL: per skill, the mean log ratio of
+ * survival to target, squared, then summed
+ *
+ * Hits heal, so a bot tends to either keep up for good or die within
+ * seconds; a median jumps across that cliff, while the mean of logs moves
+ * with the share of games that die and gives the search a slope.
+ */
+inline double objective(const std::vector<GameResult>& results) {
+    double total = 0.0;
+    for (unsigned skill = 0; skill < SKILL_COUNT; ++skill) {
+        double sum = 0.0;
+        unsigned count = 0;
+        for (std::size_t i = skill; i < results.size(); i += SKILL_COUNT) {
+            const double seconds =
+                std::max<double>(results[i].survivalSeconds, 1e-3);
+            sum += std::log(seconds / TARGET_SURVIVAL[skill]);
+            ++count;
+        }
+        const double error = count ? sum / count : 0.0;
+        total += error * error;
+    }
+    return total;
+}
+
+inline void writeRows(std::ofstream& csv, unsigned set,
+                      const ParameterSet& parameters,
+                      const std::vector<GameResult>& results) {
+    for (std::size_t game = 0; game < results.size(); ++game) {
+        const GameResult& result = results[game];
+        csv << set << ',' << game << ','
+            << BotSkill::levelName(static_cast<unsigned>(game)) << ','
+            << parameters.spawnInterval << ',' << parameters.gravity << ','
+            << parameters.maxEnemies << ',' << result.survivalSeconds << ','
+            << result.score << ',' << result.clicksPerSecond << ','
+            << (result.capped ? 1 : 0) << '\n';
+    }
+}
+
+inline void printSet(unsigned set, const ParameterSet& parameters,
+                     const std::vector<GameResult>& results) {
+    std::printf("set %u: spawn_interval %.2f  gravity %.1f  max_enemies %d"
+                "  objective %.4f\n",
+                set, parameters.spawnInterval, parameters.gravity,
+                parameters.maxEnemies, objective(results));
+    for (unsigned skill = 0; skill < SKILL_COUNT; ++skill) {
+        std::vector<double> score;
+        std::vector<double> clicks;
+        unsigned capped = 0;
+        for (std::size_t i = skill; i < results.size(); i += SKILL_COUNT) {
+            score.push_back(results[i].score);
+            clicks.push_back(results[i].clicksPerSecond);
+            if (results[i].capped) ++capped;
+        }
+        const std::vector<double> survival = survivalOf(results, skill);
+        std::printf("  %-7s survival p10 %6.1f  p50 %6.1f  p90 %6.1f s"
+                    "  score p50 %6.0f  clicks/s %4.2f  capped %u/%zu\n",
+                    BotSkill::levelName(skill), PerfStats::percentile(survival, 0.10),
+                    PerfStats::percentile(survival, 0.50),
+                    PerfStats::percentile(survival, 0.90),
+                    PerfStats::percentile(score, 0.50),
+                    PerfStats::mean(clicks), capped, survival.size());
+    }
+    std::fflush(stdout);
+}
+
+// Search box, the same limits as the cvars where they exist
+constexpr double SPAWN_INTERVAL_RANGE[2] = {2.0, 120.0};
+constexpr double GRAVITY_RANGE[2] = {20.0, 600.0};
+constexpr double MAX_ENEMIES_RANGE[2] = {3.0, 200.0};
+
+/**
+ * @brief Uniform in log space over [range[0], range[1]]
+ */
+inline double sampleLog(const double (&range)[2], Random& random) {
+    return range[0] * std::pow(range[1] / range[0], random.nextFloat());
+}
+
+/**
+ * @brief Within a factor of e^radius of @p value, clamped to @p range
+ */
+inline double scaleLog(double value, const double (&range)[2], double radius,
+                       Random& random) {
+    const double factor = std::exp(radius * (2.0 * random.nextFloat() - 1.0));
+    return std::min(range[1], std::max(range[0], value * factor));
+}
+
+inline ParameterSet sampleBox(Random& random) {
+    ParameterSet next;
+    next.spawnInterval =
+        static_cast<float>(sampleLog(SPAWN_INTERVAL_RANGE, random));
+    next.gravity = static_cast<float>(sampleLog(GRAVITY_RANGE, random));
+    next.maxEnemies =
+        static_cast<int>(std::lround(sampleLog(MAX_ENEMIES_RANGE, random)));
+    return next;
+}
+
+/**
+ * @brief A neighbour of @p from, up to @p radius away in log space
+ */
+inline ParameterSet perturb(const ParameterSet& from, double radius,
+                            Random& random) {
+    ParameterSet next;
+    next.spawnInterval = static_cast<float>(
+        scaleLog(from.spawnInterval, SPAWN_INTERVAL_RANGE, radius, random));
+    next.gravity = static_cast<float>(
+        scaleLog(from.gravity, GRAVITY_RANGE, radius, random));
+    next.maxEnemies = static_cast<int>(std::lround(
+        scaleLog(from.maxEnemies, MAX_ENEMIES_RANGE, radius, random)));
+    return next;
+}
+
+inline int usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0 << " " << FLAG
+              << " N [--seed S] [--threads T] [--csv PATH]"
+                 " [--optimize ROUNDS]\n";
+    return 1;
+}
+
+/**
+ * @brief Parse the whole command line; --simulate must be on it
+ */
+inline bool parse(int argc, char** argv, Options& options) {
+    CommandLine commandLine;
+    commandLine.add(FLAG, options.games)
+        .add("--seed", options.seed)
+        .add("--threads", options.threads)
+        .add("--csv", options.csvPath)
+        .add("--optimize", options.optimizeRounds);
+    return commandLine.parse(argc, argv) && options.games >= SKILL_COUNT;
+}
+
+/**
+ * @return Process exit code
+ */
+inline int run(int argc, char** argv) {
+    Options options;
+    if (!parse(argc, argv, options)) return usage(argv[0]);
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::ofstream csv(options.csvPath);
+    if (!csv.is_open()) {
+        std::cerr << "ERROR::SIMULATE::Cannot write " << options.csvPath
+                  << "\n";
+        return 1;
+    }
+    csv << "set,game,skill,spawn_interval,gravity,max_enemies,"
+           "survival_s,score,clicks_per_s,capped\n";
+
+    std::printf("Simulating %u games per set on %u threads, seed %llu\n",
+                options.games, options.threads,
+                static_cast<unsigned long long>(options.seed));
+    const auto start = std::chrono::steady_clock::now();
+    ThreadPool pool(options.threads);
+
+    unsigned set = 0;
+    ParameterSet best = ParameterSet::defaults();
+    std::vector<GameResult> results = playSet(pool, best, options);
+    double bestScore = objective(results);
+    writeRows(csv, set, best, results);
+    printSet(set, best, results);
+
+    Random random(mix(options.seed ^ 0x0971));
+    double radius = 1.0;
+    for (unsigned round = 0; round < options.optimizeRounds; ++round) {
+        bool improved = false;
+        const unsigned candidates =
+            round == 0 ? BOX_CANDIDATES : CANDIDATES_PER_ROUND;
+        for (unsigned c = 0; c < candidates; ++c) {
+            const ParameterSet candidate = round == 0
+                                               ? sampleBox(random)
+                                               : perturb(best, radius, random);
+            results = playSet(pool, candidate, options);
+            writeRows(csv, ++set, candidate, results);
+            const double score = objective(results);
+            if (score < bestScore) {
+                bestScore = score;
+                best = candidate;
+                improved = true;
+                printSet(set, candidate, results);
+            }
+        }
+        if (!improved) radius = std::max(0.05, radius * 0.6);
+        std::printf("round %u/%u: best objective %.4f, radius %.3f\n",
+                    round + 1, options.optimizeRounds, bestScore, radius);
+        std::fflush(stdout);
+    }
+
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    const double games = static_cast<double>(set + 1) * options.games;
+    std::printf("%.0f games in %.1f s (%.0f games/s), rows in %s\n", games,
+                seconds, games / seconds, options.csvPath.c_str());
+    if (options.optimizeRounds > 0) {
+        std::printf("Best: set gravity %.1f, set spawn_interval %.2f, "
+                    "set max_enemies %d (objective %.4f)\n",
+                    best.gravity, best.spawnInterval, best.maxEnemies,
+                    bestScore);
+    }
+    return 0;
+}
+
+}  // namespace MonteCarlo
@@ -0,0 +1,154 @@
+/**
+ * @file MultiWorld.h
+ * @brief N independent game worlds in one process, on all cores
+ *
+ *   FallingFury --worlds N [--seconds S] [--threads T] [--seed X]
+ *
+ * Runs N PlayingState worlds in a WorldPool on a headless EngineContext,
+ * each played by its own Bot (skill cycling novice, casual, expert), for
+ * S seconds of game time (default 60) at a fixed 60 Hz step. Reports the
+ * throughput in world-frames per second and the score spread, then plays
+ * world 0 again on its own and checks it scores the same: if worlds
+ * shared any state, the parallel run would disagree and the exit code
+ * is 1.
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "core/WorldPool.h"
+#include "sim/Bot.h"
+#include "systems/CommandLine.h"
+#include "systems/PerfStats.h"
+
+namespace MultiWorld {
+
+constexpr const char* FLAG = "--worlds";
+constexpr float TIMESTEP = 1.f / 60.f;
+
+struct Options {
+    unsigned worlds = 0;
+    unsigned seconds = 60;  // Game time
+    unsigned threads = 0;   // 0: one per core
+    std::uint64_t seed = 1;
+};
+
+inline std::uint64_t seedFor(const Options& options, unsigned world) {
+    return options.seed * 0x9E3779B97F4A7C15ull + world;
+}
+
+/**
+ * @brief Play @p options.worlds worlds in @p pool until every game is
+ * over or the time is up
+ * @return Frames stepped
+ */
+inline std::uint64_t play(WorldPool& pool, const Options& options) {
+    std::vector<Bot> bots;
+    bots.reserve(options.worlds);
+    for (unsigned world = 0; world < options.worlds; ++world) {
+        pool.add(SimConfig(), seedFor(options, world));
+        bots.emplace_back(BotSkill::level(world), seedFor(options, world) ^ 0xB07u);
+    }
+
+    const std::uint64_t maxFrames =
+        static_cast<std::uint64_t>(std::lround(options.seconds / TIMESTEP));
+    std::uint64_t frame = 0;
+    for (; frame < maxFrames; ++frame) {
+        bool running = false;
+        for (std::size_t i = 0; i < pool.size(); ++i) {
+            running = running || !pool.get(i).shouldQuit();
+        }
+        if (!running) break;
+
+        pool.update(TIMESTEP, [&bots](std::size_t i, PlayingState& state) {
+            state.setInput(bots[i].think(state.getWorld().getSim(), TIMESTEP));
+        });
+    }
+    return frame;
+}
+
+inline int usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0 << " " << FLAG
+              << " N [--seconds S] [--threads T] [--seed X]\n";
+    return 1;
+}
+
+/**
+ * @brief Parse the whole command line; --worlds must be on it
+ */
+inline bool parse(int argc, char** argv, Options& options) {
+    CommandLine commandLine;
+    commandLine.add(FLAG, options.worlds)
+        .add("--seconds", options.seconds)
+        .add("--threads", options.threads)
+        .add("--seed", options.seed);
+    return commandLine.parse(argc, argv) && options.worlds > 0 &&
+           options.seconds > 0;
+}
+
+/**
+ * @return Process exit code
+ */
+inline int run(int argc, char** argv) {
+    Options options;
+    if (!parse(argc, argv, options)) return usage(argv[0]);
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const EngineContext engine = EngineContext::headless();
+    WorldPool pool(engine, options.threads);
+    std::printf("Running %u worlds on %u threads for %u s of game time\n",
+                options.worlds, options.threads, options.seconds);
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t frames = play(pool, options);
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+
+    std::vector<double> scores;
+    unsigned over = 0;
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        scores.push_back(pool.get(i).getScore());
+        if (pool.get(i).shouldQuit()) ++over;
+    }
+    const double worldFrames = static_cast<double>(frames) * pool.size();
+    std::printf("%llu frames x %zu worlds in %.2f s: %.0f world-frames/s "
+                "(%.1f x real time per world)\n",
+                static_cast<unsigned long long>(frames), pool.size(), seconds,
+                worldFrames / seconds,
+                worldFrames * TIMESTEP / seconds / pool.size());
+    std::printf("Score p10 %.0f  p50 %.0f  p90 %.0f  max %.0f; %u games "
+                "over\n",
+                PerfStats::percentile(scores, 0.10),
+                PerfStats::percentile(scores, 0.50),
+                PerfStats::percentile(scores, 0.90),
+                *std::max_element(scores.begin(), scores.end()), over);
+
+    // World 0 again, alone on this thread: any shared state would show
+    Options alone = options;
+    alone.worlds = 1;
+    WorldPool single(engine, 0);
+    play(single, alone);
+    if (single.get(0).getScore() != pool.get(0).getScore() ||
+        single.get(0).getPoints() != pool.get(0).getPoints()) {
+        std::cerr << "ERROR::MULTIWORLD::World 0 scored "
+                  << pool.get(0).getScore() << " alongside others but "
+                  << single.get(0).getScore() << " alone\n";
+        return 1;
+    }
+    std::printf("Isolation check: world 0 scores %u alone and alongside "
+                "the others\n",
+                single.get(0).getScore());
+    return 0;
+}
+
+}  // namespace MultiWorld
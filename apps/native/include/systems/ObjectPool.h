@@ -7,7 +7,9 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <functional>
+#include <iostream>
 #include <memory>
 #include <vector>
 
@@ -38,11 +40,15 @@ class ObjectPool {
      */
     ObjectPool(size_t poolSize, std::function<std::unique_ptr<T>()> factory,
                std::function<void(T*)> reset = nullptr, bool allowGrowth = true)
-        : mPoolSize(poolSize),
-          mFactory(factory),
+        : mFactory(factory),
           mReset(reset),
+          mPoolSize(poolSize),
           mAllowGrowth(allowGrowth) {
-        // Pre-allocate objects
+        // Pre-allocate objects, and room to track them all, so acquire()
+        // and release() do not allocate until the pool has to grow
+        mPool.reserve(mPoolSize);
+        mAvailable.reserve(mPoolSize);
+        mInUse.reserve(mPoolSize);
         for (size_t i = 0; i < mPoolSize; ++i) {
             auto obj = mFactory();
             mAvailable.push_back(obj.get());
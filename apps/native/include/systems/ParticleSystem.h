@@ -8,86 +8,31 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <cmath>
+#include <iostream>
 #include <memory>
 #include <vector>
 
-/**
- * @brief Single particle
- */
-struct Particle {
-    sf::CircleShape shape;
-    sf::Vector2f velocity;
-    float lifetime;
-    float maxLifetime;
-    sf::Color startColor;
-    sf::Color endColor;
-    float startSize;
-    float endSize;
-    bool active;
-
-    Particle()
-        : lifetime(0.f),
-          maxLifetime(1.f),
-          startSize(5.f),
-          endSize(0.f),
-          active(false) {
-        shape.setRadius(startSize);
-        shape.setOrigin(startSize, startSize);
-    }
-
-    void update(float deltaTime) {
-        if (!active) return;
-
-        lifetime += deltaTime;
-
-        if (lifetime >= maxLifetime) {
-            active = false;
-            return;
-        }
-
-        // Update position
-        shape.move(velocity * deltaTime);
-
-        // Apply gravity
-        velocity.y += 300.f * deltaTime;
-
-        // Calculate interpolation factor (0 to 1)
-        float t = lifetime / maxLifetime;
-
-        // Interpolate size
-        float size = startSize + (endSize - startSize) * t;
-        shape.setRadius(size);
-        shape.setOrigin(size, size);
-
-        // Interpolate color
-        sf::Color color;
-        color.r = static_cast<sf::Uint8>(startColor.r +
-                                         (endColor.r - startColor.r) * t);
-        color.g = static_cast<sf::Uint8>(startColor.g +
-                                         (endColor.g - startColor.g) * t);
-        color.b = static_cast<sf::Uint8>(startColor.b +
-                                         (endColor.b - startColor.b) * t);
-        color.a = static_cast<sf::Uint8>(255 * (1.f - t));  // Fade out
-        shape.setFillColor(color);
-    }
-};
+#include "sim/ParticleField.h"
+#include "sim/SfmlAdapter.h"
 
 /**
  * @brief Particle emitter/system
+ *
+ * Motion and fading live in ParticleField (FallingFuryCore); this class
+ * adds SFML types and drawing on top.
  */
 class ParticleSystem {
    private:
-    std::vector<Particle> mParticles;
-    size_t mPoolSize;
+    ParticleField mField;
+    sf::CircleShape mShape;  // Stamped once per live particle
 
    public:
     /**
      * @brief Constructor
      * @param poolSize Number of particles to pre-allocate
      */
-    ParticleSystem(size_t poolSize = 100) : mPoolSize(poolSize) {
-        mParticles.resize(mPoolSize);
-        std::cout << "ParticleSystem created with " << mPoolSize
+    ParticleSystem(size_t poolSize = 100) : mField(poolSize) {
+        std::cout << "ParticleSystem created with " << poolSize
                   << " particles\n";
     }
 
@@ -100,14 +45,7 @@ class ParticleSystem {
      */
     void emitBurst(const sf::Vector2f& position, int count,
                    const sf::Color& color, float speed = 1.0f) {
-        int emitted = 0;
-        for (auto& particle : mParticles) {
-            if (emitted >= count) break;
-            if (!particle.active) {
-                emitParticle(particle, position, color, speed);
-                emitted++;
-            }
-        }
+        mField.emitBurst(toSim(position), count, toSim(color), speed);
     }
 
     /**
@@ -117,7 +55,7 @@ class ParticleSystem {
      */
     void emitClickEffect(const sf::Vector2f& position,
                          const sf::Color& enemyColor) {
-        emitBurst(position, 20, enemyColor, 200.f);
+        mField.emitClickEffect(toSim(position), toSim(enemyColor));
     }
 
     /**
@@ -125,7 +63,7 @@ class ParticleSystem {
      * @param position Enemy position
      */
     void emitMissEffect(const sf::Vector2f& position) {
-        emitBurst(position, 10, sf::Color(255, 100, 100), 100.f);
+        mField.emitMissEffect(toSim(position));
     }
 
     /**
@@ -133,96 +71,48 @@ class ParticleSystem {
      * @param position Position
      */
     void emitComboEffect(const sf::Vector2f& position) {
-        for (int i = 0; i < 5; i++) {
-            int available = 0;
-            for (auto& particle : mParticles) {
-                if (!particle.active && available < 3) {
-                    sf::Color comboColor = sf::Color(255, 215, 0);  // Gold
-                    emitParticle(particle, position, comboColor, 150.f);
-                    particle.startSize = 8.f;
-                    particle.maxLifetime = 1.5f;
-                    available++;
-                }
-            }
-        }
+        mField.emitComboEffect(toSim(position));
     }
 
     /**
      * @brief Update all particles
      * @param deltaTime Time since last frame
      */
-    void update(float deltaTime) {
-        for (auto& particle : mParticles) {
-            if (particle.active) {
-                particle.update(deltaTime);
-            }
-        }
-    }
+    void update(float deltaTime) { mField.update(deltaTime); }
 
     /**
      * @brief Render all active particles
-     * @param window Reference to render window
+     * @param target Window or texture to draw into
      */
-    void render(sf::RenderWindow& window) {
-        for (const auto& particle : mParticles) {
-            if (particle.active) {
-                window.draw(particle.shape);
-            }
+    void render(sf::RenderTarget& target) {
+        for (const auto& particle : mField.getParticles()) {
+            if (!particle.active) continue;
+            mShape.setRadius(particle.size);
+            mShape.setOrigin(particle.size, particle.size);
+            mShape.setPosition(toSfml(particle.position));
+            mShape.setFillColor(toSfml(particle.color));
+            target.draw(mShape);
         }
     }
 
     /**
-     * @brief Clear all particles
+     * @brief Change the pool size; active particles are dropped
      */
-    void clear() {
-        for (auto& particle : mParticles) {
-            particle.active = false;
-        }
-    }
+    void resize(size_t poolSize) { mField.resize(poolSize); }
+
+    size_t getPoolSize() const { return mField.getPoolSize(); }
 
     /**
-     * @brief Get number of active particles
+     * @brief Clear all particles
      */
-    int getActiveCount() const {
-        int count = 0;
-        for (const auto& particle : mParticles) {
-            if (particle.active) count++;
-        }
-        return count;
-    }
+    void clear() { mField.clear(); }
 
-   private:
     /**
-     * @brief Emit a single particle
+     * @brief Get number of active particles
      */
-    void emitParticle(Particle& particle, const sf::Vector2f& position,
-                      const sf::Color& color, float speed) {
-        particle.active = true;
-        particle.lifetime = 0.f;
-        particle.maxLifetime =
-            0.5f + static_cast<float>(rand() % 100) / 200.f;  // 0.5-1.0s
-
-        // Random direction
-        float angle = static_cast<float>(rand() % 360) * 3.14159f / 180.f;
-        float velocityMag = speed + static_cast<float>(rand() % 100);
-
-        particle.velocity.x = cos(angle) * velocityMag;
-        particle.velocity.y =
-            sin(angle) * velocityMag - 100.f;  // Slight upward bias
+    int getActiveCount() const { return mField.getActiveCount(); }
 
-        particle.shape.setPosition(position);
-
-        particle.startColor = color;
-        particle.endColor = color;
-        particle.endColor.a = 0;
-
-        particle.startSize = 3.f + static_cast<float>(rand() % 5);
-        particle.endSize = 0.5f;
-
-        particle.shape.setRadius(particle.startSize);
-        particle.shape.setOrigin(particle.startSize, particle.startSize);
-        particle.shape.setFillColor(particle.startColor);
-    }
+    ParticleField& getField() { return mField; }
 };
 
 /**
@@ -0,0 +1,128 @@
+/**
+ * @file PerfStats.h
+ * @brief Summary statistics and significance tests for perf samples
+ *
+ * Timing samples are skewed and occasionally hit by preemption, so the
+ * tests here are rank based: they ask whether one set of runs tends to
+ * be slower than the other, or whether a series tends to rise, not
+ * whether the means differ.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace PerfStats {
+
+inline double mean(const std::vector<double>& values) {
+    if (values.empty()) return 0.0;
+    return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+
+/**
+ * @brief Nearest-rank percentile, @p fraction in [0, 1]
+ */
+inline double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const std::size_t index = static_cast<std::size_t>(
+        std::ceil(fraction * values.size()));
+    return values[std::min(values.size() - 1, index ? index - 1 : 0)];
+}
+
+inline double median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const std::size_t half = values.size() / 2;
+    return values.size() % 2 ? values[half]
+                             : (values[half - 1] + values[half]) / 2.0;
+}
+
+/**
+ * @brief One-sided Mann-Whitney U test
+ * @return p-value for "samples in @p b tend to be larger than in @p a"
+ * (normal approximation with tie and continuity correction; fine from
+ * about 5 samples per side)
+ */
+inline double mannWhitneyGreater(const std::vector<double>& a,
+                                 const std::vector<double>& b) {
+    const std::size_t na = a.size();
+    const std::size_t nb = b.size();
+    if (na == 0 || nb == 0) return 1.0;
+
+    struct Sample {
+        double value;
+        bool fromB;
+    };
+    std::vector<Sample> all;
+    for (double v : a) all.push_back({v, false});
+    for (double v : b) all.push_back({v, true});
+    std::sort(all.begin(), all.end(), [](const Sample& x, const Sample& y) {
+        return x.value < y.value;
+    });
+
+    // Average ranks over ties
+    double rankSumB = 0.0;
+    double tieTerm = 0.0;
+    for (std::size_t i = 0; i < all.size();) {
+        std::size_t j = i;
+        while (j < all.size() && all[j].value == all[i].value) ++j;
+        const double rank = (i + 1 + j) / 2.0;
+        for (std::size_t k = i; k < j; ++k) {
+            if (all[k].fromB) rankSumB += rank;
+        }
+        const double t = static_cast<double>(j - i);
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+
+    const double n = static_cast<double>(na + nb);
+    const double u = rankSumB - nb * (nb + 1) / 2.0;
+    const double mu = na * nb / 2.0;
+    const double variance =
+        na * nb / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0)));
+    if (variance <= 0.0) return 1.0;  // Every sample identical
+    const double z = (u - mu - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+/**
+ * @brief One-sided Mann-Kendall trend test
+ * @return p-value for "@p series tends to rise over time" (normal
+ * approximation with tie correction; needs about 7 points to get below
+ * 0.01)
+ */
+inline double mannKendallIncreasing(const std::vector<double>& series) {
+    const std::size_t n = series.size();
+    if (n < 3) return 1.0;
+
+    double s = 0.0;
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) {
+            s += (series[j] > series[i]) - (series[j] < series[i]);
+        }
+    }
+
+    std::vector<double> sorted = series;
+    std::sort(sorted.begin(), sorted.end());
+    double tieTerm = 0.0;
+    for (std::size_t i = 0; i < n;) {
+        std::size_t j = i;
+        while (j < n && sorted[j] == sorted[i]) ++j;
+        const double t = static_cast<double>(j - i);
+        tieTerm += t * (t - 1.0) * (2.0 * t + 5.0);
+        i = j;
+    }
+
+    const double count = static_cast<double>(n);
+    const double variance =
+        (count * (count - 1.0) * (2.0 * count + 5.0) - tieTerm) / 18.0;
+    if (s <= 0.0 || variance <= 0.0) return 1.0;
+    const double z = (s - 1.0) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+}  // namespace PerfStats
@@ -0,0 +1,147 @@
+/**
+ * @file PgoTraining.h
+ * @brief Deterministic workload for profile-guided optimization
+ *
+ * `FallingFury --pgo-train [minutes]` plays a fixed number of simulated
+ * minutes (default 10) without a window and exits. The run cycles
+ * through three phases a minute each, so the profile sees the real mix
+ * of work rather than one path:
+ *   - normal play: default settings, a click every third of a second
+ *   - swarm: many enemies, rapid clicks, long combos and particle bursts
+ *   - neglect: fast enemies, rare clicks, so games end and restart
+ * Hits go through ScoreManager for combos; every game over saves the
+ * high score and inserts into the leaderboard. Score files are written
+ * to a scratch directory, emptied before each run, never to the
+ * player's data/.
+ *
+ * Build with -DFALLING_FURY_PGO=GENERATE, run the pgo_train target (or
+ * this mode by hand), then rebuild with -DFALLING_FURY_PGO=USE.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <streambuf>
+
+#include "managers/ScoreManager.h"
+#include "sim/HeadlessGame.h"
+#include "systems/HeadlessRun.h"
+
+namespace PgoTraining {
+
+constexpr const char* FLAG = "--pgo-train";
+constexpr unsigned DEFAULT_MINUTES = 10;
+constexpr unsigned FRAMES_PER_MINUTE = 60 * 60;
+constexpr float TIMESTEP = 1.f / 60.f;
+
+enum class Phase { NORMAL, SWARM, NEGLECT };
+
+struct Totals {
+    std::uint64_t frames = 0;
+    unsigned hits = 0;
+    unsigned misses = 0;
+    unsigned games = 0;
+    unsigned leaderboardInserts = 0;
+};
+
+inline void configure(SimConfig& config, Phase phase) {
+    const SimConfig defaults;
+    config.gravity = defaults.gravity;
+    config.spawnInterval = defaults.spawnInterval;
+    config.maxEnemies = defaults.maxEnemies;
+    if (phase == Phase::SWARM) {
+        config.gravity = 80.f;
+        config.spawnInterval = 2.f;
+        config.maxEnemies = 200;
+    } else if (phase == Phase::NEGLECT) {
+        config.gravity = 400.f;
+        config.spawnInterval = 6.f;
+    }
+}
+
+/**
+ * @brief Press on the lowest enemy, the one about to be missed
+ */
+inline SimInput aim(const Simulation& sim) {
+    SimInput input;
+    if (const SimEnemy* lowest = sim.findLowestEnemy()) {
+        input.mouse = lowest->bounds.getCenter();
+        input.mouseDown = true;
+    }
+    return input;
+}
+
+/**
+ * @return Process exit code
+ */
+inline int run(unsigned minutes) {
+    HeadlessRun::ScratchDirectory scratch("falling_fury_pgo", "PGOTRAIN");
+    if (!scratch.isEntered()) return 1;
+
+    HeadlessRun::NullBuffer discarded;
+    std::streambuf* console = std::cout.rdbuf(&discarded);
+    const auto start = std::chrono::steady_clock::now();
+
+    ScoreManager& scores = ScoreManager::getInstance();
+    HeadlessGame game(SimConfig(), 0xFA11F0);
+    Totals totals;
+    const std::uint64_t frames =
+        static_cast<std::uint64_t>(minutes) * FRAMES_PER_MINUTE;
+    for (; totals.frames < frames; ++totals.frames) {
+        const Phase phase =
+            static_cast<Phase>(totals.frames / FRAMES_PER_MINUTE % 3);
+        // Each phase starts a fresh game: health banked from hits would
+        // otherwise keep the neglect phase from ever losing
+        if (totals.frames % FRAMES_PER_MINUTE == 0) {
+            configure(game.getSim().getConfig(), phase);
+            game.restart();
+            scores.resetScore();
+        }
+        if (game.getSim().isOver()) game.restart();
+
+        const unsigned every =
+            phase == Phase::SWARM ? 3 : (phase == Phase::NEGLECT ? 45 : 20);
+        SimInput input;
+        if (totals.frames % every == 0) input = aim(game.getSim());
+        game.frame(TIMESTEP, input);
+
+        for (const SimEvent& event : game.getSim().getEvents()) {
+            switch (event.type) {
+                case SimEventType::HIT:
+                    ++totals.hits;
+                    scores.addPoints(1);
+                    if (scores.getComboCount() % 3 == 0) {
+                        game.getParticles().emitComboEffect(event.position);
+                    }
+                    break;
+                case SimEventType::MISS:
+                    ++totals.misses;
+                    scores.breakCombo();
+                    break;
+                case SimEventType::GAME_OVER:
+                    ++totals.games;
+                    if (HeadlessRun::gameOver(scores, "Trainer")) {
+                        ++totals.leaderboardInserts;
+                    }
+                    break;
+            }
+        }
+        HeadlessRun::formatHud(scores);
+    }
+    ScoreManager::destroy();
+
+    std::cout.rdbuf(console);
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    std::printf("PGO training: %llu frames (%u simulated minutes) in %.2f s: "
+                "%u hits, %u misses, %u games, %u leaderboard inserts\n",
+                static_cast<unsigned long long>(totals.frames), minutes,
+                seconds, totals.hits, totals.misses, totals.games,
+                totals.leaderboardInserts);
+    return 0;
+}
+
+}  // namespace PgoTraining
@@ -0,0 +1,323 @@
+/**
+ * @file SoakTest.h
+ * @brief Long-running headless soak with leak and latency drift detection
+ *
+ * `FallingFury --soak [hours]` plays simulated hours (default 24) as fast
+ * as the machine allows, the way a kiosk would: a visitor (a Bot of
+ * random skill) plays a few minutes, walks away until the game ends, and
+ * the next one starts.
+ * Game overs go through ScoreManager, so the high score file and the
+ * leaderboard are rewritten all run long. Once per simulated hour it
+ * samples:
+ *   - resident set size and live heap blocks (the latter only when built
+ *     with FALLING_FURY_ALLOC_TRACKING)
+ *   - particle pool size, live particles and enemy vector capacity
+ *   - leaderboard entries and open file descriptors
+ *   - frame time p50, p99 and max
+ * After the first hour (warmup), a series that rises with Mann-Kendall
+ * p < 0.01 and whose last third sits more than 5% above its first third
+ * (medians, so one noisy hour cannot decide it) is flagged: a leak for
+ * the resource columns, latency drift for p99. The exit code is
+ * 1 if anything is flagged. Score files go to a scratch directory.
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "managers/ScoreManager.h"
+#include "sim/Bot.h"
+#include "sim/HeadlessGame.h"
+#include "systems/AllocationCounter.h"
+#include "systems/HeadlessRun.h"
+#include "systems/PerfStats.h"
+
+namespace SoakTest {
+
+constexpr const char* FLAG = "--soak";
+constexpr unsigned DEFAULT_HOURS = 24;
+constexpr std::uint64_t FRAMES_PER_MINUTE = 60 * 60;
+constexpr std::uint64_t FRAMES_PER_HOUR = 60 * FRAMES_PER_MINUTE;
+constexpr float TIMESTEP = 1.f / 60.f;
+constexpr unsigned WARMUP_HOURS = 1;
+constexpr double TREND_ALPHA = 0.01;
+constexpr double GROWTH_THRESHOLD = 0.05;
+
+struct Sample {
+    double residentKb = 0.0;
+    double liveAllocations = 0.0;
+    double particlePool = 0.0;
+    double particlesActive = 0.0;
+    double enemyCapacity = 0.0;
+    double leaderboard = 0.0;
+    double openFiles = 0.0;
+    double frameP50Us = 0.0;
+    double frameP99Us = 0.0;
+    double frameMaxUs = 0.0;
+    unsigned games = 0;  // Finished during the hour
+};
+
+/**
+ * @brief Resident set size in KiB, 0 where the platform gives no reading
+ */
+inline double residentKb() {
+#if defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+        return 0.0;
+    }
+    return static_cast<double>(info.resident_size) / 1024.0;
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t size = 0;
+    std::uint64_t resident = 0;
+    if (!(statm >> size >> resident)) return 0.0;
+    return static_cast<double>(resident) * sysconf(_SC_PAGESIZE) / 1024.0;
+#else
+    return 0.0;
+#endif
+}
+
+/**
+ * @brief Open file descriptors (including the one used to count them)
+ */
+inline double openFiles() {
+#if defined(__linux__)
+    const char* directory = "/proc/self/fd";
+#elif defined(__APPLE__)
+    const char* directory = "/dev/fd";
+#else
+    const char* directory = nullptr;
+#endif
+    if (!directory) return 0.0;
+    std::error_code error;
+    double count = 0.0;
+    for (std::filesystem::directory_iterator it(directory, error), end;
+         !error && it != end; it.increment(error)) {
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief A kiosk visitor: plays a while, then leaves the game to run out
+ */
+class Player {
+   private:
+    Random mRandom;
+    Bot mBot;
+    std::uint64_t mLeaveAt;  // Frame of the session the player walks away
+
+    void newVisitor(std::uint64_t frame) {
+        mLeaveAt = frame + FRAMES_PER_MINUTE +
+                   static_cast<std::uint64_t>(mRandom.nextInt(3 * 60)) * 60;
+        mBot.getSkill() = BotSkill::level(static_cast<unsigned>(
+            mRandom.nextInt(BotSkill::LEVEL_COUNT)));
+        mBot.reset();
+    }
+
+   public:
+    explicit Player(std::uint64_t seed)
+        : mRandom(seed), mBot(BotSkill(), seed ^ 0xB07), mLeaveAt(0) {
+        newVisitor(0);
+    }
+
+    void restart(std::uint64_t frame) { newVisitor(frame); }
+
+    SimInput input(const Simulation& sim, std::uint64_t frame) {
+        if (frame >= mLeaveAt) return SimInput();
+        return mBot.think(sim, TIMESTEP);
+    }
+};
+
+/**
+ * @param frameUs This hour's frame times; sorted in place
+ */
+inline Sample sample(const HeadlessGame& game, const ScoreManager& scores,
+                     std::vector<double>& frameUs, unsigned games) {
+    Sample s;
+    s.residentKb = residentKb();
+    s.liveAllocations = static_cast<double>(AllocationCounter::live());
+    s.particlePool = static_cast<double>(game.getParticles().getPoolSize());
+    s.particlesActive = game.getParticles().getActiveCount();
+    s.enemyCapacity =
+        static_cast<double>(game.getSim().getEnemies().capacity());
+    s.leaderboard = static_cast<double>(scores.getLeaderboard().size());
+    s.openFiles = openFiles();
+    // Nearest rank, as PerfStats::percentile, without three copies of
+    // an hour of samples
+    std::sort(frameUs.begin(), frameUs.end());
+    auto rank = [&frameUs](double fraction) {
+        const std::size_t index = static_cast<std::size_t>(
+            std::ceil(fraction * frameUs.size()));
+        return frameUs.empty()
+                   ? 0.0
+                   : frameUs[std::min(frameUs.size() - 1,
+                                      index ? index - 1 : 0)];
+    };
+    s.frameP50Us = rank(0.50);
+    s.frameP99Us = rank(0.99);
+    s.frameMaxUs = rank(1.0);
+    s.games = games;
+    return s;
+}
+
+inline void printHeader() {
+    std::printf("%5s %10s %10s %6s %6s %6s %5s %5s %8s %8s %9s %6s\n", "hour",
+                "rss_kb", "live", "pool", "parts", "enemy", "board", "fds",
+                "p50_us", "p99_us", "max_us", "games");
+}
+
+inline void printSample(std::size_t hour, const Sample& s) {
+    std::printf("%5zu %10.0f ", hour, s.residentKb);
+    if (AllocationCounter::ENABLED) {
+        std::printf("%10.0f ", s.liveAllocations);
+    } else {
+        std::printf("%10s ", "-");
+    }
+    std::printf("%6.0f %6.0f %6.0f %5.0f %5.0f %8.2f %8.2f %9.1f %6u\n",
+                s.particlePool, s.particlesActive, s.enemyCapacity,
+                s.leaderboard, s.openFiles, s.frameP50Us, s.frameP99Us,
+                s.frameMaxUs, s.games);
+    std::fflush(stdout);
+}
+
+/**
+ * @brief Test one column after warmup
+ * @return Whether it was flagged
+ */
+inline bool checkTrend(const char* name, const char* problem,
+                       const std::vector<Sample>& samples,
+                       double Sample::*field) {
+    std::vector<double> series;
+    for (std::size_t i = WARMUP_HOURS; i < samples.size(); ++i) {
+        series.push_back(samples[i].*field);
+    }
+    if (series.empty()) return false;
+
+    const double p = PerfStats::mannKendallIncreasing(series);
+    const std::size_t third = std::max<std::size_t>(series.size() / 3, 1);
+    const double first = PerfStats::median(
+        std::vector<double>(series.begin(), series.begin() + third));
+    const double last = PerfStats::median(
+        std::vector<double>(series.end() - third, series.end()));
+    const bool flagged = p < TREND_ALPHA && last > first &&
+                         last > first * (1.0 + GROWTH_THRESHOLD);
+    std::printf("  %-14s trend p %.4f  %12.2f -> %12.2f  %s\n", name, p,
+                first, last, flagged ? problem : "ok");
+    return flagged;
+}
+
+/**
+ * @return Process exit code: 1 if a leak or latency drift was flagged
+ */
+inline int run(unsigned hours) {
+    HeadlessRun::ScratchDirectory scratch("falling_fury_soak", "SOAK");
+    if (!scratch.isEntered()) return 1;
+
+    std::printf("Soak: %u simulated hours, %llu frames each\n", hours,
+                static_cast<unsigned long long>(FRAMES_PER_HOUR));
+    if (!AllocationCounter::ENABLED) {
+        std::printf("Live heap: allocation tracking off (build with "
+                    "FALLING_FURY_ALLOC_TRACKING)\n");
+    }
+    printHeader();
+    HeadlessRun::NullBuffer discarded;
+    std::streambuf* console = std::cout.rdbuf(&discarded);
+    const auto start = std::chrono::steady_clock::now();
+
+    ScoreManager& scores = ScoreManager::getInstance();
+    HeadlessGame game(SimConfig(), 0x50A4);
+    Player player(0x50A4 ^ 0x9E3779B9);
+    std::vector<double> frameUs;
+    frameUs.reserve(FRAMES_PER_HOUR);
+    std::vector<Sample> samples;
+    samples.reserve(hours);
+    unsigned games = 0;
+
+    for (std::uint64_t frame = 0;
+         frame < static_cast<std::uint64_t>(hours) * FRAMES_PER_HOUR;) {
+        if (game.getSim().isOver()) {
+            game.restart();
+            player.restart(frame);
+        }
+
+        const SimInput input = player.input(game.getSim(), frame);
+        const auto frameStart = std::chrono::steady_clock::now();
+        game.frame(TIMESTEP, input);
+        for (const SimEvent& event : game.getSim().getEvents()) {
+            switch (event.type) {
+                case SimEventType::HIT:
+                    scores.addPoints(1);
+                    break;
+                case SimEventType::MISS:
+                    scores.breakCombo();
+                    break;
+                case SimEventType::GAME_OVER:
+                    ++games;
+                    HeadlessRun::gameOver(scores, "Soak");
+                    break;
+            }
+        }
+        HeadlessRun::formatHud(scores);
+        frameUs.push_back(std::chrono::duration<double, std::micro>(
+                              std::chrono::steady_clock::now() - frameStart)
+                              .count());
+
+        if (++frame % FRAMES_PER_HOUR == 0) {
+            samples.push_back(sample(game, scores, frameUs, games));
+            printSample(samples.size(), samples.back());
+            frameUs.clear();
+            games = 0;
+        }
+    }
+    ScoreManager::destroy();
+    std::cout.rdbuf(console);
+
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    std::printf("Soaked %u simulated hours in %.1f s\n", hours, seconds);
+    if (samples.size() < WARMUP_HOURS + 7) {
+        std::printf("Too short for drift detection: needs at least %u hours\n",
+                    WARMUP_HOURS + 7);
+        return 0;
+    }
+
+    std::printf("Drift after %u warmup hour(s):\n", WARMUP_HOURS);
+    bool flagged = false;
+    flagged |= checkTrend("rss_kb", "LEAK", samples, &Sample::residentKb);
+    if (AllocationCounter::ENABLED) {
+        flagged |= checkTrend("live_allocs", "LEAK", samples,
+                              &Sample::liveAllocations);
+    }
+    flagged |= checkTrend("particle_pool", "LEAK", samples,
+                          &Sample::particlePool);
+    flagged |= checkTrend("enemy_capacity", "LEAK", samples,
+                          &Sample::enemyCapacity);
+    flagged |= checkTrend("leaderboard", "LEAK", samples,
+                          &Sample::leaderboard);
+    flagged |= checkTrend("open_files", "LEAK", samples, &Sample::openFiles);
+    flagged |= checkTrend("frame_p99_us", "DRIFT", samples,
+                          &Sample::frameP99Us);
+    std::printf("%s\n", flagged ? "FAIL" : "PASS");
+    return flagged ? 1 : 0;
+}
+
+}  // namespace SoakTest
@@ -0,0 +1,81 @@
+/**
+ * @file SpscQueue.h
+ * @brief Lock-free single-producer/single-consumer ring buffer
+ *
+ * Used to hand commands from the game thread to real-time threads (audio)
+ * without ever blocking either side
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Bounded SPSC queue
+ * @tparam T Element type (should be trivially copyable)
+ * @tparam Capacity Number of slots, must be a power of two
+ *
+ * Exactly one thread may call tryPush() and exactly one other thread may
+ * call tryPop(). Neither call allocates or takes a lock.
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+   private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    std::array<T, Capacity> mSlots{};
+
+    // Head and tail live on separate cache lines so producer and consumer
+    // don't false-share
+    alignas(64) std::atomic<std::size_t> mHead{0};  // Next slot to read
+    alignas(64) std::atomic<std::size_t> mTail{0};  // Next slot to write
+
+   public:
+    /**
+     * @brief Push an element (producer thread only)
+     * @param value Element to copy into the queue
+     * @return false if the queue is full
+     */
+    bool tryPush(const T& value) {
+        const std::size_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) >= Capacity) {
+            return false;
+        }
+
+        mSlots[tail & MASK] = value;
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop an element (consumer thread only)
+     * @param out Receives the element
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& out) {
+        const std::size_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        out = mSlots[head & MASK];
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of queued elements
+     */
+    std::size_t size() const {
+        return mTail.load(std::memory_order_acquire) -
+               mHead.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+};
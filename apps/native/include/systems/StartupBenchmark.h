@@ -0,0 +1,163 @@
+/**
+ * @file StartupBenchmark.h
+ * @brief Time-to-first-frame measurement across repeated launches
+ *
+ * `FallingFury --startup-bench N [--cold]` relaunches the game N times
+ * with --exit-after-first-frame. Each child prints when its first frame
+ * was presented; the parent reports the first launch separately from the
+ * rest (warm, files and shared libraries already in the page cache).
+ * Even the first is not cold: the parent has just run the same binary.
+ * Only with --cold, which drops the page cache before every launch and
+ * needs root on Linux, are launches reported as cold.
+ */
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "systems/TraceRecorder.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace StartupBenchmark {
+
+constexpr const char* EXIT_AFTER_FIRST_FRAME = "--exit-after-first-frame";
+constexpr const char* TTFF_TAG = "TTFF_US";
+
+/**
+ * @brief Steady clock in microseconds, comparable across processes
+ */
+inline std::int64_t steadyUs(std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               time.time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Child side: print "TTFF_US <since static init> <steady now>"
+ */
+inline void reportFirstFrame() {
+    TraceRecorder& trace = TraceRecorder::getInstance();
+    std::cout << TTFF_TAG << " " << trace.nowUs() << " "
+              << steadyUs(std::chrono::steady_clock::now()) << std::endl;
+}
+
+/**
+ * @brief Drop the OS page cache so the next launch reads from disk
+ * @return false if not supported or not permitted
+ */
+inline bool dropPageCache() {
+#ifdef __linux__
+    sync();
+    std::ofstream file("/proc/sys/vm/drop_caches");
+    if (!file.is_open()) return false;
+    file << "3\n";
+    file.flush();
+    return file.good();
+#else
+    return false;
+#endif
+}
+
+struct Launch {
+    std::int64_t launchUs;   // Spawn to first frame, as the user sees it
+    std::int64_t processUs;  // Static init to first frame
+};
+
+/**
+ * @brief Start @p executable once and wait for its first-frame report
+ */
+inline bool launchOnce(const std::string& executable, Launch& launch) {
+    const std::string command =
+        "\"" + executable + "\" " + EXIT_AFTER_FIRST_FRAME;
+    const std::int64_t spawnUs = steadyUs(std::chrono::steady_clock::now());
+    FILE* pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr) return false;
+
+    bool reported = false;
+    char line[512];
+    while (std::fgets(line, sizeof(line), pipe) != nullptr) {
+        long long processUs = 0, frameUs = 0;
+        if (!reported && std::sscanf(line, "TTFF_US %lld %lld", &processUs,
+                                     &frameUs) == 2) {
+            launch.processUs = processUs;
+            launch.launchUs = frameUs - spawnUs;
+            reported = true;
+        }
+    }
+    return pclose(pipe) == 0 && reported;
+}
+
+inline void printSummary(const char* label, std::vector<Launch> launches) {
+    if (launches.empty()) return;
+    std::sort(launches.begin(), launches.end(),
+              [](const Launch& a, const Launch& b) {
+                  return a.launchUs < b.launchUs;
+              });
+    auto ms = [](std::int64_t us) { return us / 1000.0; };
+    std::printf("%-5s n=%-3zu min %8.2f ms  median %8.2f ms  max %8.2f ms\n",
+                label, launches.size(), ms(launches.front().launchUs),
+                ms(launches[launches.size() / 2].launchUs),
+                ms(launches.back().launchUs));
+}
+
+/**
+ * @brief Parent side: launch @p count times and report TTFF
+ * @return Process exit code
+ */
+inline int run(std::string executable, int count, bool cold) {
+#ifdef __linux__
+    // argv[0] may be relative or found through PATH
+    char self[4096];
+    const ssize_t length = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (length > 0) executable.assign(self, static_cast<std::size_t>(length));
+#endif
+
+    std::vector<Launch> coldLaunches;
+    std::vector<Launch> firstLaunches;
+    std::vector<Launch> warmLaunches;
+    for (int i = 0; i < count; ++i) {
+        bool isCold = false;
+        if (cold) {
+            if (dropPageCache()) {
+                isCold = true;
+            } else if (i == 0) {
+                std::cerr << "ERROR::STARTUPBENCH::Cannot drop the page "
+                             "cache (needs root); no launch is cold\n";
+            }
+        }
+        const char* label = isCold ? "cold" : i == 0 ? "first" : "warm";
+
+        Launch launch;
+        if (!launchOnce(executable, launch)) {
+            std::cerr << "ERROR::STARTUPBENCH::Launch " << (i + 1)
+                      << " did not report a first frame\n";
+            return 1;
+        }
+        std::printf("launch %3d  %-5s  ttff %8.2f ms  (in-process %8.2f ms)\n",
+                    i + 1, label, launch.launchUs / 1000.0,
+                    launch.processUs / 1000.0);
+        (isCold ? coldLaunches : i == 0 ? firstLaunches : warmLaunches)
+            .push_back(launch);
+    }
+
+    printSummary("cold", coldLaunches);
+    printSummary("first", firstLaunches);
+    printSummary("warm", warmLaunches);
+    return 0;
+}
+
+}  // namespace StartupBenchmark
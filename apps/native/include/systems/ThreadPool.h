@@ -0,0 +1,129 @@
+/**
+ * @file ThreadPool.h
+ * @brief Fixed-size worker pool for background jobs
+ *
+ * Used for asset decoding and other work that must stay off the game
+ * thread. A pool constructed with zero threads runs every job inline on
+ * submit, which is what single-threaded targets (wasm) get.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+   private:
+    std::vector<std::thread> mWorkers;
+    std::deque<std::function<void()>> mJobs;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStopping;
+
+    void workerLoop(const std::function<void()>& threadInit) {
+        if (threadInit) threadInit();
+
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock,
+                                [this] { return mStopping || !mJobs.empty(); });
+                if (mStopping && mJobs.empty()) return;
+                job = std::move(mJobs.front());
+                mJobs.pop_front();
+            }
+            job();
+        }
+    }
+
+   public:
+    /**
+     * @brief Constructor
+     * @param threadCount Number of workers (0 = run jobs inline)
+     * @param threadInit Optional function each worker runs once at startup,
+     *                   e.g. to create a thread-local GL context
+     */
+    explicit ThreadPool(std::size_t threadCount,
+                        std::function<void()> threadInit = nullptr)
+        : mStopping(false) {
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            mWorkers.emplace_back(
+                [this, threadInit] { workerLoop(threadInit); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        for (auto& worker : mWorkers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue a job
+     * @return Future for the job's result
+     */
+    template <typename Func>
+    auto submit(Func&& func) -> std::future<decltype(func())> {
+        using Result = decltype(func());
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<Func>(func));
+        std::future<Result> future = task->get_future();
+
+        if (mWorkers.empty()) {
+            (*task)();
+            return future;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mJobs.emplace_back([task] { (*task)(); });
+        }
+        mCondition.notify_one();
+        return future;
+    }
+
+    std::size_t getThreadCount() const { return mWorkers.size(); }
+
+    /**
+     * @brief Run a one-off job on its own thread
+     *
+     * Single-threaded targets defer the job until the future is waited on,
+     * where std::async(std::launch::async) would throw.
+     */
+    template <typename Func, typename... Args>
+    static auto async(Func&& func, Args&&... args) {
+#ifdef __EMSCRIPTEN__
+        const std::launch policy = std::launch::deferred;
+#else
+        const std::launch policy = std::launch::async;
+#endif
+        return std::async(policy, std::forward<Func>(func),
+                          std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Sensible worker count for background work on this machine
+     */
+    static std::size_t defaultThreadCount() {
+#ifdef __EMSCRIPTEN__
+        return 0;
+#else
+        unsigned cores = std::thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 1;
+#endif
+    }
+};
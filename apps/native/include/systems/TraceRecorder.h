@@ -0,0 +1,172 @@
+/**
+ * @file TraceRecorder.h
+ * @brief Singleton recorder for timed spans across threads
+ *
+ * Spans are written as Chrome trace JSON (open in chrome://tracing or
+ * Perfetto) so overlapping work on different threads is easy to see.
+ * Recording takes a mutex and is meant for coarse phases such as startup
+ * and asset loads, not per-frame work.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief One completed span
+ */
+struct TraceSpan {
+    std::string name;
+    std::string category;
+    std::uint64_t threadId;
+    std::int64_t startUs;
+    std::int64_t endUs;
+};
+
+class TraceRecorder {
+   private:
+    std::mutex mMutex;
+    std::vector<TraceSpan> mSpans;
+    std::chrono::steady_clock::time_point mOrigin;
+
+    TraceRecorder() : mOrigin(std::chrono::steady_clock::now()) {}
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+   public:
+    /**
+     * @brief Get singleton instance
+     */
+    static TraceRecorder& getInstance() {
+        // Constructed on first use from whichever thread gets here first
+        static TraceRecorder instance;
+        return instance;
+    }
+
+    /**
+     * @brief Microseconds since the recorder was created
+     */
+    std::int64_t nowUs() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - mOrigin)
+            .count();
+    }
+
+    /**
+     * @brief The instant nowUs() counts from (steady clock, so it can be
+     * compared across processes on the same machine)
+     */
+    std::chrono::steady_clock::time_point getOrigin() const { return mOrigin; }
+
+    static std::uint64_t currentThreadId() {
+        return static_cast<std::uint64_t>(
+            std::hash<std::thread::id>()(std::this_thread::get_id()));
+    }
+
+    /**
+     * @brief Record a completed span on the calling thread
+     */
+    void record(const std::string& name, const std::string& category,
+                std::int64_t startUs, std::int64_t endUs) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSpans.push_back(
+            {name, category, currentThreadId(), startUs, endUs});
+    }
+
+    /**
+     * @brief Copy of all spans recorded so far
+     */
+    std::vector<TraceSpan> getSpans() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mSpans;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mSpans.clear();
+    }
+
+    /**
+     * @brief Write @p text as a JSON string literal
+     */
+    static void writeString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                              static_cast<unsigned>(c));
+                out << escaped;
+            } else {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+
+    /**
+     * @brief Write all spans as Chrome trace JSON
+     * @param filepath Output file
+     * @return true on success
+     */
+    bool writeChromeTrace(const std::string& filepath) {
+        std::vector<TraceSpan> spans = getSpans();
+
+        std::ofstream file(filepath);
+        if (!file.is_open()) {
+            std::cerr << "ERROR::TRACERECORDER::Cannot write trace: "
+                      << filepath << "\n";
+            return false;
+        }
+
+        file << "{\"traceEvents\":[\n";
+        for (std::size_t i = 0; i < spans.size(); ++i) {
+            const TraceSpan& span = spans[i];
+            file << "{\"name\":";
+            writeString(file, span.name);
+            file << ",\"cat\":";
+            writeString(file, span.category);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                 << (span.threadId % 100000) << ",\"ts\":" << span.startUs
+                 << ",\"dur\":" << (span.endUs - span.startUs) << "}"
+                 << (i + 1 < spans.size() ? ",\n" : "\n");
+        }
+        file << "]}\n";
+        return true;
+    }
+};
+
+/**
+ * @brief RAII span: records from construction to destruction
+ */
+class ScopedTrace {
+   private:
+    std::string mName;
+    std::string mCategory;
+    std::int64_t mStartUs;
+
+   public:
+    ScopedTrace(std::string name, std::string category)
+        : mName(std::move(name)),
+          mCategory(std::move(category)),
+          mStartUs(TraceRecorder::getInstance().nowUs()) {}
+
+    ~ScopedTrace() {
+        TraceRecorder& recorder = TraceRecorder::getInstance();
+        recorder.record(mName, mCategory, mStartUs, recorder.nowUs());
+    }
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+};
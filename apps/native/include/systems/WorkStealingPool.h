@@ -0,0 +1,198 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Fixed worker pool that runs batches of indexed jobs, balanced by
+ * work stealing
+ *
+ * run(count, job) calls job(i) for every i in [0, count) and returns when
+ * all are done. Item i is queued to worker i % threads, so the same item
+ * lands on the same worker batch after batch and stays warm in its cache.
+ * A worker takes its own items from the back of its queue; once that is
+ * empty it steals from the front of the others', so one slow item does
+ * not leave the rest of the pool idle. Meant for many small jobs per
+ * batch at a fixed rate (server ticks); ThreadPool is the pool for
+ * one-off background work.
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class WorkStealingPool {
+   public:
+    struct WorkerStats {
+        std::uint64_t busyNs = 0;  // Time spent with items to run
+        std::uint64_t items = 0;
+        std::uint64_t steals = 0;  // Items taken from another worker
+    };
+
+   private:
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<std::size_t> items;
+        std::atomic<std::uint64_t> busyNs{0};
+        std::atomic<std::uint64_t> ran{0};
+        std::atomic<std::uint64_t> steals{0};
+    };
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::vector<std::thread> mThreads;
+
+    // The current batch: a type-erased job, without allocating per run
+    void (*mInvoke)(void*, std::size_t) = nullptr;
+    void* mJob = nullptr;
+    std::atomic<std::size_t> mPending{0};
+
+    std::mutex mMutex;
+    std::condition_variable mStart;
+    std::condition_variable mFinished;
+    std::uint64_t mBatch = 0;
+    bool mStopping = false;
+
+    bool pop(std::size_t self, std::size_t& item) {
+        Worker& worker = *mWorkers[self];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.items.empty()) return false;
+        item = worker.items.back();
+        worker.items.pop_back();
+        return true;
+    }
+
+    bool steal(std::size_t self, std::size_t& item) {
+        for (std::size_t k = 1; k < mWorkers.size(); ++k) {
+            Worker& victim = *mWorkers[(self + k) % mWorkers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.items.empty()) continue;
+            item = victim.items.front();
+            victim.items.pop_front();
+            mWorkers[self]->steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(std::size_t self) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mStart.wait(lock,
+                            [&] { return mStopping || mBatch != seen; });
+                if (mStopping) return;
+                seen = mBatch;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            std::uint64_t ran = 0;
+            std::size_t item;
+            while (pop(self, item) || steal(self, item)) {
+                mInvoke(mJob, item);
+                ++ran;
+                if (mPending.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    mFinished.notify_all();
+                }
+            }
+            Worker& worker = *mWorkers[self];
+            worker.ran.fetch_add(ran, std::memory_order_relaxed);
+            worker.busyNs.fetch_add(
+                static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count()),
+                std::memory_order_relaxed);
+        }
+    }
+
+   public:
+    /**
+     * @param threadCount Workers; at least one is started
+     */
+    explicit WorkStealingPool(std::size_t threadCount) {
+        threadCount = std::max<std::size_t>(threadCount, 1);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            mWorkers.push_back(std::make_unique<Worker>());
+        }
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            mThreads.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mStart.notify_all();
+        for (std::thread& thread : mThreads) thread.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    std::size_t getThreadCount() const { return mWorkers.size(); }
+
+    /**
+     * @brief Call @p job(i) for i in [0, count) on the workers; blocks
+     * until every call has returned. Not reentrant.
+     */
+    template <typename Job>
+    void run(std::size_t count, Job&& job) {
+        if (count == 0) return;
+        using JobType = std::remove_reference_t<Job>;
+        mInvoke = [](void* context, std::size_t item) {
+            (*static_cast<JobType*>(context))(item);
+        };
+        mJob = const_cast<void*>(static_cast<const void*>(&job));
+        // Before the items: a worker still leaving the last batch may
+        // already take one
+        mPending.store(count);
+
+        for (std::size_t w = 0; w < mWorkers.size(); ++w) {
+            Worker& worker = *mWorkers[w];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            for (std::size_t i = w; i < count; i += mWorkers.size()) {
+                worker.items.push_back(i);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mMutex);
+        ++mBatch;
+        mStart.notify_all();
+        mFinished.wait(lock, [this] { return mPending.load() == 0; });
+    }
+
+    /**
+     * @brief Totals for one worker since construction
+     */
+    WorkerStats getStats(std::size_t worker) const {
+        const Worker& w = *mWorkers[worker];
+        WorkerStats stats;
+        stats.busyNs = w.busyNs.load(std::memory_order_relaxed);
+        stats.items = w.ran.load(std::memory_order_relaxed);
+        stats.steals = w.steals.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /**
+     * @brief All workers summed
+     */
+    WorkerStats getTotals() const {
+        WorkerStats total;
+        for (std::size_t i = 0; i < mWorkers.size(); ++i) {
+            const WorkerStats stats = getStats(i);
+            total.busyNs += stats.busyNs;
+            total.items += stats.items;
+            total.steals += stats.steals;
+        }
+        return total;
+    }
+};
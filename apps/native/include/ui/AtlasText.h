@@ -0,0 +1,214 @@
+/**
+ * @file AtlasText.h
+ * @brief Text drawn from a GlyphAtlas
+ *
+ * A stand-in for sf::Text that lays out glyphs the same way but only ever
+ * reads metrics and pixels from a prewarmed GlyphAtlas, so drawing never
+ * rasterizes. Geometry is rebuilt only when the string, size or atlas
+ * changes; a colour change just rewrites vertex colours.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+
+#include "ui/GlyphAtlas.h"
+
+class AtlasText : public sf::Drawable, public sf::Transformable {
+   private:
+    const GlyphAtlas* mAtlas;
+    sf::String mString;
+    unsigned mCharacterSize;
+    sf::Color mFillColor;
+
+    mutable sf::VertexArray mVertices;
+    mutable sf::FloatRect mBounds;
+    mutable bool mGeometryNeedUpdate;
+    mutable unsigned mAtlasGeneration;
+
+    /**
+     * @brief Two triangles per glyph, with sf::Text's 1px bleed margin
+     */
+    void addGlyphQuad(sf::Vector2f position, const AtlasGlyph& glyph) const {
+        const float padding = 1.f;
+        const float left = glyph.bounds.left - padding;
+        const float top = glyph.bounds.top - padding;
+        const float right = glyph.bounds.left + glyph.bounds.width + padding;
+        const float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+
+        const float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+        const float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+        const float u2 = static_cast<float>(glyph.textureRect.left +
+                                            glyph.textureRect.width) +
+                         padding;
+        const float v2 = static_cast<float>(glyph.textureRect.top +
+                                            glyph.textureRect.height) +
+                         padding;
+
+        const sf::Vector2f topLeft(position.x + left, position.y + top);
+        const sf::Vector2f topRight(position.x + right, position.y + top);
+        const sf::Vector2f bottomLeft(position.x + left, position.y + bottom);
+        const sf::Vector2f bottomRight(position.x + right,
+                                       position.y + bottom);
+
+        mVertices.append(sf::Vertex(topLeft, mFillColor, {u1, v1}));
+        mVertices.append(sf::Vertex(topRight, mFillColor, {u2, v1}));
+        mVertices.append(sf::Vertex(bottomLeft, mFillColor, {u1, v2}));
+        mVertices.append(sf::Vertex(bottomLeft, mFillColor, {u1, v2}));
+        mVertices.append(sf::Vertex(topRight, mFillColor, {u2, v1}));
+        mVertices.append(sf::Vertex(bottomRight, mFillColor, {u2, v2}));
+    }
+
+    void ensureGeometryUpdate() const {
+        if (mAtlas == nullptr) return;
+        if (!mGeometryNeedUpdate &&
+            mAtlasGeneration == mAtlas->getGeneration()) {
+            return;
+        }
+        mGeometryNeedUpdate = false;
+        mAtlasGeneration = mAtlas->getGeneration();
+
+        mVertices.clear();
+        mBounds = sf::FloatRect();
+        if (mString.isEmpty()) return;
+
+        const AtlasGlyph* space = mAtlas->getGlyph(U' ', mCharacterSize);
+        const float whitespaceWidth = space ? space->advance : 0.f;
+        const float lineSpacing = mAtlas->getLineSpacing(mCharacterSize);
+
+        // Same walk as sf::Text::ensureGeometryUpdate
+        float x = 0.f;
+        float y = static_cast<float>(mCharacterSize);
+        float minX = static_cast<float>(mCharacterSize);
+        float minY = static_cast<float>(mCharacterSize);
+        float maxX = 0.f;
+        float maxY = 0.f;
+        sf::Uint32 prevChar = 0;
+
+        for (std::size_t i = 0; i < mString.getSize(); ++i) {
+            const sf::Uint32 curChar = mString[i];
+            if (curChar == U'\r') continue;
+
+            x += mAtlas->getKerning(prevChar, curChar, mCharacterSize);
+            prevChar = curChar;
+
+            if (curChar == U' ' || curChar == U'\n' || curChar == U'\t') {
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                switch (curChar) {
+                    case U' ':
+                        x += whitespaceWidth;
+                        break;
+                    case U'\t':
+                        x += whitespaceWidth * 4;
+                        break;
+                    case U'\n':
+                        y += lineSpacing;
+                        x = 0;
+                        break;
+                }
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+                continue;
+            }
+
+            const AtlasGlyph* glyph = mAtlas->getGlyph(curChar, mCharacterSize);
+            if (glyph == nullptr) {
+                mAtlas->reportMissing(curChar, mCharacterSize);
+                continue;
+            }
+            addGlyphQuad(sf::Vector2f(x, y), *glyph);
+
+            const float left = glyph->bounds.left;
+            const float top = glyph->bounds.top;
+            minX = std::min(minX, x + left);
+            maxX = std::max(maxX, x + left + glyph->bounds.width);
+            minY = std::min(minY, y + top);
+            maxY = std::max(maxY, y + top + glyph->bounds.height);
+
+            x += glyph->advance;
+        }
+
+        mBounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+    }
+
+   public:
+    AtlasText()
+        : mAtlas(nullptr),
+          mCharacterSize(30),
+          mFillColor(sf::Color::White),
+          mVertices(sf::Triangles),
+          mGeometryNeedUpdate(false),
+          mAtlasGeneration(0) {}
+
+    void setAtlas(const GlyphAtlas& atlas) {
+        if (mAtlas == &atlas) return;
+        mAtlas = &atlas;
+        mGeometryNeedUpdate = true;
+    }
+
+    void setString(const sf::String& string) {
+        if (mString == string) return;
+        mString = string;
+        mGeometryNeedUpdate = true;
+    }
+
+    /**
+     * @brief Latin-1 text, copied into the existing string's storage: no
+     * allocation once it has held a string this long
+     */
+    void setString(const char* text) {
+        std::size_t length = 0;
+        while (text[length] != '\0' && length < mString.getSize() &&
+               mString[length] == static_cast<unsigned char>(text[length])) {
+            ++length;
+        }
+        if (text[length] == '\0' && length == mString.getSize()) return;
+
+        mString.clear();
+        for (const char* c = text; *c != '\0'; ++c) {
+            mString += sf::String(
+                static_cast<sf::Uint32>(static_cast<unsigned char>(*c)));
+        }
+        mGeometryNeedUpdate = true;
+    }
+
+    void setCharacterSize(unsigned size) {
+        if (mCharacterSize == size) return;
+        mCharacterSize = size;
+        mGeometryNeedUpdate = true;
+    }
+
+    void setFillColor(const sf::Color& color) {
+        if (mFillColor == color) return;
+        mFillColor = color;
+        if (!mGeometryNeedUpdate) {
+            for (std::size_t i = 0; i < mVertices.getVertexCount(); ++i) {
+                mVertices[i].color = mFillColor;
+            }
+        }
+    }
+
+    const sf::String& getString() const { return mString; }
+    unsigned getCharacterSize() const { return mCharacterSize; }
+    const sf::Color& getFillColor() const { return mFillColor; }
+
+    sf::FloatRect getLocalBounds() const {
+        ensureGeometryUpdate();
+        return mBounds;
+    }
+
+    sf::FloatRect getGlobalBounds() const {
+        return getTransform().transformRect(getLocalBounds());
+    }
+
+   protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        if (mAtlas == nullptr) return;
+        ensureGeometryUpdate();
+
+        states.transform *= getTransform();
+        states.texture = &mAtlas->getTexture();
+        target.draw(mVertices, states);
+    }
+};
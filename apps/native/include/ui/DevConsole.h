@@ -0,0 +1,141 @@
+/**
+ * @file DevConsole.h
+ * @brief In-game overlay for editing cvars at runtime
+ *
+ * One slider per numeric cvar and one toggle button per bool, stacked in
+ * a panel at the right edge of the screen, plus a button that saves the
+ * current values to the profile. The widgets are built the first time
+ * the console opens, so it costs nothing until it is used.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "systems/CVarRegistry.h"
+#include "ui/Layout.h"
+#include "ui/UI.h"
+#include "ui/UIDispatcher.h"
+
+class DevConsole {
+   private:
+    static constexpr float WIDGET_WIDTH = 280.f;
+    static constexpr float MARGIN = 10.f;
+
+    CVarRegistry& mCVars;
+    std::string mProfilePath;
+
+    std::shared_ptr<Panel> mPanel;
+    UIDispatcher mDispatcher;
+    // Pull current cvar values into the widgets
+    std::vector<std::function<void()>> mRefreshers;
+    bool mOpen;
+
+    static std::string describe(const CVar& var) {
+        if (var.type == CVarType::BOOL) {
+            return var.name + ": " + (var.get() != 0.f ? "ON" : "OFF");
+        }
+        return var.name + " = " + CVarRegistry::format(var);
+    }
+
+    void build(const sf::RenderTarget& target) {
+        mPanel = std::make_shared<Panel>(sf::Vector2f(), sf::Vector2f(),
+                                         sf::Color(20, 20, 30, 220));
+        mPanel->setLayout(std::make_unique<StackLayout>(
+            StackLayout::Axis::VERTICAL, 8.f, StackLayout::Align::STRETCH));
+
+        // Registration is over by the time the console opens, so
+        // pointers into the registry stay valid
+        for (CVar& entry : mCVars.getAll()) {
+            CVar* var = &entry;
+            if (var->type == CVarType::BOOL) {
+                auto button = std::make_shared<Button>(
+                    describe(*var), sf::Vector2f(),
+                    sf::Vector2f(WIDGET_WIDTH, 36.f));
+                Button* raw = button.get();
+                button->setCallback([var, raw] {
+                    var->set(var->get() != 0.f ? 0.f : 1.f);
+                    raw->setText(describe(*var));
+                });
+                mRefreshers.push_back(
+                    [var, raw] { raw->setText(describe(*var)); });
+                mPanel->addChild(button);
+            } else {
+                auto slider = std::make_shared<Slider>(
+                    describe(*var), sf::Vector2f(), WIDGET_WIDTH, var->min,
+                    var->max, var->get());
+                Slider* raw = slider.get();
+                slider->setCallback([var, raw](float value) {
+                    var->set(value);
+                    raw->setLabel(describe(*var));
+                });
+                mRefreshers.push_back([var, raw] {
+                    raw->setValue(var->get());
+                    raw->setLabel(describe(*var));
+                });
+                mPanel->addChild(slider);
+            }
+        }
+
+        auto save = std::make_shared<Button>(
+            "Save profile", sf::Vector2f(), sf::Vector2f(WIDGET_WIDTH, 36.f),
+            [this] { mCVars.saveProfile(mProfilePath); });
+        save->setColors(sf::Color(40, 90, 60), sf::Color(60, 130, 90),
+                        sf::Color(30, 70, 45));
+        mPanel->addChild(save);
+
+        const sf::Vector2f size = mPanel->measure();
+        const sf::View& view = target.getView();
+        const sf::Vector2f topRight(
+            view.getCenter().x + view.getSize().x / 2.f,
+            view.getCenter().y - view.getSize().y / 2.f);
+        mPanel->setSize(size);
+        mPanel->setPosition(
+            sf::Vector2f(topRight.x - size.x - MARGIN, topRight.y + MARGIN));
+        mDispatcher.addRoot(mPanel);
+    }
+
+   public:
+    DevConsole(CVarRegistry& cvars, const std::string& profilePath)
+        : mCVars(cvars), mProfilePath(profilePath), mOpen(false) {}
+
+    void toggle(const sf::RenderTarget& target) {
+        mOpen = !mOpen;
+        if (!mOpen) return;
+        if (!mPanel) build(target);
+        for (auto& refresh : mRefreshers) refresh();
+    }
+
+    bool isOpen() const { return mOpen; }
+
+    /**
+     * @brief Re-bind every widget's text (after the font was reloaded)
+     */
+    void setFont(const sf::Font& font) {
+        if (mPanel) mPanel->setFont(font);
+    }
+
+    /**
+     * @return true if the event was used by the console
+     */
+    bool handleEvent(const sf::Event& event, const sf::RenderTarget& target) {
+        if (!mOpen) return false;
+        return mDispatcher.handleEvent(event, target);
+    }
+
+    /**
+     * @brief Whether @p point is over the open console
+     */
+    bool contains(const sf::Vector2f& point) const {
+        return mOpen && mPanel &&
+               sf::FloatRect(mPanel->getPosition(), mPanel->getSize())
+                   .contains(point);
+    }
+
+    void render(sf::RenderTarget& target) {
+        if (mOpen) mPanel->render(target);
+    }
+};
@@ -0,0 +1,330 @@
+/**
+ * @file GlyphAtlas.h
+ * @brief Pre-rasterized glyphs for hitch-free text
+ *
+ * sf::Text rasterizes each new character/size pair with FreeType the
+ * first time it is drawn and uploads it, which shows up as a hitch. A
+ * GlyphAtlas instead holds every glyph the game needs in one texture:
+ * loaded from the atlas baked at build time, with prewarm() filling any
+ * gaps from the font during startup. AtlasText draws straight from it.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "systems/Lz4Lite.h"
+#include "ui/GlyphAtlasFormat.h"
+
+/**
+ * @brief Glyph metrics and its place in the atlas (cf. sf::Glyph)
+ */
+struct AtlasGlyph {
+    float advance;
+    sf::FloatRect bounds;
+    sf::IntRect textureRect;
+    int lsbDelta;
+    int rsbDelta;
+};
+
+class GlyphAtlas {
+   private:
+    static constexpr unsigned WIDTH = 1024;
+
+    sf::Image mImage;
+    sf::Texture mTexture;
+    ShelfPacker mPacker;
+    unsigned mPackerTop;  // Prewarmed glyphs go below the baked ones
+
+    std::unordered_map<std::uint64_t, AtlasGlyph> mGlyphs;
+    std::unordered_map<std::uint64_t, float> mKerning;
+    std::unordered_map<unsigned, float> mLineSpacing;
+    unsigned mGeneration;
+
+    mutable std::unordered_set<std::uint64_t> mReportedMisses;
+
+    static std::uint64_t glyphKey(std::uint32_t codepoint, unsigned size) {
+        return (static_cast<std::uint64_t>(size) << 32) | codepoint;
+    }
+
+    static std::uint64_t pairKey(std::uint32_t first, std::uint32_t second,
+                                 unsigned size) {
+        return (static_cast<std::uint64_t>(size) << 42) |
+               (static_cast<std::uint64_t>(first) << 21) | second;
+    }
+
+    /**
+     * @brief What sf::Font::getKerning returns when the font has no kerning
+     * table entry for the pair: only the auto-hinter correction
+     */
+    static float deltaKerning(const AtlasGlyph& first,
+                              const AtlasGlyph& second, float kerning = 0.f) {
+        return std::floor(
+            (second.lsbDelta - first.rsbDelta + kerning + 32) / 64.f);
+    }
+
+    void growImage(unsigned height) {
+        if (height <= mImage.getSize().y) return;
+
+        sf::Image grown;
+        grown.create(WIDTH, height, sf::Color(255, 255, 255, 0));
+        if (mImage.getSize().y > 0) {
+            grown.copy(mImage, 0, 0);
+        }
+        mImage = grown;
+    }
+
+   public:
+    GlyphAtlas() : mPacker(WIDTH), mPackerTop(0), mGeneration(0) {}
+
+    /**
+     * @brief Load an atlas written by FallingFuryAtlasBaker
+     * @return false if the file is missing or invalid (prewarm() still
+     * works, it just has to rasterize everything)
+     */
+    bool loadFromFile(const std::string& filepath) {
+        if (!readFromFile(filepath)) return false;
+        uploadTexture();
+        return true;
+    }
+
+    /**
+     * @brief CPU half of loadFromFile(): parse and decompress only
+     *
+     * Touches no GL state, so it can run on a worker during startup;
+     * call uploadTexture() on the game thread afterwards.
+     */
+    bool readFromFile(const std::string& filepath) {
+        std::ifstream file(filepath, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "ERROR::GLYPHATLAS::No baked atlas: " << filepath
+                      << "\n";
+            return false;
+        }
+
+        AtlasHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || std::memcmp(header.magic, ATLAS_MAGIC, 4) != 0 ||
+            header.version != ATLAS_VERSION || header.width != WIDTH) {
+            std::cerr << "ERROR::GLYPHATLAS::Invalid atlas: " << filepath
+                      << "\n";
+            return false;
+        }
+
+        std::vector<AtlasSizeRecord> sizes(header.sizeCount);
+        std::vector<AtlasGlyphRecord> glyphs(header.glyphCount);
+        std::vector<AtlasKerningRecord> kerning(header.kerningCount);
+        std::vector<std::uint8_t> stored(header.pixelBytes);
+        file.read(reinterpret_cast<char*>(sizes.data()),
+                  static_cast<std::streamsize>(sizes.size() * sizeof(sizes[0])));
+        file.read(
+            reinterpret_cast<char*>(glyphs.data()),
+            static_cast<std::streamsize>(glyphs.size() * sizeof(glyphs[0])));
+        file.read(
+            reinterpret_cast<char*>(kerning.data()),
+            static_cast<std::streamsize>(kerning.size() * sizeof(kerning[0])));
+        file.read(reinterpret_cast<char*>(stored.data()),
+                  static_cast<std::streamsize>(stored.size()));
+
+        std::vector<std::uint8_t> alpha(
+            static_cast<std::size_t>(header.width) * header.height);
+        const bool pixelsOk =
+            (header.flags & ATLAS_PIXELS_LZ4)
+                ? Lz4Lite::decompress(stored.data(), stored.size(),
+                                      alpha.data(), alpha.size())
+                : stored.size() == alpha.size();
+        if (!file || !pixelsOk) {
+            std::cerr << "ERROR::GLYPHATLAS::Truncated atlas: " << filepath
+                      << "\n";
+            return false;
+        }
+        if (!(header.flags & ATLAS_PIXELS_LZ4)) alpha.swap(stored);
+
+        clear();
+        std::vector<std::uint8_t> rgba(alpha.size() * 4, 255);
+        for (std::size_t i = 0; i < alpha.size(); ++i) {
+            rgba[i * 4 + 3] = alpha[i];
+        }
+        mImage.create(header.width, header.height, rgba.data());
+        mPackerTop = header.height;
+
+        for (const AtlasSizeRecord& size : sizes) {
+            mLineSpacing[size.characterSize] = size.lineSpacing;
+        }
+        for (const AtlasGlyphRecord& r : glyphs) {
+            mGlyphs[glyphKey(r.codepoint, r.characterSize)] = {
+                r.advance,
+                sf::FloatRect(r.left, r.top, r.width, r.height),
+                sf::IntRect(r.x, r.y, r.width, r.height),
+                r.lsbDelta,
+                r.rsbDelta};
+        }
+        for (const AtlasKerningRecord& k : kerning) {
+            const AtlasGlyph* first = getGlyph(k.first, k.characterSize);
+            const AtlasGlyph* second = getGlyph(k.second, k.characterSize);
+            if (first && second) {
+                mKerning[pairKey(k.first, k.second, k.characterSize)] =
+                    deltaKerning(*first, *second,
+                                 static_cast<float>(k.kerning));
+            }
+        }
+
+        std::cout << "Loaded glyph atlas: " << filepath << " ("
+                  << glyphs.size() << " glyphs)\n";
+        return true;
+    }
+
+    /**
+     * @brief Upload the atlas image to the GPU (game thread)
+     */
+    void uploadTexture() {
+        mTexture.loadFromImage(mImage);
+        mTexture.setSmooth(true);
+        ++mGeneration;
+    }
+
+    /**
+     * @brief Add any glyphs of @p chars at @p size that are not yet in the
+     * atlas, rasterizing them through the font
+     *
+     * Call during loading. Reads the font's glyph page back from the GPU
+     * once per call, so it must not run mid-game.
+     * @return Number of glyphs added
+     */
+    std::size_t prewarm(const sf::Font& font, unsigned size,
+                        const std::string& chars = std::string()) {
+        std::vector<std::uint32_t> missing;
+        auto consider = [&](std::uint32_t c) {
+            if (!getGlyph(c, size)) missing.push_back(c);
+        };
+        if (chars.empty()) {
+            for (std::uint32_t c = ATLAS_FIRST_CHAR; c <= ATLAS_LAST_CHAR; ++c)
+                consider(c);
+        } else {
+            for (unsigned char c : chars) consider(c);
+        }
+        if (missing.empty()) return 0;
+
+        // Rasterize into the font's own page first, then copy out
+        std::vector<sf::Glyph> rendered;
+        for (std::uint32_t c : missing) {
+            rendered.push_back(font.getGlyph(c, size, false));
+        }
+        const sf::Image page = font.getTexture(size).copyToImage();
+
+        for (std::size_t i = 0; i < missing.size(); ++i) {
+            const sf::Glyph& glyph = rendered[i];
+            const sf::IntRect& source = glyph.textureRect;
+            unsigned x = 0, y = 0;
+            if (source.width > 0 && source.height > 0) {
+                mPacker.insert(source.width + 2 * ATLAS_GLYPH_PADDING,
+                               source.height + 2 * ATLAS_GLYPH_PADDING, x, y);
+                x += ATLAS_GLYPH_PADDING;
+                y += mPackerTop + ATLAS_GLYPH_PADDING;
+                growImage((mPackerTop + mPacker.getHeight() + 63) & ~63u);
+                mImage.copy(page, x, y, source);
+            }
+            mGlyphs[glyphKey(missing[i], size)] = {
+                glyph.advance, glyph.bounds,
+                sf::IntRect(x, y, source.width, source.height),
+                glyph.lsbDelta, glyph.rsbDelta};
+        }
+
+        // Kerning for every pair involving a new glyph
+        for (std::uint32_t a = ATLAS_FIRST_CHAR; a <= ATLAS_LAST_CHAR; ++a) {
+            for (std::uint32_t b : missing) {
+                const AtlasGlyph* first = getGlyph(a, size);
+                const AtlasGlyph* second = getGlyph(b, size);
+                if (!first || !second) continue;
+                const float forward = font.getKerning(a, b, size);
+                if (forward != deltaKerning(*first, *second)) {
+                    mKerning[pairKey(a, b, size)] = forward;
+                }
+                const float backward = font.getKerning(b, a, size);
+                if (backward != deltaKerning(*second, *first)) {
+                    mKerning[pairKey(b, a, size)] = backward;
+                }
+            }
+        }
+        mLineSpacing[size] = font.getLineSpacing(size);
+
+        uploadTexture();
+        return missing.size();
+    }
+
+    /**
+     * @brief Rasterize glyphs into the font's own pages up front, for
+     * widgets that still draw with sf::Text
+     */
+    static void prewarmFont(const sf::Font& font, unsigned size) {
+        for (std::uint32_t c = ATLAS_FIRST_CHAR; c <= ATLAS_LAST_CHAR; ++c) {
+            font.getGlyph(c, size, false);
+        }
+    }
+
+    /**
+     * @return The glyph, or nullptr if it was neither baked nor prewarmed
+     */
+    const AtlasGlyph* getGlyph(std::uint32_t codepoint, unsigned size) const {
+        auto it = mGlyphs.find(glyphKey(codepoint, size));
+        return it != mGlyphs.end() ? &it->second : nullptr;
+    }
+
+    /**
+     * @brief Horizontal offset between two glyphs, as sf::Font::getKerning
+     */
+    float getKerning(std::uint32_t first, std::uint32_t second,
+                     unsigned size) const {
+        if (first == 0 || second == 0) return 0.f;
+        auto it = mKerning.find(pairKey(first, second, size));
+        if (it != mKerning.end()) return it->second;
+
+        const AtlasGlyph* a = getGlyph(first, size);
+        const AtlasGlyph* b = getGlyph(second, size);
+        return a && b ? deltaKerning(*a, *b) : 0.f;
+    }
+
+    float getLineSpacing(unsigned size) const {
+        auto it = mLineSpacing.find(size);
+        return it != mLineSpacing.end() ? it->second : static_cast<float>(size);
+    }
+
+    /**
+     * @brief Log a glyph that had to be skipped (once per glyph)
+     */
+    void reportMissing(std::uint32_t codepoint, unsigned size) const {
+        if (mReportedMisses.insert(glyphKey(codepoint, size)).second) {
+            std::cerr << "ERROR::GLYPHATLAS::Glyph " << codepoint << " at "
+                      << size << "px was not prewarmed\n";
+        }
+    }
+
+    const sf::Texture& getTexture() const { return mTexture; }
+
+    /**
+     * @brief Bumped whenever glyphs move or change, so text can re-layout
+     */
+    unsigned getGeneration() const { return mGeneration; }
+
+    /**
+     * @brief Forget every glyph (e.g. after the font was hot reloaded)
+     */
+    void clear() {
+        mImage = sf::Image();
+        mPacker = ShelfPacker(WIDTH);
+        mPackerTop = 0;
+        mGlyphs.clear();
+        mKerning.clear();
+        mLineSpacing.clear();
+        mReportedMisses.clear();
+        ++mGeneration;
+    }
+};
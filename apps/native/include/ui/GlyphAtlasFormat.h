@@ -0,0 +1,133 @@
+/**
+ * @file GlyphAtlasFormat.h
+ * @brief On-disk layout of a baked glyph atlas (.ffga)
+ *
+ * Written by FallingFuryAtlasBaker at build time and read by GlyphAtlas.
+ * Kept free of SFML so the baker only needs FreeType.
+ *
+ * Layout (little-endian):
+ *   AtlasHeader
+ *   AtlasSizeRecord  [sizeCount]
+ *   AtlasGlyphRecord [glyphCount]
+ *   AtlasKerningRecord [kerningCount]
+ *   alpha pixels, width * height bytes, LZ4 block if ATLAS_PIXELS_LZ4
+ *
+ * Metrics follow sf::Font exactly (same FreeType load flags, bounds and
+ * advance rounding), so atlas text lays out like sf::Text.
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+constexpr char ATLAS_MAGIC[4] = {'F', 'F', 'G', 'A'};
+constexpr std::uint16_t ATLAS_VERSION = 1;
+constexpr std::uint16_t ATLAS_PIXELS_LZ4 = 1u << 0;
+
+// Empty pixels around each glyph so smoothing does not bleed
+constexpr unsigned ATLAS_GLYPH_PADDING = 2;
+
+// Glyphs baked when no charset is given: printable ASCII
+constexpr std::uint32_t ATLAS_FIRST_CHAR = 32;
+constexpr std::uint32_t ATLAS_LAST_CHAR = 126;
+
+#pragma pack(push, 1)
+struct AtlasHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t flags;
+    std::uint16_t width;
+    std::uint16_t height;
+    std::uint32_t sizeCount;
+    std::uint32_t glyphCount;
+    std::uint32_t kerningCount;
+    std::uint32_t pixelBytes;  // Stored size of the pixel block
+};
+
+struct AtlasSizeRecord {
+    std::uint32_t characterSize;
+    float lineSpacing;
+};
+
+struct AtlasGlyphRecord {
+    std::uint32_t codepoint;
+    std::uint32_t characterSize;
+    float advance;
+    // Bounds relative to the baseline (top is negative), as sf::Glyph
+    std::int16_t left;
+    std::int16_t top;
+    std::uint16_t width;
+    std::uint16_t height;
+    // Position in the atlas, padding excluded
+    std::uint16_t x;
+    std::uint16_t y;
+    // Auto-hinter side bearing changes, used for kerning (26.6)
+    std::int16_t lsbDelta;
+    std::int16_t rsbDelta;
+};
+
+// Only pairs with a non-zero kerning table entry are stored
+struct AtlasKerningRecord {
+    std::uint32_t first;
+    std::uint32_t second;
+    std::uint32_t characterSize;
+    std::int32_t kerning;  // Unfitted, 26.6
+};
+#pragma pack(pop)
+
+static_assert(sizeof(AtlasHeader) == 28, "AtlasHeader layout changed");
+static_assert(sizeof(AtlasGlyphRecord) == 28, "AtlasGlyphRecord layout changed");
+
+/**
+ * @brief Shelf packer for glyph rectangles
+ *
+ * Glyphs of one size have similar heights, so rows ("shelves") of
+ * tallest-so-far height pack them with little waste.
+ */
+class ShelfPacker {
+   private:
+    struct Shelf {
+        unsigned y;
+        unsigned height;
+        unsigned x;
+    };
+
+    unsigned mWidth;
+    unsigned mHeight;
+    std::vector<Shelf> mShelves;
+
+   public:
+    explicit ShelfPacker(unsigned width, unsigned height = 0)
+        : mWidth(width), mHeight(height) {}
+
+    /**
+     * @brief Find room for a rectangle, growing the height if needed
+     * @return false if the rectangle is wider than the atlas
+     */
+    bool insert(unsigned width, unsigned height, unsigned& x, unsigned& y) {
+        if (width > mWidth) return false;
+
+        for (Shelf& shelf : mShelves) {
+            // Reuse shelves that are not more than a third taller
+            if (height <= shelf.height && height * 3 >= shelf.height * 2 &&
+                shelf.x + width <= mWidth) {
+                x = shelf.x;
+                y = shelf.y;
+                shelf.x += width;
+                return true;
+            }
+        }
+
+        const unsigned top = mShelves.empty()
+                                 ? 0
+                                 : mShelves.back().y + mShelves.back().height;
+        mShelves.push_back({top, height, width});
+        if (top + height > mHeight) mHeight = top + height;
+        x = 0;
+        y = top;
+        return true;
+    }
+
+    unsigned getWidth() const { return mWidth; }
+    unsigned getHeight() const { return mHeight; }
+};
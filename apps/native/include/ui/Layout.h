@@ -0,0 +1,208 @@
+/**
+ * @file Layout.h
+ * @brief Stack and grid layouts for Panel
+ *
+ * Layout is two passes: measure() asks every visible child for its
+ * preferred size, arrange() hands out rectangles. Panel caches the
+ * measured size and only re-runs a layout when one of its children
+ * changed size or content, or when the panel itself was moved or
+ * resized, so relayout cost follows what changed.
+ *
+ *   auto menu = std::make_shared<Panel>(sf::Vector2f(), sf::Vector2f());
+ *   menu->setLayout(std::make_unique<StackLayout>(StackLayout::Axis::VERTICAL));
+ *   menu->addChild(playButton);
+ *   fitToWindow(*menu, window);  // Again on sf::Event::Resized
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <vector>
+
+#include "ui/UI.h"
+
+/**
+ * @brief Children one after another along an axis
+ *
+ * Children get their measured size along the axis; any space left over is
+ * shared between children with a non-zero flex, in proportion to it.
+ */
+class StackLayout : public Layout {
+   public:
+    enum class Axis { HORIZONTAL, VERTICAL };
+    enum class Align { START, CENTER, END, STRETCH };
+
+   private:
+    Axis mAxis;
+    float mSpacing;
+    Align mAlign;  // Across the axis
+
+    float along(const sf::Vector2f& v) const {
+        return mAxis == Axis::HORIZONTAL ? v.x : v.y;
+    }
+    float across(const sf::Vector2f& v) const {
+        return mAxis == Axis::HORIZONTAL ? v.y : v.x;
+    }
+    sf::Vector2f make(float alongValue, float acrossValue) const {
+        return mAxis == Axis::HORIZONTAL
+                   ? sf::Vector2f(alongValue, acrossValue)
+                   : sf::Vector2f(acrossValue, alongValue);
+    }
+
+   public:
+    explicit StackLayout(Axis axis, float spacing = 10.f,
+                         Align align = Align::CENTER)
+        : mAxis(axis), mSpacing(spacing), mAlign(align) {}
+
+    sf::Vector2f measure(const Children& children) override {
+        float length = 0.f;
+        float thickness = 0.f;
+        int count = 0;
+        for (const auto& child : children) {
+            if (!child->isVisible()) continue;
+            const sf::Vector2f size = child->measure();
+            length += along(size);
+            thickness = std::max(thickness, across(size));
+            ++count;
+        }
+        if (count > 1) length += mSpacing * (count - 1);
+        return make(length, thickness);
+    }
+
+    void arrange(const Children& children,
+                 const sf::FloatRect& area) override {
+        const sf::Vector2f origin(area.left, area.top);
+        const sf::Vector2f extent(area.width, area.height);
+
+        float used = 0.f;
+        float totalFlex = 0.f;
+        int count = 0;
+        for (const auto& child : children) {
+            if (!child->isVisible()) continue;
+            used += along(child->measure());
+            totalFlex += child->getFlex();
+            ++count;
+        }
+        if (count > 1) used += mSpacing * (count - 1);
+        const float spare = std::max(0.f, along(extent) - used);
+
+        float cursor = along(origin);
+        for (const auto& child : children) {
+            if (!child->isVisible()) continue;
+            const sf::Vector2f preferred = child->measure();
+
+            float length = along(preferred);
+            if (totalFlex > 0.f) length += spare * child->getFlex() / totalFlex;
+
+            float thickness = across(preferred);
+            float offset = 0.f;
+            switch (mAlign) {
+                case Align::START:
+                    break;
+                case Align::CENTER:
+                    offset = (across(extent) - thickness) / 2.f;
+                    break;
+                case Align::END:
+                    offset = across(extent) - thickness;
+                    break;
+                case Align::STRETCH:
+                    thickness = across(extent);
+                    break;
+            }
+
+            child->setSize(make(length, thickness));
+            child->setPosition(make(cursor, across(origin) + offset));
+            cursor += length + mSpacing;
+        }
+    }
+};
+
+/**
+ * @brief Children in rows of a fixed number of columns
+ *
+ * Each column is as wide as its widest child and each row as tall as its
+ * tallest; children are centred in their cell unless told to fill it.
+ */
+class GridLayout : public Layout {
+   private:
+    std::size_t mColumns;
+    float mSpacing;
+    bool mFillCells;
+
+    // From the last measure(), reused by arrange()
+    std::vector<float> mColumnWidths;
+    std::vector<float> mRowHeights;
+
+   public:
+    explicit GridLayout(std::size_t columns, float spacing = 10.f,
+                        bool fillCells = false)
+        : mColumns(std::max<std::size_t>(columns, 1)),
+          mSpacing(spacing),
+          mFillCells(fillCells) {}
+
+    sf::Vector2f measure(const Children& children) override {
+        mColumnWidths.assign(mColumns, 0.f);
+        mRowHeights.clear();
+
+        std::size_t cell = 0;
+        for (const auto& child : children) {
+            if (!child->isVisible()) continue;
+            const sf::Vector2f size = child->measure();
+            const std::size_t column = cell % mColumns;
+            const std::size_t row = cell / mColumns;
+            if (row == mRowHeights.size()) mRowHeights.push_back(0.f);
+            mColumnWidths[column] = std::max(mColumnWidths[column], size.x);
+            mRowHeights[row] = std::max(mRowHeights[row], size.y);
+            ++cell;
+        }
+
+        sf::Vector2f total;
+        for (float width : mColumnWidths) total.x += width;
+        for (float height : mRowHeights) total.y += height;
+        total.x += mSpacing * (mColumns - 1);
+        if (!mRowHeights.empty()) total.y += mSpacing * (mRowHeights.size() - 1);
+        return total;
+    }
+
+    void arrange(const Children& children,
+                 const sf::FloatRect& area) override {
+        std::size_t cell = 0;
+        float y = area.top;
+        for (std::size_t row = 0; row < mRowHeights.size(); ++row) {
+            float x = area.left;
+            for (std::size_t column = 0; column < mColumns; ++column) {
+                // Skip hidden children without using up a cell
+                while (cell < children.size() &&
+                       !children[cell]->isVisible()) {
+                    ++cell;
+                }
+                if (cell == children.size()) return;
+
+                UIElement& child = *children[cell++];
+                const sf::Vector2f cellSize(mColumnWidths[column],
+                                            mRowHeights[row]);
+                if (mFillCells) {
+                    child.setSize(cellSize);
+                    child.setPosition(sf::Vector2f(x, y));
+                } else {
+                    const sf::Vector2f size = child.measure();
+                    child.setSize(size);
+                    child.setPosition(sf::Vector2f(
+                        x + (cellSize.x - size.x) / 2.f,
+                        y + (cellSize.y - size.y) / 2.f));
+                }
+                x += mColumnWidths[column] + mSpacing;
+            }
+            y += mRowHeights[row] + mSpacing;
+        }
+    }
+};
+
+/**
+ * @brief Make @p root cover the target's view (call again on resize)
+ */
+inline void fitToWindow(UIElement& root, const sf::RenderTarget& target) {
+    const sf::View& view = target.getView();
+    root.setPosition(view.getCenter() - view.getSize() / 2.f);
+    root.setSize(view.getSize());
+}
@@ -2,18 +2,47 @@
  * @file UI.h
  * @brief Modern UI system with buttons, panels, and menus
  *
- * Provides reusable UI components for professional menu systems
+ * Provides reusable UI components for professional menu systems.
+ *
+ * The UI is retained: widgets only touch their drawables when their state
+ * actually changes, and mark themselves dirty when they do. A Panel keeps
+ * its background and children in a cached texture that is redrawn only
+ * when something inside it is dirty, so a static menu costs one draw per
+ * panel.
+ *
+ * Input can either be polled through update() or, preferably, routed
+ * through a UIDispatcher (ui/UIDispatcher.h), which calls the onMouse*()
+ * hooks only when the mouse actually moves or clicks.
+ *
+ * A Panel given a Layout (ui/Layout.h) positions its children itself:
+ * measure() reports each element's preferred size, the layout arranges
+ * them inside the panel, and both are redone only along the path of
+ * elements whose content or size changed.
  */
 
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "managers/ResourceManager.h"
 
+/**
+ * @brief Smallest rectangle holding both @p a and @p b
+ */
+inline sf::FloatRect unionRect(const sf::FloatRect& a, const sf::FloatRect& b) {
+    const float left = std::min(a.left, b.left);
+    const float top = std::min(a.top, b.top);
+    return sf::FloatRect(
+        left, top, std::max(a.left + a.width, b.left + b.width) - left,
+        std::max(a.top + a.height, b.top + b.height) - top);
+}
+
 /**
  * @brief Base UI Element class
  */
@@ -24,17 +53,156 @@ class UIElement {
     bool mVisible;
     bool mEnabled;
 
+    UIElement* mParent;  // Panel that caches this element, if any
+    bool mDirty;         // Needs redrawing since the last render
+    bool mHitTestDirty;  // Bounds/visibility changed since last indexed
+    bool mLayoutDirty;   // Children need arranging again
+    bool mMeasureDirty;  // Preferred size may have changed
+    float mFlex;         // Share of leftover space in a StackLayout
+
    public:
-    UIElement() : mVisible(true), mEnabled(true) {}
+    UIElement()
+        : mVisible(true),
+          mEnabled(true),
+          mParent(nullptr),
+          mDirty(true),
+          mHitTestDirty(true),
+          mLayoutDirty(true),
+          mMeasureDirty(true),
+          mFlex(0.f) {}
     virtual ~UIElement() = default;
 
     virtual void update(const sf::Vector2f& mousePos, bool mousePressed) = 0;
-    virtual void render(sf::RenderWindow& window) = 0;
+    virtual void render(sf::RenderTarget& target) = 0;
+
+    virtual void setPosition(const sf::Vector2f& pos) {
+        if (pos == mPosition) return;
+        mPosition = pos;
+        markDirty();
+        markHitTestDirty();
+    }
+    virtual void setSize(const sf::Vector2f& size) {
+        if (size == mSize) return;
+        mSize = size;
+        markDirty();
+        markHitTestDirty();
+    }
+    virtual void setVisible(bool visible) {
+        if (visible == mVisible) return;
+        mVisible = visible;
+        markDirty();
+        markHitTestDirty();
+        markLayoutDirty();
+    }
+    virtual void setEnabled(bool enabled) {
+        if (enabled == mEnabled) return;
+        mEnabled = enabled;
+        markDirty();
+        markHitTestDirty();
+    }
+    /**
+     * @brief Draw text with @p font from now on (e.g. after a hot reload)
+     */
+    virtual void setFont(const sf::Font& /*font*/) {}
+    /**
+     * @brief Everything render() may touch, outlines and overhangs
+     * included; a Panel sizes its cache from this
+     */
+    virtual sf::FloatRect getDrawBounds() const {
+        return sf::FloatRect(mPosition, mSize);
+    }
+
+    // Layout
+    /**
+     * @brief Preferred size, given to a parent Layout
+     */
+    virtual sf::Vector2f measure() { return mSize; }
+    /**
+     * @brief Arrange children if needed (containers only)
+     */
+    virtual void updateLayout() {
+        mLayoutDirty = false;
+        mMeasureDirty = false;
+    }
+
+    void setFlex(float flex) {
+        if (flex == mFlex) return;
+        mFlex = flex;
+        markLayoutDirty();
+    }
+    float getFlex() const { return mFlex; }
+
+    // Event hooks, called by UIDispatcher
+    /**
+     * @brief Whether the dispatcher should hit-test this element
+     */
+    virtual bool isInteractive() const { return false; }
+    virtual sf::FloatRect getHitBounds() const {
+        return sf::FloatRect(mPosition, mSize);
+    }
+    /**
+     * @brief Append this element and any interactive descendants
+     */
+    virtual void collectInteractive(std::vector<UIElement*>& out) {
+        if (isInteractive()) out.push_back(this);
+    }
+    /**
+     * @brief Whether @p element is this one or one of its descendants
+     */
+    virtual bool containsElement(const UIElement* element) const {
+        return element == this;
+    }
+    virtual void onMouseEnter() {}
+    virtual void onMouseLeave() {}
+    virtual void onMousePress(const sf::Vector2f& /*mousePos*/) {}
+    /**
+     * @brief Mouse moved while this element holds the capture
+     */
+    virtual void onMouseDrag(const sf::Vector2f& /*mousePos*/) {}
+    /**
+     * @param inside Whether the release happened over this element
+     */
+    virtual void onMouseRelease(const sf::Vector2f& /*mousePos*/,
+                                bool /*inside*/) {}
+
+    /**
+     * @brief Flag this element, and every panel caching it, for redraw
+     */
+    void markDirty() {
+        for (UIElement* element = this; element != nullptr;
+             element = element->mParent) {
+            element->mDirty = true;
+        }
+    }
+
+    /**
+     * @brief Flag the hit-test index of the root for a rebuild
+     */
+    void markHitTestDirty() {
+        for (UIElement* element = this; element != nullptr;
+             element = element->mParent) {
+            element->mHitTestDirty = true;
+        }
+    }
+
+    /**
+     * @brief This element's preferred size changed: re-measure it and
+     * re-arrange every container up to the root
+     */
+    void markLayoutDirty() {
+        for (UIElement* element = this; element != nullptr;
+             element = element->mParent) {
+            element->mLayoutDirty = true;
+            element->mMeasureDirty = true;
+        }
+    }
 
-    virtual void setPosition(const sf::Vector2f& pos) { mPosition = pos; }
-    virtual void setSize(const sf::Vector2f& size) { mSize = size; }
-    virtual void setVisible(bool visible) { mVisible = visible; }
-    virtual void setEnabled(bool enabled) { mEnabled = enabled; }
+    void setParent(UIElement* parent) { mParent = parent; }
+    bool isLayoutDirty() const { return mLayoutDirty; }
+    bool isDirty() const { return mDirty; }
+    void clearDirty() { mDirty = false; }
+    bool isHitTestDirty() const { return mHitTestDirty; }
+    void clearHitTestDirty() { mHitTestDirty = false; }
 
     bool isVisible() const { return mVisible; }
     bool isEnabled() const { return mEnabled; }
@@ -47,6 +215,8 @@ class UIElement {
  */
 class Button : public UIElement {
    private:
+    enum class State { NORMAL, HOVER, PRESSED, DISABLED };
+
     sf::RectangleShape mShape;
     sf::Text mText;
 
@@ -57,8 +227,43 @@ class Button : public UIElement {
 
     std::function<void()> mCallback;
 
+    sf::Vector2f mPreferredSize;  // As constructed; layouts may stretch mSize
+
     bool mIsHovered;
     bool mWasPressed;
+    State mState;
+
+    const sf::Color& colorFor(State state) const {
+        switch (state) {
+            case State::HOVER:
+                return mHoverColor;
+            case State::PRESSED:
+                return mPressedColor;
+            case State::DISABLED:
+                return mDisabledColor;
+            default:
+                return mNormalColor;
+        }
+    }
+
+    /**
+     * @brief Recolour only on an actual state change
+     */
+    void setState(State state) {
+        if (state == mState) return;
+        mState = state;
+        mShape.setFillColor(colorFor(state));
+        markDirty();
+    }
+
+    void centerText() {
+        sf::FloatRect textBounds = mText.getLocalBounds();
+        mText.setOrigin(textBounds.left + textBounds.width / 2.f,
+                        textBounds.top + textBounds.height / 2.f);
+        mText.setPosition(mPosition.x + mSize.x / 2.f,
+                          mPosition.y + mSize.y / 2.f);
+        markDirty();
+    }
 
    public:
     /**
@@ -70,7 +275,11 @@ class Button : public UIElement {
      */
     Button(const std::string& text, const sf::Vector2f& position,
            const sf::Vector2f& size, std::function<void()> callback = nullptr)
-        : mCallback(callback), mIsHovered(false), mWasPressed(false) {
+        : mCallback(callback),
+          mPreferredSize(size),
+          mIsHovered(false),
+          mWasPressed(false),
+          mState(State::NORMAL) {
         mPosition = position;
         mSize = size;
 
@@ -88,7 +297,8 @@ class Button : public UIElement {
         mShape.setOutlineColor(sf::Color::White);
 
         // Setup text
-        mText.setFont(ResourceManager::getInstance().getFont("main"));
+        mText.setFont(
+            ResourceManager::getInstance().getFont(ResourceIds::MAIN_FONT));
         mText.setString(text);
         mText.setCharacterSize(24);
         mText.setFillColor(sf::Color::White);
@@ -100,9 +310,29 @@ class Button : public UIElement {
         mText.setPosition(position.x + size.x / 2.f, position.y + size.y / 2.f);
     }
 
+    // The text origin is already centred, so moving is cheap
+    void setPosition(const sf::Vector2f& pos) override {
+        UIElement::setPosition(pos);
+        mShape.setPosition(pos);
+        mText.setPosition(pos.x + mSize.x / 2.f, pos.y + mSize.y / 2.f);
+    }
+
+    void setSize(const sf::Vector2f& size) override {
+        UIElement::setSize(size);
+        mShape.setSize(size);
+        mText.setPosition(mPosition.x + size.x / 2.f,
+                          mPosition.y + size.y / 2.f);
+    }
+
+    /**
+     * @brief The size the button was built with, not whatever a layout
+     * last stretched it to, so re-measuring never feeds back on itself
+     */
+    sf::Vector2f measure() override { return mPreferredSize; }
+
     void update(const sf::Vector2f& mousePos, bool mousePressed) override {
         if (!mVisible || !mEnabled) {
-            mShape.setFillColor(mDisabledColor);
+            setState(State::DISABLED);
             return;
         }
 
@@ -112,10 +342,10 @@ class Button : public UIElement {
 
         if (mIsHovered) {
             if (mousePressed) {
-                mShape.setFillColor(mPressedColor);
+                setState(State::PRESSED);
                 mWasPressed = true;
             } else {
-                mShape.setFillColor(mHoverColor);
+                setState(State::HOVER);
 
                 // Trigger callback on release
                 if (mWasPressed && mCallback) {
@@ -124,25 +354,72 @@ class Button : public UIElement {
                 mWasPressed = false;
             }
         } else {
-            mShape.setFillColor(mNormalColor);
+            setState(State::NORMAL);
             mWasPressed = false;
         }
     }
 
-    void render(sf::RenderWindow& window) override {
+    void render(sf::RenderTarget& target) override {
+        clearDirty();
         if (!mVisible) return;
 
-        window.draw(mShape);
-        window.draw(mText);
+        target.draw(mShape);
+        target.draw(mText);
+    }
+
+    void setEnabled(bool enabled) override {
+        UIElement::setEnabled(enabled);
+        if (!enabled) {
+            mIsHovered = false;
+            mWasPressed = false;
+        }
+        setState(enabled ? State::NORMAL : State::DISABLED);
+    }
+
+    bool isInteractive() const override { return mVisible && mEnabled; }
+
+    sf::FloatRect getHitBounds() const override {
+        return mShape.getGlobalBounds();
+    }
+
+    sf::FloatRect getDrawBounds() const override {
+        return unionRect(mShape.getGlobalBounds(), mText.getGlobalBounds());
+    }
+
+    void onMouseEnter() override {
+        mIsHovered = true;
+        setState(mWasPressed ? State::PRESSED : State::HOVER);
+    }
+
+    void onMouseLeave() override {
+        mIsHovered = false;
+        setState(mEnabled ? State::NORMAL : State::DISABLED);
+    }
+
+    void onMousePress(const sf::Vector2f&) override {
+        mWasPressed = true;
+        setState(State::PRESSED);
+    }
+
+    void onMouseRelease(const sf::Vector2f&, bool inside) override {
+        const bool clicked = mWasPressed && inside && mEnabled;
+        mWasPressed = false;
+        setState(!mEnabled ? State::DISABLED
+                 : inside  ? State::HOVER
+                           : State::NORMAL);
+        // Last, the callback may tear down the menu this button is in
+        if (clicked && mCallback) mCallback();
+    }
+
+    void setFont(const sf::Font& font) override {
+        mText.setFont(font);
+        centerText();
     }
 
     void setText(const std::string& text) {
+        if (mText.getString() == text) return;
         mText.setString(text);
-        sf::FloatRect textBounds = mText.getLocalBounds();
-        mText.setOrigin(textBounds.left + textBounds.width / 2.f,
-                        textBounds.top + textBounds.height / 2.f);
-        mText.setPosition(mPosition.x + mSize.x / 2.f,
-                          mPosition.y + mSize.y / 2.f);
+        centerText();
     }
 
     void setCallback(std::function<void()> callback) { mCallback = callback; }
@@ -152,9 +429,32 @@ class Button : public UIElement {
         mNormalColor = normal;
         mHoverColor = hover;
         mPressedColor = pressed;
+        mShape.setFillColor(colorFor(mState));
+        markDirty();
     }
 };
 
+/**
+ * @brief Positions the children of a Panel (see ui/Layout.h)
+ */
+class Layout {
+   public:
+    using Children = std::vector<std::shared_ptr<UIElement>>;
+
+    virtual ~Layout() = default;
+
+    /**
+     * @brief Size the children want, padding excluded
+     */
+    virtual sf::Vector2f measure(const Children& children) = 0;
+
+    /**
+     * @brief Position and size the children inside @p area
+     */
+    virtual void arrange(const Children& children,
+                         const sf::FloatRect& area) = 0;
+};
+
 /**
  * @brief Panel/Container class
  */
@@ -164,6 +464,60 @@ class Panel : public UIElement {
     std::vector<std::shared_ptr<UIElement>> mChildren;
     sf::Color mBackgroundColor;
 
+    // Optional; without one, children keep the positions they were given
+    std::unique_ptr<Layout> mLayout;
+    float mPadding;
+    sf::Vector2f mMeasured;
+
+    // Background and children, rendered once per change
+    sf::RenderTexture mCache;
+    sf::Sprite mCacheSprite;
+    bool mCacheFailed;
+
+    void renderContents(sf::RenderTarget& target) {
+        target.draw(mBackground);
+        for (auto& child : mChildren) {
+            child->render(target);
+        }
+    }
+
+    /**
+     * @brief Redraw the cached texture in panel coordinates
+     * @return false if render textures are unavailable
+     */
+    bool rebuildCache() {
+        // Whole pixels around the outline and any child hanging over the
+        // edge (a slider handle at either end, a button's outline)
+        const sf::FloatRect bounds = getDrawBounds();
+        const sf::Vector2f origin(std::floor(bounds.left),
+                                  std::floor(bounds.top));
+        const sf::Vector2u size(
+            static_cast<unsigned>(
+                std::ceil(bounds.left + bounds.width - origin.x)),
+            static_cast<unsigned>(
+                std::ceil(bounds.top + bounds.height - origin.y)));
+        if (size.x == 0 || size.y == 0) return false;
+
+        if (mCache.getSize() != size && !mCache.create(size.x, size.y)) {
+            std::cerr << "ERROR::PANEL::Cannot create cache texture, "
+                         "drawing uncached\n";
+            mCacheFailed = true;
+            return false;
+        }
+
+        // Children are laid out in window coordinates
+        mCache.setView(sf::View(sf::FloatRect(origin.x, origin.y,
+                                              static_cast<float>(size.x),
+                                              static_cast<float>(size.y))));
+        mCache.clear(sf::Color::Transparent);
+        renderContents(mCache);
+        mCache.display();
+
+        mCacheSprite.setTexture(mCache.getTexture(), true);
+        mCacheSprite.setPosition(origin);
+        return true;
+    }
+
    public:
     /**
      * @brief Constructor
@@ -173,7 +527,9 @@ class Panel : public UIElement {
      */
     Panel(const sf::Vector2f& position, const sf::Vector2f& size,
           const sf::Color& backgroundColor = sf::Color(30, 30, 30, 200))
-        : mBackgroundColor(backgroundColor) {
+        : mBackgroundColor(backgroundColor),
+          mPadding(10.f),
+          mCacheFailed(false) {
         mPosition = position;
         mSize = size;
 
@@ -184,6 +540,10 @@ class Panel : public UIElement {
         mBackground.setOutlineColor(sf::Color(100, 100, 100));
     }
 
+    /**
+     * @brief Polling input: every child, every frame. Prefer routing
+     * events through a UIDispatcher.
+     */
     void update(const sf::Vector2f& mousePos, bool mousePressed) override {
         if (!mVisible) return;
 
@@ -192,21 +552,141 @@ class Panel : public UIElement {
         }
     }
 
-    void render(sf::RenderWindow& window) override {
-        if (!mVisible) return;
+    void render(sf::RenderTarget& target) override {
+        if (!mVisible) {
+            clearDirty();
+            return;
+        }
+
+        if (mLayoutDirty) updateLayout();
+        if (mCacheFailed) {
+            renderContents(target);
+            clearDirty();
+            return;
+        }
+        if (mDirty && !rebuildCache()) {
+            renderContents(target);
+            return;
+        }
+        clearDirty();
+
+        // The cache holds premultiplied colour (everything was blended
+        // onto transparent black), so it must not be multiplied by alpha
+        // a second time
+        target.draw(mCacheSprite,
+                    sf::RenderStates(sf::BlendMode(sf::BlendMode::One,
+                                                   sf::BlendMode::OneMinusSrcAlpha)));
+    }
+
+    // Moving or resizing re-arranges the children but does not change
+    // what this panel asks of its own parent
+    void setPosition(const sf::Vector2f& pos) override {
+        if (pos == mPosition) return;
+        UIElement::setPosition(pos);
+        mBackground.setPosition(pos);
+        if (mLayout) mLayoutDirty = true;
+    }
+
+    void setSize(const sf::Vector2f& size) override {
+        if (size == mSize) return;
+        UIElement::setSize(size);
+        mBackground.setSize(size);
+        if (mLayout) mLayoutDirty = true;
+    }
+
+    void setLayout(std::unique_ptr<Layout> layout) {
+        mLayout = std::move(layout);
+        markLayoutDirty();
+    }
+
+    void setPadding(float padding) {
+        if (padding == mPadding) return;
+        mPadding = padding;
+        markLayoutDirty();
+    }
 
-        window.draw(mBackground);
+    /**
+     * @brief Layout's measure plus padding; cached until a child changes
+     */
+    sf::Vector2f measure() override {
+        if (!mLayout) return mSize;
+        if (mMeasureDirty) {
+            mMeasured = mLayout->measure(mChildren) +
+                        sf::Vector2f(2.f * mPadding, 2.f * mPadding);
+            mMeasureDirty = false;
+        }
+        return mMeasured;
+    }
 
+    /**
+     * @brief Arrange this panel if needed, then descend only into
+     * children that are themselves out of date
+     */
+    void updateLayout() override {
+        if (mLayout) {
+            measure();
+            mLayout->arrange(
+                mChildren,
+                sf::FloatRect(mPosition.x + mPadding, mPosition.y + mPadding,
+                              mSize.x - 2.f * mPadding,
+                              mSize.y - 2.f * mPadding));
+        }
         for (auto& child : mChildren) {
-            child->render(window);
+            if (child->isLayoutDirty()) child->updateLayout();
         }
+        mLayoutDirty = false;
+        mMeasureDirty = false;
     }
 
     void addChild(std::shared_ptr<UIElement> element) {
+        element->setParent(this);
         mChildren.push_back(element);
+        markDirty();
+        markHitTestDirty();
+        markLayoutDirty();
+    }
+
+    void clearChildren() {
+        for (auto& child : mChildren) {
+            child->setParent(nullptr);
+        }
+        mChildren.clear();
+        markDirty();
+        markHitTestDirty();
+        markLayoutDirty();
+    }
+
+    void setFont(const sf::Font& font) override {
+        for (auto& child : mChildren) {
+            child->setFont(font);
+        }
+    }
+
+    sf::FloatRect getDrawBounds() const override {
+        sf::FloatRect bounds = mBackground.getGlobalBounds();
+        for (const auto& child : mChildren) {
+            if (child->isVisible()) {
+                bounds = unionRect(bounds, child->getDrawBounds());
+            }
+        }
+        return bounds;
     }
 
-    void clearChildren() { mChildren.clear(); }
+    bool containsElement(const UIElement* element) const override {
+        if (element == this) return true;
+        for (const auto& child : mChildren) {
+            if (child->containsElement(element)) return true;
+        }
+        return false;
+    }
+
+    void collectInteractive(std::vector<UIElement*>& out) override {
+        // Later children draw on top, so they come later here too
+        if (!mVisible) return;
+        for (auto& child : mChildren) {
+            child->collectInteractive(out);
+        }
+    }
 };
 
 /**
@@ -229,7 +709,8 @@ class Label : public UIElement {
           const sf::Color& color = sf::Color::White) {
         mPosition = position;
 
-        mText.setFont(ResourceManager::getInstance().getFont("main"));
+        mText.setFont(
+            ResourceManager::getInstance().getFont(ResourceIds::MAIN_FONT));
         mText.setString(text);
         mText.setCharacterSize(fontSize);
         mText.setFillColor(color);
@@ -241,25 +722,68 @@ class Label : public UIElement {
 
     void update(const sf::Vector2f& mousePos, bool mousePressed) override {}
 
-    void render(sf::RenderWindow& window) override {
+    void render(sf::RenderTarget& target) override {
+        clearDirty();
         if (!mVisible) return;
-        window.draw(mText);
+        target.draw(mText);
+    }
+
+    /**
+     * @brief Extent from the text origin, so the gap above the glyphs is
+     * included and stacked labels do not overlap
+     */
+    sf::Vector2f measure() override {
+        const sf::FloatRect bounds = mText.getLocalBounds();
+        return sf::Vector2f(bounds.left + bounds.width,
+                            bounds.top + bounds.height);
+    }
+
+    void setPosition(const sf::Vector2f& pos) override {
+        UIElement::setPosition(pos);
+        mText.setPosition(pos);
+    }
+
+    sf::FloatRect getDrawBounds() const override {
+        return mText.getGlobalBounds();
     }
 
     void setText(const std::string& text) {
+        if (mText.getString() == text) return;
         mText.setString(text);
         sf::FloatRect bounds = mText.getLocalBounds();
         mSize = sf::Vector2f(bounds.width, bounds.height);
+        markDirty();
+        markLayoutDirty();
     }
 
-    void setColor(const sf::Color& color) { mText.setFillColor(color); }
+    void setFont(const sf::Font& font) override {
+        mText.setFont(font);
+        sf::FloatRect bounds = mText.getLocalBounds();
+        mSize = sf::Vector2f(bounds.width, bounds.height);
+        markDirty();
+        markLayoutDirty();
+    }
 
-    void setCharacterSize(unsigned int size) { mText.setCharacterSize(size); }
+    void setColor(const sf::Color& color) {
+        if (mText.getFillColor() == color) return;
+        mText.setFillColor(color);
+        markDirty();
+    }
+
+    void setCharacterSize(unsigned int size) {
+        if (mText.getCharacterSize() == size) return;
+        mText.setCharacterSize(size);
+        sf::FloatRect bounds = mText.getLocalBounds();
+        mSize = sf::Vector2f(bounds.width, bounds.height);
+        markDirty();
+        markLayoutDirty();
+    }
 
     void centerOnPosition() {
         sf::FloatRect bounds = mText.getLocalBounds();
         mText.setOrigin(bounds.left + bounds.width / 2.f,
                         bounds.top + bounds.height / 2.f);
+        markDirty();
     }
 };
 
@@ -272,6 +796,8 @@ class Slider : public UIElement {
     sf::CircleShape mHandle;
     sf::Text mLabel;
 
+    float mPreferredWidth;  // As constructed; layouts may stretch mSize.x
+
     float mValue;  // 0.0 to 1.0
     float mMin;
     float mMax;
@@ -291,7 +817,7 @@ class Slider : public UIElement {
      */
     Slider(const std::string& label, const sf::Vector2f& position, float width,
            float min, float max, float initialValue = 0.5f)
-        : mMin(min), mMax(max), mDragging(false) {
+        : mPreferredWidth(width), mMin(min), mMax(max), mDragging(false) {
         mPosition = position;
         mSize = sf::Vector2f(width, 30.f);
         mValue = (initialValue - min) / (max - min);
@@ -308,7 +834,8 @@ class Slider : public UIElement {
         updateHandlePosition();
 
         // Setup label
-        mLabel.setFont(ResourceManager::getInstance().getFont("main"));
+        mLabel.setFont(
+            ResourceManager::getInstance().getFont(ResourceIds::MAIN_FONT));
         mLabel.setString(label);
         mLabel.setCharacterSize(18);
         mLabel.setFillColor(sf::Color::White);
@@ -331,7 +858,10 @@ class Slider : public UIElement {
         if (mDragging) {
             // Update value based on mouse X position
             float relativeX = mousePos.x - mPosition.x;
-            mValue = std::max(0.f, std::min(1.f, relativeX / mSize.x));
+            const float value =
+                std::max(0.f, std::min(1.f, relativeX / mSize.x));
+            if (value == mValue) return;
+            mValue = value;
             updateHandlePosition();
 
             if (mCallback) {
@@ -340,12 +870,67 @@ class Slider : public UIElement {
         }
     }
 
-    void render(sf::RenderWindow& window) override {
+    void render(sf::RenderTarget& target) override {
+        clearDirty();
         if (!mVisible) return;
 
-        window.draw(mLabel);
-        window.draw(mTrack);
-        window.draw(mHandle);
+        target.draw(mLabel);
+        target.draw(mTrack);
+        target.draw(mHandle);
+    }
+
+    void setPosition(const sf::Vector2f& pos) override {
+        UIElement::setPosition(pos);
+        mTrack.setPosition(pos.x, pos.y + 20.f);
+        mLabel.setPosition(pos);
+        updateHandlePosition();
+    }
+
+    // Only the width stretches; the track and handle have a fixed height
+    void setSize(const sf::Vector2f& size) override {
+        UIElement::setSize(sf::Vector2f(size.x, 30.f));
+        mTrack.setSize(sf::Vector2f(size.x, 5.f));
+        updateHandlePosition();
+    }
+
+    // Stretching the track must not widen what the slider asks for
+    sf::Vector2f measure() override {
+        return sf::Vector2f(mPreferredWidth, 30.f);
+    }
+
+    bool isInteractive() const override { return mVisible && mEnabled; }
+
+    sf::FloatRect getDrawBounds() const override {
+        return unionRect(unionRect(mLabel.getGlobalBounds(), getHitBounds()),
+                         mTrack.getGlobalBounds());
+    }
+
+    /**
+     * @brief The handle's whole range of travel, so the index does not
+     * change while dragging; a press anywhere on it jumps there
+     */
+    sf::FloatRect getHitBounds() const override {
+        const float radius = mHandle.getRadius();
+        return sf::FloatRect(mPosition.x - radius, mPosition.y + 22.5f - radius,
+                             mSize.x + 2.f * radius, 2.f * radius);
+    }
+
+    void onMousePress(const sf::Vector2f& mousePos) override {
+        mDragging = true;
+        onMouseDrag(mousePos);
+    }
+
+    void onMouseDrag(const sf::Vector2f& mousePos) override {
+        const float value = std::max(
+            0.f, std::min(1.f, (mousePos.x - mPosition.x) / mSize.x));
+        if (value == mValue) return;
+        mValue = value;
+        updateHandlePosition();
+        if (mCallback) mCallback(getValue());
+    }
+
+    void onMouseRelease(const sf::Vector2f&, bool) override {
+        mDragging = false;
     }
 
     float getValue() const { return mMin + mValue * (mMax - mMin); }
@@ -360,10 +945,23 @@ class Slider : public UIElement {
         mCallback = callback;
     }
 
+    void setLabel(const std::string& label) {
+        if (mLabel.getString() == label) return;
+        mLabel.setString(label);
+        markDirty();
+    }
+
+    void setFont(const sf::Font& font) override {
+        mLabel.setFont(font);
+        markDirty();
+    }
+
    private:
     void updateHandlePosition() {
-        float x = mPosition.x + mValue * mSize.x;
-        float y = mPosition.y + 22.5f;
-        mHandle.setPosition(x, y);
+        const sf::Vector2f position(mPosition.x + mValue * mSize.x,
+                                    mPosition.y + 22.5f);
+        if (position == mHandle.getPosition()) return;
+        mHandle.setPosition(position);
+        markDirty();
     }
 };
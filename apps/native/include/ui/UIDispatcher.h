@@ -0,0 +1,256 @@
+/**
+ * @file UIDispatcher.h
+ * @brief Event-driven mouse input for the UI
+ *
+ * Polling Panel::update() makes every widget test its bounds against the
+ * mouse every frame. The dispatcher instead reacts to SFML mouse events:
+ * it hit-tests through a bounding volume tree over the interactive
+ * widgets, keeps hover and capture state in one place and calls only the
+ * widgets involved. An idle menu does no per-widget work at all.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "ui/UI.h"
+
+class UIDispatcher {
+   private:
+    /**
+     * @brief Tree node; leaves own a run of mOrder
+     */
+    struct Node {
+        sf::FloatRect bounds;
+        int left;   // -1 for a leaf
+        int right;
+        std::size_t first;
+        std::size_t count;
+    };
+
+    static constexpr std::size_t LEAF_SIZE = 4;
+
+    std::vector<std::shared_ptr<UIElement>> mRoots;
+
+    // Rebuilt only when a root reports changed bounds or children
+    std::vector<UIElement*> mElements;  // Draw order, topmost last
+    std::vector<sf::FloatRect> mBounds;
+    std::vector<std::size_t> mOrder;
+    std::vector<Node> mNodes;
+    bool mIndexDirty;
+
+    UIElement* mHovered;
+    UIElement* mCaptured;
+    sf::Vector2f mLastMouse;
+
+    /**
+     * @brief Build the subtree over mOrder[first, first + count)
+     * @return Node index
+     */
+    int build(std::size_t first, std::size_t count) {
+        sf::FloatRect bounds = mBounds[mOrder[first]];
+        for (std::size_t i = first + 1; i < first + count; ++i) {
+            bounds = unionRect(bounds, mBounds[mOrder[i]]);
+        }
+
+        const int index = static_cast<int>(mNodes.size());
+        mNodes.push_back({bounds, -1, -1, first, count});
+        if (count <= LEAF_SIZE) return index;
+
+        // Median split along the longer axis
+        const bool alongX = bounds.width >= bounds.height;
+        auto center = [&](std::size_t element) {
+            const sf::FloatRect& r = mBounds[element];
+            return alongX ? r.left + r.width / 2.f : r.top + r.height / 2.f;
+        };
+        const std::size_t half = count / 2;
+        std::nth_element(mOrder.begin() + first, mOrder.begin() + first + half,
+                         mOrder.begin() + first + count,
+                         [&](std::size_t a, std::size_t b) {
+                             return center(a) < center(b);
+                         });
+
+        const int left = build(first, half);
+        const int right = build(first + half, count - half);
+        mNodes[index].left = left;
+        mNodes[index].right = right;
+        return index;
+    }
+
+    void rebuildIfNeeded() {
+        bool dirty = mIndexDirty;
+        for (const auto& root : mRoots) {
+            // Hit-test where things will be drawn
+            if (root->isLayoutDirty()) root->updateLayout();
+            dirty = dirty || root->isHitTestDirty();
+        }
+        if (!dirty) return;
+
+        mElements.clear();
+        for (const auto& root : mRoots) {
+            root->collectInteractive(mElements);
+            root->clearHitTestDirty();
+        }
+        mBounds.clear();
+        mOrder.clear();
+        for (std::size_t i = 0; i < mElements.size(); ++i) {
+            mBounds.push_back(mElements[i]->getHitBounds());
+            mOrder.push_back(i);
+        }
+        mNodes.clear();
+        if (!mElements.empty()) build(0, mElements.size());
+        mIndexDirty = false;
+
+        // Widgets that were removed may already be destroyed, so they are
+        // forgotten rather than notified; ones merely disabled or hidden
+        // are still there and are let go of properly
+        auto indexed = [this](UIElement* element) {
+            return std::find(mElements.begin(), mElements.end(), element) !=
+                   mElements.end();
+        };
+        auto attached = [this](const UIElement* element) {
+            for (const auto& root : mRoots) {
+                if (root->containsElement(element)) return true;
+            }
+            return false;
+        };
+        if (mCaptured && !indexed(mCaptured)) {
+            UIElement* captured = mCaptured;
+            mCaptured = nullptr;
+            if (attached(captured)) captured->onMouseRelease(mLastMouse, false);
+        }
+        if (mHovered && !indexed(mHovered)) {
+            UIElement* hovered = mHovered;
+            mHovered = nullptr;
+            if (attached(hovered)) hovered->onMouseLeave();
+        }
+    }
+
+    /**
+     * @brief Topmost interactive element under @p point
+     */
+    UIElement* hitTest(const sf::Vector2f& point) {
+        rebuildIfNeeded();
+        if (mNodes.empty()) return nullptr;
+
+        std::size_t best = mElements.size();
+        int stack[64];
+        int depth = 0;
+        stack[depth++] = 0;
+        while (depth > 0) {
+            const Node& node = mNodes[stack[--depth]];
+            if (!node.bounds.contains(point)) continue;
+            if (node.left < 0) {
+                for (std::size_t i = node.first; i < node.first + node.count;
+                     ++i) {
+                    const std::size_t element = mOrder[i];
+                    if (mBounds[element].contains(point) &&
+                        (best == mElements.size() || element > best)) {
+                        best = element;
+                    }
+                }
+                continue;
+            }
+            stack[depth++] = node.left;
+            stack[depth++] = node.right;
+        }
+        return best < mElements.size() ? mElements[best] : nullptr;
+    }
+
+    void updateHover(const sf::Vector2f& mousePos) {
+        UIElement* hit = hitTest(mousePos);
+        // While something is captured, nothing else lights up
+        if (mCaptured && hit != mCaptured) hit = nullptr;
+        if (hit == mHovered) return;
+
+        if (mHovered) mHovered->onMouseLeave();
+        mHovered = hit;
+        if (mHovered) mHovered->onMouseEnter();
+    }
+
+   public:
+    UIDispatcher()
+        : mIndexDirty(true), mHovered(nullptr), mCaptured(nullptr) {}
+
+    /**
+     * @brief Add a top-level element; later roots are on top
+     */
+    void addRoot(std::shared_ptr<UIElement> root) {
+        mRoots.push_back(std::move(root));
+        mIndexDirty = true;
+    }
+
+    void clear() {
+        mRoots.clear();
+        mIndexDirty = true;
+        mHovered = nullptr;
+        mCaptured = nullptr;
+    }
+
+    /**
+     * @brief Route one SFML event
+     * @param target Maps pixel positions to UI coordinates
+     * @return true if the event was used by the UI
+     */
+    bool handleEvent(const sf::Event& event, const sf::RenderTarget& target) {
+        switch (event.type) {
+            case sf::Event::MouseMoved: {
+                mLastMouse = target.mapPixelToCoords(
+                    {event.mouseMove.x, event.mouseMove.y});
+                if (mCaptured) mCaptured->onMouseDrag(mLastMouse);
+                updateHover(mLastMouse);
+                return mHovered != nullptr || mCaptured != nullptr;
+            }
+            case sf::Event::MouseButtonPressed: {
+                if (event.mouseButton.button != sf::Mouse::Left) return false;
+                mLastMouse = target.mapPixelToCoords(
+                    {event.mouseButton.x, event.mouseButton.y});
+                updateHover(mLastMouse);
+                if (!mHovered) return false;
+                mCaptured = mHovered;
+                mCaptured->onMousePress(mLastMouse);
+                return true;
+            }
+            case sf::Event::MouseButtonReleased: {
+                if (event.mouseButton.button != sf::Mouse::Left ||
+                    !mCaptured) {
+                    return false;
+                }
+                mLastMouse = target.mapPixelToCoords(
+                    {event.mouseButton.x, event.mouseButton.y});
+                UIElement* captured = mCaptured;
+                mCaptured = nullptr;
+                const bool inside = hitTest(mLastMouse) == captured;
+                // May run a callback that rebuilds the UI; captured is not
+                // touched afterwards
+                captured->onMouseRelease(mLastMouse, inside);
+                updateHover(mLastMouse);
+                return true;
+            }
+            case sf::Event::MouseLeft:
+                // Drop widgets removed since the last event before use
+                rebuildIfNeeded();
+                if (!mCaptured && mHovered) {
+                    mHovered->onMouseLeave();
+                    mHovered = nullptr;
+                }
+                return false;
+            case sf::Event::LostFocus:
+                rebuildIfNeeded();
+                // The release will never arrive
+                if (mCaptured) {
+                    UIElement* captured = mCaptured;
+                    mCaptured = nullptr;
+                    captured->onMouseRelease(mLastMouse, false);
+                }
+                return false;
+            default:
+                return false;
+        }
+    }
+
+    UIElement* getHovered() const { return mHovered; }
+    UIElement* getCaptured() const { return mCaptured; }
+};
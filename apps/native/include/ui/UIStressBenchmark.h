@@ -0,0 +1,273 @@
+/**
+ * @file UIStressBenchmark.h
+ * @brief Repeatable UI benchmark: deep panel trees, scripted mouse input
+ *
+ * `FallingFury --ui-bench [frames]` builds a tree of nested Panels holding
+ * a few thousand Buttons, Labels and Sliders and plays a seeded script of
+ * mouse moves, clicks, drags and idle stretches through it. The script
+ * runs twice: once through the polling update() path and once as SFML
+ * events through a UIDispatcher. Both render offscreen, so nothing waits
+ * on vsync. Reported per path:
+ *   - update and render CPU time per frame (mean, median, p95, max)
+ *   - heap allocations per frame and per click (press or release)
+ * The same seed gives the same widgets and the same input on every run.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "managers/ResourceManager.h"
+#include "systems/AllocationCounter.h"
+#include "ui/Layout.h"
+#include "ui/UI.h"
+#include "ui/UIDispatcher.h"
+
+namespace UIStressBenchmark {
+
+struct Config {
+    unsigned groups = 48;          // Top-level panels
+    unsigned depth = 4;            // Nesting per group
+    unsigned widgetsPerPanel = 12;
+    unsigned frames = 3000;
+    unsigned warmupFrames = 60;    // Not measured: first caches, first glyphs
+    unsigned seed = 1234;
+    sf::Vector2u size = sf::Vector2u(1000, 700);
+};
+
+struct MouseFrame {
+    sf::Vector2i position;
+    bool pressed;
+};
+
+/**
+ * @brief Seeded mouse script: moves, clicks, drags and idle stretches
+ */
+inline std::vector<MouseFrame> makeScript(const Config& config) {
+    std::mt19937 rng(config.seed);
+    std::uniform_int_distribution<int> x(0, static_cast<int>(config.size.x) - 1);
+    std::uniform_int_distribution<int> y(0, static_cast<int>(config.size.y) - 1);
+    std::uniform_int_distribution<int> action(0, 3);
+    std::uniform_int_distribution<int> length(20, 60);
+
+    std::vector<MouseFrame> script;
+    sf::Vector2i position(x(rng), y(rng));
+    auto moveTo = [&](sf::Vector2i target, int frames, bool pressed) {
+        const sf::Vector2i start = position;
+        for (int i = 1; i <= frames; ++i) {
+            position = start + (target - start) * i / frames;
+            script.push_back({position, pressed});
+        }
+    };
+
+    const std::size_t total = config.warmupFrames + config.frames;
+    while (script.size() < total) {
+        switch (action(rng)) {
+            case 0:  // Sweep across the widgets
+                moveTo({x(rng), y(rng)}, length(rng), false);
+                break;
+            case 1:  // Click in place
+                for (int i = 0; i < 3; ++i) script.push_back({position, true});
+                script.push_back({position, false});
+                break;
+            case 2:  // Drag (moves slider handles it starts on)
+                script.push_back({position, true});
+                moveTo(position + sf::Vector2i(length(rng) - 40, 0),
+                       length(rng), true);
+                script.push_back({position, false});
+                break;
+            default:  // Idle
+                for (int i = length(rng); i > 0; --i) {
+                    script.push_back({position, false});
+                }
+                break;
+        }
+    }
+    script.resize(total);
+    return script;
+}
+
+inline std::shared_ptr<Panel> makeGroup(const Config& config, unsigned level,
+                                        std::size_t& widgets) {
+    auto panel = std::make_shared<Panel>(sf::Vector2f(), sf::Vector2f(),
+                                         sf::Color(40, 40, 60, 200));
+    panel->setPadding(2.f);
+    panel->setLayout(std::make_unique<GridLayout>(4, 2.f));
+
+    for (unsigned i = 0; i < config.widgetsPerPanel; ++i) {
+        switch (i % 3) {
+            case 0:
+                panel->addChild(std::make_shared<Button>(
+                    "B", sf::Vector2f(), sf::Vector2f(28.f, 16.f)));
+                break;
+            case 1:
+                panel->addChild(
+                    std::make_shared<Label>("L" + std::to_string(i),
+                                            sf::Vector2f(), 10));
+                break;
+            default:
+                panel->addChild(std::make_shared<Slider>(
+                    "", sf::Vector2f(), 40.f, 0.f, 1.f, 0.5f));
+                break;
+        }
+        ++widgets;
+    }
+    if (level > 1) panel->addChild(makeGroup(config, level - 1, widgets));
+    return panel;
+}
+
+/**
+ * @brief The whole tree, sized to the render target
+ */
+inline std::shared_ptr<Panel> buildScene(const Config& config,
+                                         std::size_t& widgets) {
+    widgets = 0;
+    auto root = std::make_shared<Panel>(
+        sf::Vector2f(), sf::Vector2f(config.size), sf::Color(20, 20, 30));
+    root->setPadding(4.f);
+    root->setLayout(std::make_unique<GridLayout>(8, 4.f));
+    for (unsigned g = 0; g < config.groups; ++g) {
+        root->addChild(makeGroup(config, config.depth, widgets));
+    }
+    return root;
+}
+
+struct Result {
+    std::vector<double> updateUs;
+    std::vector<double> renderUs;
+    std::uint64_t allocations = 0;
+    std::uint64_t clickAllocations = 0;
+    unsigned clicks = 0;
+};
+
+inline double elapsedUs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now() - since)
+        .count();
+}
+
+/**
+ * @brief Play @p script through the tree
+ * @param dispatch Route SFML events through a UIDispatcher instead of
+ * calling update() every frame
+ */
+inline Result play(const Config& config,
+                   const std::vector<MouseFrame>& script, bool dispatch,
+                   sf::RenderTexture& target) {
+    std::size_t widgets = 0;
+    std::shared_ptr<Panel> root = buildScene(config, widgets);
+    UIDispatcher dispatcher;
+    dispatcher.addRoot(root);
+
+    Result result;
+    MouseFrame last{sf::Vector2i(-1, -1), false};
+    for (std::size_t frame = 0; frame < script.size(); ++frame) {
+        const MouseFrame& input = script[frame];
+        const bool measured = frame >= config.warmupFrames;
+        const bool click = input.pressed != last.pressed;
+        AllocationScope allocations;
+
+        auto start = std::chrono::steady_clock::now();
+        if (dispatch) {
+            sf::Event event;
+            if (input.position != last.position) {
+                event.type = sf::Event::MouseMoved;
+                event.mouseMove = {input.position.x, input.position.y};
+                dispatcher.handleEvent(event, target);
+            }
+            if (click) {
+                event.type = input.pressed ? sf::Event::MouseButtonPressed
+                                           : sf::Event::MouseButtonReleased;
+                event.mouseButton = {sf::Mouse::Left, input.position.x,
+                                     input.position.y};
+                dispatcher.handleEvent(event, target);
+            }
+        } else {
+            root->update(sf::Vector2f(input.position), input.pressed);
+        }
+        const double updateUs = elapsedUs(start);
+
+        start = std::chrono::steady_clock::now();
+        target.clear();
+        root->render(target);
+        target.display();
+        const double renderUs = elapsedUs(start);
+
+        last = input;
+        if (!measured) continue;
+        result.updateUs.push_back(updateUs);
+        result.renderUs.push_back(renderUs);
+        result.allocations += allocations.allocations();
+        if (click) {
+            result.clickAllocations += allocations.allocations();
+            ++result.clicks;
+        }
+    }
+    return result;
+}
+
+inline void printTimes(const char* label, std::vector<double> us) {
+    if (us.empty()) return;
+    std::sort(us.begin(), us.end());
+    double sum = 0.0;
+    for (double value : us) sum += value;
+    std::printf("  %-7s mean %8.1f us  p50 %8.1f  p95 %8.1f  max %8.1f\n",
+                label, sum / us.size(), us[us.size() / 2],
+                us[us.size() * 95 / 100], us.back());
+}
+
+inline void report(const char* path, const Result& result) {
+    std::printf("%s\n", path);
+    printTimes("update", result.updateUs);
+    printTimes("render", result.renderUs);
+    if (!AllocationCounter::ENABLED) {
+        std::printf("  allocs  allocation tracking off "
+                    "(build with FALLING_FURY_ALLOC_TRACKING)\n");
+        return;
+    }
+    std::printf("  allocs  %.2f per frame, %.2f per click (%u clicks)\n",
+                static_cast<double>(result.allocations) /
+                    std::max<std::size_t>(result.updateUs.size(), 1),
+                static_cast<double>(result.clickAllocations) /
+                    std::max(result.clicks, 1u),
+                result.clicks);
+}
+
+/**
+ * @return Process exit code
+ */
+inline int run(const Config& config) {
+    ResourceManager& resources = ResourceManager::getInstance();
+    resources.loadPack("assets.ffpk");
+    if (!resources.hasFont(ResourceIds::MAIN_FONT)) {
+        resources.loadFont("main", "assets/fonts/1/BebasNeue-Regular.ttf");
+    }
+
+    sf::RenderTexture target;
+    if (!target.create(config.size.x, config.size.y)) {
+        std::fprintf(stderr,
+                     "ERROR::UIBENCH::Cannot create the render target\n");
+        return 1;
+    }
+
+    const std::size_t widgets = static_cast<std::size_t>(config.groups) *
+                                config.depth * config.widgetsPerPanel;
+    const std::vector<MouseFrame> script = makeScript(config);
+    std::printf("UI stress: %zu widgets in %u groups of depth %u, %u frames, "
+                "seed %u\n",
+                widgets, config.groups, config.depth, config.frames,
+                config.seed);
+
+    report("polling update()", play(config, script, false, target));
+    report("UIDispatcher events", play(config, script, true, target));
+    return 0;
+}
+
+}  // namespace UIStressBenchmark
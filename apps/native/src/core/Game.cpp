@@ -1,58 +1,128 @@
 #include "core/Game.h"
 
+#include <chrono>
+#include <cstdio>
 #include <iostream>
+
+#include "systems/StartupBenchmark.h"
+#include "systems/ThreadPool.h"
+
 // Constructor
-Game::Game()
-    : mVideoMode(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGH)),
-      mWindow(std::make_unique<sf::RenderWindow>(
-          mVideoMode, "Falling Fury", sf::Style::Titlebar | sf::Style::Close)),
-      mPoints(0),
+Game::Game(bool exitAfterFirstFrame, bool autoplay)
+    : mEngine(&ResourceManager::getInstance(), true),
+      mVideoMode(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGH)),
+      mGlyphAtlas(std::make_unique<GlyphAtlas>()),
+      mSim(SimConfig(), static_cast<std::uint64_t>(std::time(nullptr))),
+      mBot(BotSkill(),
+           static_cast<std::uint64_t>(std::time(nullptr)) ^ 0xB07u),
       mMaxPoint(0),
-      mHealth(10),
-      mEndGame(false),
-      mEnemySpawnTimerMax(40.f),
-      mEnemySpawnTimer(40.f),
-      mMouseHeld(false) {
+      mEnemyVertices(sf::Triangles),
 #ifdef __EMSCRIPTEN__
-    mWindow->setFramerateLimit(0);
+      mFrameLimit(0),  // The browser paces frames
 #else
-    mWindow->setFramerateLimit(60);
+      mFrameLimit(60),
 #endif
-
-    // Load resources via ResourceManager
-    ResourceManager::getInstance().loadFont(
-        "main", "assets/fonts/1/BebasNeue-Regular.ttf");
+      mFirstFrameShown(false),
+      mExitAfterFirstFrame(exitAfterFirstFrame) {
+    ScopedTrace startup("Game::Game", "startup");
+
+    // Everything that does not need the window starts first and overlaps
+    // window creation: the pack decode, the baked glyph atlas and the
+    // save file
+    ResourceManager& resources = mEngine.getResources();
+    std::shared_future<bool> pack = resources.loadPackAsync("assets.ffpk");
+    std::future<bool> atlas = ThreadPool::async([this] {
+        ScopedTrace span("read glyph atlas", "startup");
+        return mGlyphAtlas->readFromFile("glyphs_main.ffga");
+    });
+    std::future<std::string> savedScore = ThreadPool::async([this] {
+        ScopedTrace span("read save data", "startup");
+        return getData();
+    });
+
+    initWindow();
 
     // Load high score from file
-    std::string savedScore = getData();
     try {
-        mMaxPoint = std::stoi(savedScore);
+        mMaxPoint = std::stoi(savedScore.get());
     } catch (const std::exception& e) {
         std::cerr
             << "ERROR::GAME::CONSTRUCTOR::Invalid score data, resetting to 0\n";
         mMaxPoint = 0;
     }
 
+    {
+        ScopedTrace wait("wait for assets", "startup");
+        pack.wait();
+    }
+    if (!resources.hasFont(ResourceIds::MAIN_FONT)) {
+        resources.loadFont("main", "assets/fonts/1/BebasNeue-Regular.ttf");
+    }
+
+    if (atlas.get()) mGlyphAtlas->uploadTexture();
+    initGlyphs();
     initText();
     initMaxPoint();
     initEnemies();
+    initCVars();
+    if (autoplay) mAutoplay = true;
+#ifdef FALLING_FURY_HOT_RELOAD
+    initHotReload();
+#endif
+    // SoundManager (mixer thread, synth) waits for onFirstFrame()
 }
 
 // Destructor
 Game::~Game() {
     // Smart pointer automatically cleans up mWindow
-    // Cleanup ResourceManager
+    // Cleanup managers
+    SoundManager::destroy();
     ResourceManager::destroy();
 }
 
 void Game::update() {
+    mFrameAllocations.beginFrame();
+    mFrameSteady = !mSim.isOver() && !mConsole->isOpen() && mFirstFrameShown;
+    {
+        AllocationTagScope tag(AllocationTag::RESOURCES);
+#ifdef FALLING_FURY_HOT_RELOAD
+        // Frame boundary: nothing is mid-draw with the old resources
+        if (mHotReloader->update() > 0) mFrameSteady = false;
+        updateFontReload();
+#endif
+        mEngine.getResources().trimToBudget();
+    }
     updateDeltaTime();
-    pollEvent();
+    {
+        AllocationTagScope tag(AllocationTag::UI);
+        pollEvent();
+    }
 
-    if (mEndGame) return;
+    // Autoplay is load generation: the next game starts at once
+    if (mSim.isOver() && mAutoplay) {
+        mSim.reset();
+        mBot.reset();
+    }
+    if (mSim.isOver()) return;
     updateMousePositions();
     updateEnemies();
+    {
+        AllocationTagScope tag(AllocationTag::PARTICLES);
+        mParticles.update(mDeltaTime);
+    }
     updateText();
+
+    if (!mFirstFrameShown) return;
+
+    // Music follows difficulty, which grows with the score
+    AllocationTagScope tag(AllocationTag::AUDIO);
+    SoundManager& sound = mEngine.getSound();
+    sound.setMusicIntensity(mSim.getPoints() / POINTS_FOR_MAX_INTENSITY);
+    const int health = mSim.getHealth();
+    sound.setLowHealthAmount(
+        health < LOW_HEALTH
+            ? static_cast<float>(LOW_HEALTH - health) / LOW_HEALTH
+            : 0.f);
 }
 
 void Game::updateDeltaTime() {
@@ -61,19 +131,59 @@ void Game::updateDeltaTime() {
 }
 
 void Game::render() {
-    mWindow->clear(sf::Color(30, 30, 42));
-
-    renderEnemies();
+    {
+        AllocationTagScope tag(AllocationTag::RENDER);
+        mWindow->clear(sf::Color(30, 30, 42));
+        renderEnemies();
+        mParticles.render(*mWindow);
+    }
 
-    renderText();
+    {
+        AllocationTagScope tag(AllocationTag::HUD);
+        renderText();
+        if (mSim.isOver()) {
+            mWindow->clear(sf::Color(20, 20, 25));
+            renderMaxPoint();
+            mWindow->draw(mRestartText);
+        }
+    }
+    if (mShowAllocs) renderAllocations();
 
-    if (mEndGame) {
-        mWindow->clear(sf::Color(20, 20, 25));
-        renderMaxPoint();
-        mWindow->draw(mRestartText);
+    {
+        AllocationTagScope tag(AllocationTag::UI);
+        mConsole->render(*mWindow);
     }
 
     mWindow->display();
+    if (!mFirstFrameShown) onFirstFrame();
+
+    // A game that ended or restarted this frame was not steady either
+    mFrameAllocations.endFrame(mFrameSteady && !mSim.isOver() &&
+                               !mConsole->isOpen());
+}
+
+void Game::renderAllocations() {
+    AllocationTagScope tag(AllocationTag::PROFILER);
+    // Shows the previous frame: this one is still being counted
+    char text[256];
+    mFrameAllocations.format(text, sizeof(text));
+    mAllocText.setString(text);
+    mWindow->draw(mAllocText);
+}
+
+void Game::onFirstFrame() {
+    mFirstFrameShown = true;
+    TraceRecorder& trace = TraceRecorder::getInstance();
+    trace.record("first frame", "startup", 0, trace.nowUs());
+
+    if (mExitAfterFirstFrame) {
+        StartupBenchmark::reportFirstFrame();
+        mWindow->close();
+        return;
+    }
+
+    ScopedTrace span("start audio", "startup");
+    mEngine.getSound().playGeneratedMusic();
 }
 
 void Game::updateMousePositions() {
@@ -89,125 +199,303 @@ void Game::updateMousePositions() {
 void Game::updateEnemies() {
     /*
     @return void
-    Updates the mEnemy swapn timer and spawn mEnemies
-    When the total amount of mEnemies is smaller than the maximum.
-    Moves the mEnemies downwords.
-    Removes the mEnemies at the edge of the screen. // TODO
+    Steps the simulation with this frame's mouse state and turns what
+    happened into effects: particles and the milestone echo on hits, the
+    save file on game over.
     */
+    mSim.getConfig().worldSize = toSim(sf::Vector2f(mWindow->getSize()));
 
-    // Updating the timer for mEnemy swapwning
-    if (mEnemies.size() < MAX_ENEMIES) {
-        if (mEnemySpawnTimer >= mEnemySpawnTimerMax) {
-            // Spawn the mEnemy and reset the timer
-            spawnEnemy();
-            mEnemySpawnTimer = 0.f;
-        } else
-            mEnemySpawnTimer += 1.f;
+    SimInput input;
+    if (mAutoplay) {
+        input = mBot.think(mSim, mDeltaTime);
+    } else {
+        input.mouse = toSim(mMousePosView);
+        input.mouseDown = sf::Mouse::isButtonPressed(sf::Mouse::Left);
+        // Clicks on the console are not shots
+        input.clickBlocked = mConsole->contains(mMousePosView);
     }
-    // Move the updating mEnemies (frame-independent with deltaTime)
-    for (int i = 0; i < mEnemies.size(); i++) {
-        bool deleted = false;
-        mEnemies[i].move(0.f, mGravity * mDeltaTime);
-
-        if (mEnemies[i].getPosition().y > mWindow->getSize().y) {
-            mHealth--;
-            mEnemies.erase(mEnemies.begin() + i);
-            if (mHealth <= 0) {
-                mEndGame = true;
-                saveData();
-            }
-        }
+    {
+        AllocationTagScope tag(AllocationTag::SIMULATION);
+        mSim.step(mDeltaTime, input);
     }
-    // Check if clicked upon
-    if (sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
-        if (!mMouseHeld) {
-            mMouseHeld = true;
-            bool deleted = false;
-            for (int i = 0; i < mEnemies.size() && !deleted; i++) {
-                if (mEnemies[i].getGlobalBounds().contains(mMousePosView)) {
-                    // Deleted the enemy
-                    deleted = true;
-                    mEnemies.erase(mEnemies.begin() + i);
-
-                    // Gain Points
-                    mHealth++;
-                    mPoints++;
+
+    for (const SimEvent& event : mSim.getEvents()) {
+        switch (event.type) {
+            case SimEventType::HIT: {
+                AllocationTagScope tag(AllocationTag::PARTICLES);
+                mParticles.emitClickEffect(toSfml(event.position),
+                                           toSfml(event.color));
+                if (mSim.getPoints() % POINTS_PER_MILESTONE == 0 &&
+                    mFirstFrameShown) {
+                    AllocationTagScope audio(AllocationTag::AUDIO);
+                    mEngine.getSound().triggerMilestoneEcho();
                 }
+                break;
+            }
+            case SimEventType::GAME_OVER: {
+                AllocationTagScope tag(AllocationTag::SCORES);
+                saveData();
+                break;
             }
+            case SimEventType::MISS:
+                break;
         }
-    } else {
-        mMouseHeld = false;
     }
 }
 
 void Game::updateText() {
-    std::stringstream ss;
-    ss << "Health = " << mHealth << "     "
-       << "Points = " << mPoints << "     "
-       << "Max Point = " << getData();
-    mUiText.setString(ss.str());
+    /*
+    @return void
+    Formats the HUD into a stack buffer. The best score is mMaxPoint, kept
+    current by getData() and saveData(), so nothing here reads the disk,
+    and AtlasText only rebuilds when a number changed.
+    */
+    AllocationTagScope tag(AllocationTag::HUD);
+    char text[96];
+    std::snprintf(text, sizeof(text),
+                  "Health = %d     Points = %u     Max Point = %u",
+                  mSim.getHealth(), mSim.getPoints(), mMaxPoint);
+    mUiText.setString(text);
 }
 
+void Game::initWindow() {
+    ScopedTrace span("create window", "startup");
+    mWindow = std::make_unique<sf::RenderWindow>(
+        mVideoMode, "Falling Fury", sf::Style::Titlebar | sf::Style::Close);
+    mWindow->setFramerateLimit(mFrameLimit);
+}
+
+void Game::initCVars() {
+    SimConfig& sim = mSim.getConfig();
+    mCVars.registerFloat("gravity", sim.gravity, 20.f, 600.f,
+                         "Enemy fall speed in pixels per second");
+    mCVars.registerFloat("spawn_interval", sim.spawnInterval, 1.f, 120.f,
+                         "Frames between enemy spawns");
+    mCVars.registerInt("max_enemies", sim.maxEnemies, 1, 500,
+                       "Enemies alive at once");
+    mCVars.registerInt("particle_pool", mParticlePoolSize, 0, 5000,
+                       "Preallocated hit particles",
+                       [this] { mParticles.resize(mParticlePoolSize); });
+#ifndef __EMSCRIPTEN__
+    mCVars.registerInt("frame_cap", mFrameLimit, 0u, 300u,
+                       "Frame rate limit, 0 for none",
+                       [this] { mWindow->setFramerateLimit(mFrameLimit); });
+    mCVars.registerBool("vsync", mVsync, "Vertical sync",
+                        [this] { mWindow->setVerticalSyncEnabled(mVsync); });
+#endif
+    mCVars.registerBool("batch_enemies", mBatchEnemies,
+                        "Draw all enemies in one vertex array");
+    BotSkill& bot = mBot.getSkill();
+    mCVars.registerBool("autoplay", mAutoplay,
+                        "A bot plays instead of the mouse");
+    mCVars.registerFloat("bot_reaction", bot.reactionDelay, 0.f, 2.f,
+                         "Bot: seconds before it notices an enemy");
+    mCVars.registerFloat("bot_noise", bot.aimNoise, 0.f, 50.f,
+                         "Bot: aim error in pixels");
+    mCVars.registerFloat("bot_cps", bot.clicksPerSecond, 0.5f, 20.f,
+                         "Bot: most clicks per second");
+    mCVars.registerBool("show_allocs", mShowAllocs,
+                        "Show heap allocations per frame by subsystem");
+    mCVars.registerBool(
+        "alloc_assert", mAllocAssert,
+        "Abort when a steady gameplay frame allocates",
+        [this] { mFrameAllocations.setAssert(mAllocAssert); });
+
+    mCVars.loadProfile(PROFILE_PATH);
+    mParticles.resize(mParticlePoolSize);
+    mFrameAllocations.setAssert(mAllocAssert);
+    mConsole = std::make_unique<DevConsole>(mCVars, PROFILE_PATH);
+}
+
+#ifdef FALLING_FURY_HOT_RELOAD
+void Game::initHotReload() {
+    mHotReloader =
+        std::make_unique<HotReloader>(FALLING_FURY_SOURCE_ASSETS_DIR);
+
+    mEngine.getResources().addReloadListener(
+        [this](PackEntryKind kind, const std::string& name,
+               const std::string& filepath) {
+            ResourceManager& resources = mEngine.getResources();
+            switch (kind) {
+                case PackEntryKind::FONT:
+                    // Text keeps the old font until updateFontReload()
+                    // swaps everything over
+                    if (ResourceId(name) != ResourceIds::MAIN_FONT) {
+                        resources.releaseRetired(kind);
+                    } else if (mAtlasRebuild.valid()) {
+                        mQueuedFontPath = filepath;
+                        mFontGlyphsWarmed = 0;  // A different font now
+                    } else {
+                        startAtlasRebuild(filepath);
+                    }
+                    break;
+                case PackEntryKind::SOUND:
+                    // Voices already playing finish on the old clip; the
+                    // mixer keeps its own copy of the samples
+                    if (mFirstFrameShown) {
+                        mEngine.getSound().registerSound(
+                            name, resources.getSound(name));
+                    }
+                    resources.releaseRetired(kind);
+                    break;
+                case PackEntryKind::TEXTURE:
+                    // Nothing holds textures across frames
+                    resources.releaseRetired(kind);
+                    break;
+            }
+        });
+}
+
+void Game::startAtlasRebuild(const std::string& fontPath) {
+    mFontGlyphsWarmed = 0;
+    const std::vector<unsigned> sizes = GLYPH_SIZES;
+    mAtlasRebuild = ThreadPool::async([fontPath, sizes] {
+        ScopedTrace span("rebuild glyph atlas", "load");
+        // Its own context for the font page readbacks, and its own copy of
+        // the font: sf::Font is not safe to share with the game thread
+        sf::Context context;
+        sf::Font font;
+        auto atlas = std::make_unique<GlyphAtlas>();
+        if (!font.loadFromFile(fontPath)) {
+            std::cerr << "ERROR::GAME::Cannot rebuild glyph atlas from "
+                      << fontPath << "\n";
+            return std::unique_ptr<GlyphAtlas>();
+        }
+        for (unsigned size : sizes) {
+            atlas->prewarm(font, size);
+        }
+        return atlas;
+    });
+}
+
+void Game::updateFontReload() {
+    if (!mAtlasRebuild.valid()) return;
+    ResourceManager& resources = mEngine.getResources();
+    const sf::Font& font = resources.getFont(ResourceIds::MAIN_FONT);
+
+    // The sf::Text widgets' glyphs, a slice per frame
+    const std::size_t perSize = ATLAS_LAST_CHAR - ATLAS_FIRST_CHAR + 1;
+    const std::size_t total = UI_TEXT_SIZES.size() * perSize;
+    for (std::size_t n = 0;
+         n < FONT_GLYPHS_PER_FRAME && mFontGlyphsWarmed < total;
+         ++n, ++mFontGlyphsWarmed) {
+        font.getGlyph(
+            static_cast<std::uint32_t>(ATLAS_FIRST_CHAR +
+                                       mFontGlyphsWarmed % perSize),
+            UI_TEXT_SIZES[mFontGlyphsWarmed / perSize], false);
+    }
+    if (mFontGlyphsWarmed < total ||
+        mAtlasRebuild.wait_for(std::chrono::seconds(0)) !=
+            std::future_status::ready) {
+        return;
+    }
+
+    std::unique_ptr<GlyphAtlas> atlas = mAtlasRebuild.get();
+    if (atlas) {
+        for (AtlasText* text :
+             {&mUiText, &mMaxpointText, &mRestartText, &mAllocText}) {
+            text->setAtlas(*atlas);
+        }
+        mGlyphAtlas = std::move(atlas);
+    }
+    mConsole->setFont(font);
+    // Nothing draws with the replaced fonts any more
+    resources.releaseRetired(PackEntryKind::FONT);
+    mFrameSteady = false;
+
+    if (!mQueuedFontPath.empty()) {
+        startAtlasRebuild(mQueuedFontPath);
+        mQueuedFontPath.clear();
+    }
+}
+#endif
+
 void Game::initEnemies() {
     mEnemy.setPosition(10.f, 10.f);
-    mEnemy.setSize(sf::Vector2f(100.f, 100.f));
-    mEnemy.setScale(sf::Vector2f(0.5f, 0.5f));
+    mEnemy.setSize(toSfml(mSim.getConfig().enemySize));
     mEnemy.setFillColor(sf::Color::Green);
 }
 
+void Game::initGlyphs() {
+    ScopedTrace span("glyph atlas", "startup");
+    const sf::Font& font =
+        mEngine.getResources().getFont(ResourceIds::MAIN_FONT);
+
+    // Baked at build time; prewarm only fills gaps (or everything, on
+    // builds without the baker). The constructor already read it.
+    for (unsigned size : GLYPH_SIZES) {
+        mGlyphAtlas->prewarm(font, size);
+    }
+    for (unsigned size : UI_TEXT_SIZES) {
+        GlyphAtlas::prewarmFont(font, size);
+    }
+}
+
 void Game::initText() {
-    mUiText.setFont(ResourceManager::getInstance().getFont("main"));
+    mUiText.setAtlas(*mGlyphAtlas);
     mUiText.setCharacterSize(50);
     mUiText.setFillColor(sf::Color::Cyan);
     mUiText.setPosition(170.f, 30.f);
     mUiText.setString("NONE");
 
-    mRestartText.setFont(ResourceManager::getInstance().getFont("main"));
+    mAllocText.setAtlas(*mGlyphAtlas);
+    mAllocText.setCharacterSize(18);
+    mAllocText.setFillColor(sf::Color::Yellow);
+    mAllocText.setPosition(10.f, 5.f);
+
+    mRestartText.setAtlas(*mGlyphAtlas);
     mRestartText.setCharacterSize(40);
     mRestartText.setFillColor(sf::Color::White);
-    mRestartText.setPosition((mWindow->getSize().x / 2.f) - 130.f, (mWindow->getSize().y / 2.f) + 50.f);
     mRestartText.setString("Press ENTER to Restart");
+    // Centred from its measured width rather than a pixel offset
+    const sf::FloatRect restartBounds = mRestartText.getLocalBounds();
+    mRestartText.setPosition(
+        (mWindow->getSize().x - restartBounds.width) / 2.f - restartBounds.left,
+        (mWindow->getSize().y / 2.f) + 50.f);
 }
 
 void Game::initMaxPoint() {
-    mMaxpointText.setFont(ResourceManager::getInstance().getFont("main"));
+    mMaxpointText.setAtlas(*mGlyphAtlas);
     mMaxpointText.setCharacterSize(50);
-    mMaxpointText.setColor(sf::Color::White);
+    mMaxpointText.setFillColor(sf::Color::White);
     mMaxpointText.setPosition(-200.f, (mWindow->getSize().y / 2) - 50.f);
 }
 
 const bool Game::running() const { return mWindow->isOpen(); }
 
-const bool Game::getEndGame() const { return mEndGame; }
+// Autoplay restarts the game in update(), so the loop must keep running
+const bool Game::getEndGame() const { return mSim.isOver() && !mAutoplay; }
 
 // Functions
 
-void Game::spawnEnemy() {
-    /*
-    @return void
-    Spawns mEnemies and sets their color and positions.
-    -Sets a random position.
-    -Sets random color.
-    -Adds mEnemy to the vector.
-    */
-    float x, y;
-    x = rand() % 900;
-    y = 100.f;
-    mDistance += mGravity;
-    if (mDistance >= 8) {
-        mEnemy.setPosition(x, y);
-        mDistance = 0;
-        mEnemy.setFillColor(sf::Color::Green);
-        // Spawn the mEnemy
-        mEnemies.push_back(mEnemy);
+void Game::renderEnemies() {
+    if (!mBatchEnemies) {
+        // One draw call per enemy
+        for (const SimEnemy& enemy : mSim.getEnemies()) {
+            mEnemy.setPosition(toSfml(enemy.bounds.getPosition()));
+            mEnemy.setFillColor(toSfml(enemy.color));
+            mWindow->draw(mEnemy);
+        }
+        return;
     }
-}
 
-void Game::renderEnemies() {
-    // Rendering all the mEnemies
-    for (auto& i : mEnemies) {
-        mWindow->draw(i);
+    // One draw call for all of them; the array keeps its capacity
+    mEnemyVertices.clear();
+    for (const SimEnemy& enemy : mSim.getEnemies()) {
+        const sf::FloatRect r = toSfml(enemy.bounds);
+        const sf::Color color = toSfml(enemy.color);
+        const sf::Vector2f topLeft(r.left, r.top);
+        const sf::Vector2f topRight(r.left + r.width, r.top);
+        const sf::Vector2f bottomLeft(r.left, r.top + r.height);
+        const sf::Vector2f bottomRight(r.left + r.width, r.top + r.height);
+        mEnemyVertices.append(sf::Vertex(topLeft, color));
+        mEnemyVertices.append(sf::Vertex(topRight, color));
+        mEnemyVertices.append(sf::Vertex(bottomLeft, color));
+        mEnemyVertices.append(sf::Vertex(bottomLeft, color));
+        mEnemyVertices.append(sf::Vertex(topRight, color));
+        mEnemyVertices.append(sf::Vertex(bottomRight, color));
     }
+    mWindow->draw(mEnemyVertices);
 }
 void Game::renderText() { mWindow->draw(mUiText); }
 void Game::nextColor() {
@@ -229,23 +517,22 @@ void Game::renderMaxPoint() {
     if (mMaxpointText.getPosition().x > mWindow->getSize().x)
         mMaxpointText.setPosition(-200.f, mMaxpointText.getPosition().y);
     nextColor();
-    mMaxpointText.setColor(sf::Color(mRed, mGreen, mBlue, 255));
+    mMaxpointText.setFillColor(sf::Color(mRed, mGreen, mBlue, 255));
     mWindow->draw(mMaxpointText);
 }
 
 void Game::pollEvent() {
     // Event Poling
     while (mWindow->pollEvent(mEvent)) {
+        if (mConsole->handleEvent(mEvent, *mWindow)) continue;
+
         if (mEvent.type == sf::Event::Closed)
             mWindow->close();
         else if (mEvent.type == sf::Event::KeyPressed) {
             if (mEvent.key.code == sf::Keyboard::Escape) mWindow->close();
-            if (mEvent.key.code == sf::Keyboard::Enter && mEndGame) {
-                mHealth = 10;
-                mPoints = 0;
-                mEnemies.clear();
-                mEndGame = false;
-                mEnemySpawnTimer = mEnemySpawnTimerMax;
+            if (mEvent.key.code == sf::Keyboard::F1) mConsole->toggle(*mWindow);
+            if (mEvent.key.code == sf::Keyboard::Enter && mSim.isOver()) {
+                mSim.reset();
                 getData(); // Refresh max points explicitly
             }
         }
@@ -282,7 +569,7 @@ std::string Game::saveData() {
     static const std::string FILE_PATH = "data/data.txt";
 
     // Update max point if current score is higher
-    if (mPoints > mMaxPoint) mMaxPoint = mPoints;
+    if (mSim.getPoints() > mMaxPoint) mMaxPoint = mSim.getPoints();
 
     // Write the max point to file
     std::ofstream output_file(FILE_PATH);
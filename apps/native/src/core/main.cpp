@@ -1,4 +1,21 @@
+#include <cstdlib>
+#include <cstring>
+
 #include "core/Game.h"
+#include "server/LoadTestClient.h"
+#include "server/TournamentServer.h"
+#include "systems/MonteCarlo.h"
+#include "systems/MultiWorld.h"
+#include "systems/PgoTraining.h"
+#include "systems/SoakTest.h"
+#include "systems/StartupBenchmark.h"
+#include "ui/UIStressBenchmark.h"
+
+namespace {
+// Start the trace clock during static init, so the startup trace and
+// time-to-first-frame include everything before main()
+TraceRecorder& gStartupTrace = TraceRecorder::getInstance();
+}  // namespace
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -18,19 +35,99 @@ void emscriptenLoop(void* arg) {
 }  // namespace
 #endif
 
-int main() {
+int main(int argc, char** argv) {
 #ifdef __EMSCRIPTEN__
     auto* game = new Game();
     emscripten_set_main_loop_arg(emscriptenLoop, game, 0, 1);
 #else
+    bool exitAfterFirstFrame = false;
+    int startupBenchLaunches = 0;
+    bool coldStart = false;
+    bool uiBench = false;
+    bool autoplay = false;
+    int pgoTrainMinutes = 0;
+    int soakHours = 0;
+    bool simulate = false;
+    bool multiWorld = false;
+    bool serve = false;
+    bool loadTest = false;
+    UIStressBenchmark::Config uiBenchConfig;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], StartupBenchmark::EXIT_AFTER_FIRST_FRAME) ==
+            0) {
+            exitAfterFirstFrame = true;
+        } else if (std::strcmp(argv[i], "--startup-bench") == 0 &&
+                   i + 1 < argc) {
+            startupBenchLaunches = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--cold") == 0) {
+            coldStart = true;
+        } else if (std::strcmp(argv[i], PgoTraining::FLAG) == 0) {
+            pgoTrainMinutes = PgoTraining::DEFAULT_MINUTES;
+            if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+                pgoTrainMinutes = std::atoi(argv[++i]);
+            }
+        } else if (std::strcmp(argv[i], SoakTest::FLAG) == 0) {
+            soakHours = SoakTest::DEFAULT_HOURS;
+            if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+                soakHours = std::atoi(argv[++i]);
+            }
+        } else if (std::strcmp(argv[i], MonteCarlo::FLAG) == 0) {
+            simulate = true;  // MonteCarlo::run parses its own options
+        } else if (std::strcmp(argv[i], MultiWorld::FLAG) == 0) {
+            multiWorld = true;
+        } else if (std::strcmp(argv[i], TournamentServer::FLAG) == 0) {
+            serve = true;
+        } else if (std::strcmp(argv[i], LoadTestClient::FLAG) == 0) {
+            loadTest = true;
+        } else if (std::strcmp(argv[i], "--autoplay") == 0) {
+            autoplay = true;
+        } else if (std::strcmp(argv[i], "--ui-bench") == 0) {
+            uiBench = true;
+            if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+                uiBenchConfig.frames =
+                    static_cast<unsigned>(std::atoi(argv[++i]));
+            }
+        }
+    }
+
+    // Relaunch ourselves N times and report time-to-first-frame
+    if (startupBenchLaunches > 0) {
+        return StartupBenchmark::run(argv[0], startupBenchLaunches, coldStart);
+    }
+
+    if (uiBench) return UIStressBenchmark::run(uiBenchConfig);
+
+    // Headless: no window, so it runs on build machines
+    if (pgoTrainMinutes > 0) {
+        return PgoTraining::run(static_cast<unsigned>(pgoTrainMinutes));
+    }
+    if (soakHours > 0) return SoakTest::run(static_cast<unsigned>(soakHours));
+    if (simulate) return MonteCarlo::run(argc, argv);
+    if (multiWorld) return MultiWorld::run(argc, argv);
+    if (serve) return TournamentServer::run(argc, argv);
+    if (loadTest) return LoadTestClient::run(argc, argv);
+
     // Init Game engine
-    Game game;
+    Game game(exitAfterFirstFrame, autoplay);
+
+#ifdef DEBUG_MODE
+    bool traceWritten = false;
+#endif
 
     // Game Loop
     while (game.running() && !game.getEndGame()) {
         game.update();
         // render
         game.render();
+
+#ifdef DEBUG_MODE
+        // Open in chrome://tracing to see what startup is waiting on
+        if (!traceWritten) {
+            TraceRecorder::getInstance().writeChromeTrace(
+                "data/startup_trace.json");
+            traceWritten = true;
+        }
+#endif
     }
 #endif
 
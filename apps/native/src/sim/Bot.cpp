@@ -0,0 +1,147 @@
+#include "sim/Bot.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const char* const LEVEL_NAMES[BotSkill::LEVEL_COUNT] = {"novice", "casual",
+                                                        "expert"};
+
+float distance(const Vec2& a, const Vec2& b) {
+    const Vec2 d = b - a;
+    return std::sqrt(d.x * d.x + d.y * d.y);
+}
+
+}  // namespace
+
+BotSkill BotSkill::level(unsigned index) {
+    switch (index % LEVEL_COUNT) {
+        case 0:
+            return novice();
+        case 1:
+            return casual();
+        default:
+            return expert();
+    }
+}
+
+const char* BotSkill::levelName(unsigned index) {
+    return LEVEL_NAMES[index % LEVEL_COUNT];
+}
+
+bool BotSkill::fromName(const std::string& name, BotSkill& skill) {
+    for (unsigned index = 0; index < LEVEL_COUNT; ++index) {
+        if (name == LEVEL_NAMES[index]) {
+            skill = level(index);
+            return true;
+        }
+    }
+    return false;
+}
+
+Bot::Bot(const BotSkill& skill, std::uint64_t seed)
+    : mSkill(skill),
+      mRandom(seed),
+      mCursor(500.f, 350.f),
+      mClicks(0),
+      mPlanLength(0) {
+    reset();
+}
+
+void Bot::reset() {
+    mClock = 0.f;
+    mNextClickAt = 0.f;
+    mPressed = false;
+    mJobs.clear();
+    mPlanLength = 0;
+}
+
+float Bot::gaussian() {
+    // Box-Muller; 1 - u keeps the log argument above zero
+    const float u = 1.f - mRandom.nextFloat();
+    const float v = mRandom.nextFloat();
+    return std::sqrt(-2.f * std::log(u)) * std::cos(6.2831853f * v);
+}
+
+const SimEnemy* Bot::plan(const Simulation& sim) {
+    const SimConfig& config = sim.getConfig();
+    const float gravity = std::max(config.gravity, 1.f);
+
+    mJobs.clear();
+    for (const SimEnemy& enemy : sim.getEnemies()) {
+        const float age = (enemy.bounds.top - config.spawnY) / gravity;
+        if (age < mSkill.reactionDelay) continue;  // Not noticed yet
+        mJobs.push_back(
+            {&enemy, (config.worldSize.y - enemy.bounds.top) / gravity});
+    }
+    std::sort(mJobs.begin(), mJobs.end(), [](const Job& a, const Job& b) {
+        return a.deadline < b.deadline;
+    });
+
+    // Walk the jobs in deadline order from where the hand is now,
+    // keeping only those it can still reach and press in time
+    const float interval = 1.f / std::max(mSkill.clicksPerSecond, 0.01f);
+    const float speed = std::max(mSkill.handSpeed, 1.f);
+    float earliestClick = std::max(0.f, mNextClickAt - mClock);
+    float now = 0.f;
+    Vec2 hand = mCursor;
+    const SimEnemy* first = nullptr;
+    mPlanLength = 0;
+    for (const Job& job : mJobs) {
+        const Vec2 center = job.enemy->bounds.getCenter();
+        // Aim where it will be on arrival; two passes settle the estimate
+        float arrive = now + distance(hand, center) / speed;
+        Vec2 target = center + Vec2(0.f, gravity * arrive);
+        arrive = now + distance(hand, target) / speed;
+        target = center + Vec2(0.f, gravity * arrive);
+
+        const float click = std::max(arrive, earliestClick);
+        if (click >= job.deadline) continue;
+
+        if (first == nullptr) first = job.enemy;
+        ++mPlanLength;
+        now = click;
+        earliestClick = click + interval;
+        hand = target;
+    }
+    return first;
+}
+
+SimInput Bot::think(const Simulation& sim, float deltaTime) {
+    mClock += deltaTime;
+    SimInput input;
+
+    // A press has to be released before the next one counts
+    if (mPressed) {
+        mPressed = false;
+        input.mouse = mCursor;
+        return input;
+    }
+
+    const SimEnemy* target = plan(sim);
+    if (target == nullptr) {
+        input.mouse = mCursor;
+        return input;
+    }
+
+    // The simulation moves enemies before it tests the click, so lead
+    // the target by one step of its fall
+    const Vec2 aim = target->bounds.getCenter() +
+                     Vec2(0.f, sim.getConfig().gravity * deltaTime);
+    const float reach = mSkill.handSpeed * deltaTime;
+    const float gap = distance(mCursor, aim);
+    mCursor = gap <= reach ? aim : mCursor + (aim - mCursor) * (reach / gap);
+    input.mouse = mCursor;
+
+    const float onTarget =
+        0.25f * std::min(target->bounds.width, target->bounds.height);
+    if (distance(mCursor, aim) <= onTarget && mClock >= mNextClickAt) {
+        input.mouse = mCursor + Vec2(gaussian(), gaussian()) * mSkill.aimNoise;
+        input.mouseDown = true;
+        mPressed = true;
+        mNextClickAt = mClock + 1.f / std::max(mSkill.clicksPerSecond, 0.01f);
+        ++mClicks;
+    }
+    return input;
+}
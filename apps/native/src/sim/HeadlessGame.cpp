@@ -0,0 +1,70 @@
+#include "sim/HeadlessGame.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedUs(Clock::time_point since) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - since)
+        .count();
+}
+
+}  // namespace
+
+HeadlessGame::HeadlessGame(const SimConfig& config, std::uint64_t seed,
+                           std::size_t particlePool)
+    : mSim(config, seed),
+      // Own stream, so particle counts never change the game's randomness
+      mParticles(particlePool, seed ^ 0x5DEECE66Dull),
+      mMaxPoint(0),
+      mGamesPlayed(0),
+      mTimed(false) {
+    formatHud();
+}
+
+void HeadlessGame::frame(float deltaTime, const SimInput& input) {
+    if (mSim.isOver()) return;
+
+    Clock::time_point start;
+    if (mTimed) start = Clock::now();
+    mSim.step(deltaTime, input);
+    for (const SimEvent& event : mSim.getEvents()) {
+        if (event.type == SimEventType::HIT) {
+            mParticles.emitClickEffect(event.position, event.color);
+        } else if (event.type == SimEventType::GAME_OVER) {
+            if (mSim.getPoints() > mMaxPoint) mMaxPoint = mSim.getPoints();
+            ++mGamesPlayed;
+        }
+    }
+    if (mTimed) {
+        mTimings.simulationUs = elapsedUs(start);
+        start = Clock::now();
+    }
+
+    mParticles.update(deltaTime);
+    if (mTimed) {
+        mTimings.particlesUs = elapsedUs(start);
+        start = Clock::now();
+    }
+
+    formatHud();
+    if (mTimed) mTimings.hudUs = elapsedUs(start);
+}
+
+void HeadlessGame::restart() {
+    mSim.reset();
+    mParticles.clear();
+    formatHud();
+}
+
+void HeadlessGame::formatHud() {
+    // Same text as Game::updateText; assigning reuses mHud's storage
+    char text[96];
+    std::snprintf(text, sizeof(text),
+                  "Health = %d     Points = %u     Max Point = %u",
+                  mSim.getHealth(), mSim.getPoints(), mMaxPoint);
+    mHud = text;
+}
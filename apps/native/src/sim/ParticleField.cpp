@@ -0,0 +1,114 @@
+#include "sim/ParticleField.h"
+
+#include <cmath>
+
+ParticleField::ParticleField(std::size_t poolSize, std::uint64_t seed)
+    : mParticles(poolSize), mRandom(seed) {}
+
+void ParticleField::emitBurst(const Vec2& position, int count,
+                              const Rgba& color, float speed) {
+    int emitted = 0;
+    for (auto& particle : mParticles) {
+        if (emitted >= count) break;
+        if (!particle.active) {
+            emitParticle(particle, position, color, speed);
+            emitted++;
+        }
+    }
+}
+
+void ParticleField::emitClickEffect(const Vec2& position,
+                                    const Rgba& enemyColor) {
+    emitBurst(position, 20, enemyColor, 200.f);
+}
+
+void ParticleField::emitMissEffect(const Vec2& position) {
+    emitBurst(position, 10, Rgba(255, 100, 100), 100.f);
+}
+
+void ParticleField::emitComboEffect(const Vec2& position) {
+    const Rgba gold(255, 215, 0);
+    for (int i = 0; i < 5; i++) {
+        int available = 0;
+        for (auto& particle : mParticles) {
+            if (!particle.active && available < 3) {
+                emitParticle(particle, position, gold, 150.f);
+                particle.startSize = 8.f;
+                particle.maxLifetime = 1.5f;
+                available++;
+            }
+        }
+    }
+}
+
+void ParticleField::update(float deltaTime) {
+    for (auto& particle : mParticles) {
+        if (!particle.active) continue;
+
+        particle.lifetime += deltaTime;
+        if (particle.lifetime >= particle.maxLifetime) {
+            particle.active = false;
+            continue;
+        }
+
+        particle.position += particle.velocity * deltaTime;
+        particle.velocity.y += GRAVITY * deltaTime;
+
+        // Interpolation factor (0 to 1)
+        const float t = particle.lifetime / particle.maxLifetime;
+        particle.size =
+            particle.startSize + (particle.endSize - particle.startSize) * t;
+
+        const Rgba& from = particle.startColor;
+        const Rgba& to = particle.endColor;
+        particle.color.r = static_cast<std::uint8_t>(from.r + (to.r - from.r) * t);
+        particle.color.g = static_cast<std::uint8_t>(from.g + (to.g - from.g) * t);
+        particle.color.b = static_cast<std::uint8_t>(from.b + (to.b - from.b) * t);
+        particle.color.a = static_cast<std::uint8_t>(255 * (1.f - t));  // Fade out
+    }
+}
+
+void ParticleField::resize(std::size_t poolSize) {
+    if (poolSize == mParticles.size()) return;
+    mParticles.assign(poolSize, SimParticle());
+}
+
+void ParticleField::clear() {
+    for (auto& particle : mParticles) {
+        particle.active = false;
+    }
+}
+
+int ParticleField::getActiveCount() const {
+    int count = 0;
+    for (const auto& particle : mParticles) {
+        if (particle.active) count++;
+    }
+    return count;
+}
+
+void ParticleField::emitParticle(SimParticle& particle, const Vec2& position,
+                                 const Rgba& color, float speed) {
+    particle.active = true;
+    particle.lifetime = 0.f;
+    particle.maxLifetime =
+        0.5f + static_cast<float>(mRandom.nextInt(100)) / 200.f;  // 0.5-1.0s
+
+    // Random direction, slight upward bias
+    const float angle =
+        static_cast<float>(mRandom.nextInt(360)) * 3.14159f / 180.f;
+    const float velocityMag = speed + static_cast<float>(mRandom.nextInt(100));
+    particle.velocity.x = std::cos(angle) * velocityMag;
+    particle.velocity.y = std::sin(angle) * velocityMag - 100.f;
+
+    particle.position = position;
+
+    particle.startColor = color;
+    particle.endColor = color;
+    particle.endColor.a = 0;
+    particle.color = color;
+
+    particle.startSize = 3.f + static_cast<float>(mRandom.nextInt(5));
+    particle.endSize = 0.5f;
+    particle.size = particle.startSize;
+}
@@ -0,0 +1,177 @@
+#include "sim/Scenario.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+bool applySetting(Scenario& scenario, const std::string& name, float value) {
+    SimConfig& config = scenario.config;
+    if (name == "gravity") {
+        config.gravity = value;
+    } else if (name == "spawn_interval") {
+        config.spawnInterval = value;
+    } else if (name == "max_enemies") {
+        config.maxEnemies = static_cast<int>(value);
+    } else if (name == "start_health") {
+        config.startHealth = static_cast<int>(value);
+    } else if (name == "auto_spawn") {
+        config.autoSpawn = value != 0.f;
+    } else if (name == "particle_pool") {
+        scenario.particlePool = static_cast<std::size_t>(value);
+    } else if (name == "restart") {
+        scenario.restartOnGameOver = value != 0.f;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+bool Scenario::load(const std::string& path, Scenario& scenario) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::SCENARIO::Cannot open " << path << "\n";
+        return false;
+    }
+
+    scenario = Scenario();
+    scenario.name = std::filesystem::path(path).stem().string();
+
+    std::string line;
+    int number = 0;
+    while (std::getline(file, line)) {
+        ++number;
+        const std::size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        std::istringstream fields(line);
+        std::string keyword;
+        if (!(fields >> keyword)) continue;
+
+        bool ok = true;
+        if (keyword == "seed") {
+            ok = static_cast<bool>(fields >> scenario.seed);
+        } else if (keyword == "frames") {
+            ok = static_cast<bool>(fields >> scenario.frames);
+        } else if (keyword == "timestep") {
+            ok = static_cast<bool>(fields >> scenario.timestep) &&
+                 scenario.timestep > 0.f;
+        } else if (keyword == "set") {
+            std::string name;
+            float value;
+            ok = (fields >> name >> value) &&
+                 applySetting(scenario, name, value);
+        } else if (keyword == "spawn") {
+            ScenarioAction action{0, ScenarioAction::Kind::SPAWN, Vec2()};
+            ok = static_cast<bool>(fields >> action.frame >> action.position.x);
+            if (ok) scenario.actions.push_back(action);
+        } else if (keyword == "click") {
+            ScenarioAction action{0, ScenarioAction::Kind::CLICK, Vec2()};
+            ok = static_cast<bool>(fields >> action.frame >>
+                                   action.position.x >> action.position.y);
+            if (ok) scenario.actions.push_back(action);
+        } else if (keyword == "aim") {
+            ScenarioAim aim{0, 0, 1};
+            ok = (fields >> aim.first >> aim.last >> aim.every) &&
+                 aim.every > 0;
+            if (ok) scenario.aims.push_back(aim);
+        } else if (keyword == "bot") {
+            std::string skill;
+            ScenarioBot bot{BotSkill(), 0, 0};
+            ok = (fields >> skill >> bot.first >> bot.last) &&
+                 BotSkill::fromName(skill, bot.skill);
+            if (ok) scenario.bots.push_back(bot);
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            std::cerr << "ERROR::SCENARIO::" << path << ":" << number
+                      << ": cannot parse '" << line << "'\n";
+            return false;
+        }
+    }
+
+    std::stable_sort(scenario.actions.begin(), scenario.actions.end(),
+                     [](const ScenarioAction& a, const ScenarioAction& b) {
+                         return a.frame < b.frame;
+                     });
+    return true;
+}
+
+std::vector<std::string> Scenario::list(const std::string& directory) {
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto& entry :
+         std::filesystem::directory_iterator(directory, error)) {
+        if (entry.path().extension() == ".scenario") {
+            paths.push_back(entry.path().string());
+        }
+    }
+    if (error) {
+        std::cerr << "ERROR::SCENARIO::Cannot list " << directory << ": "
+                  << error.message() << "\n";
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+ScenarioPlayer::ScenarioPlayer(const Scenario& scenario)
+    : mScenario(scenario),
+      mNextAction(0),
+      mFrame(0),
+      // Own stream, so a bot never changes the game's randomness
+      mBot(BotSkill(), scenario.seed ^ 0xB07B07ull) {}
+
+bool ScenarioPlayer::aimAt(const Simulation& sim, SimInput& input) const {
+    const SimEnemy* lowest = sim.findLowestEnemy();
+    if (!lowest) return false;
+    input.mouse = lowest->bounds.getCenter();
+    input.mouseDown = true;
+    return true;
+}
+
+void ScenarioPlayer::playFrame(HeadlessGame& game) {
+    Simulation& sim = game.getSim();
+    if (sim.isOver() && mScenario.restartOnGameOver) {
+        game.restart();
+        mBot.reset();
+    }
+
+    SimInput input;
+    for (; mNextAction < mScenario.actions.size() &&
+           mScenario.actions[mNextAction].frame <= mFrame;
+         ++mNextAction) {
+        const ScenarioAction& action = mScenario.actions[mNextAction];
+        if (action.kind == ScenarioAction::Kind::SPAWN) {
+            sim.spawnAt(action.position.x);
+        } else {
+            input.mouse = action.position;
+            input.mouseDown = true;
+        }
+    }
+    // The bot thinks on every frame of its range, so its clock and cursor
+    // keep up even when a scripted click takes the frame
+    for (const ScenarioBot& bot : mScenario.bots) {
+        if (mFrame < bot.first || mFrame > bot.last) continue;
+        mBot.getSkill() = bot.skill;
+        const SimInput thought = mBot.think(sim, mScenario.timestep);
+        if (!input.mouseDown) input = thought;
+        break;
+    }
+    if (!input.mouseDown) {
+        for (const ScenarioAim& aim : mScenario.aims) {
+            if (mFrame >= aim.first && mFrame <= aim.last &&
+                (mFrame - aim.first) % aim.every == 0 && aimAt(sim, input)) {
+                break;
+            }
+        }
+    }
+
+    game.frame(mScenario.timestep, input);
+    ++mFrame;
+}
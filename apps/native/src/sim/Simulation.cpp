@@ -0,0 +1,111 @@
+#include "sim/Simulation.h"
+
+#include <algorithm>
+
+Simulation::Simulation(const SimConfig& config, std::uint64_t seed)
+    : mConfig(config), mRandom(seed) {
+    reset();
+}
+
+void Simulation::reset() {
+    mEnemies.clear();
+    mEvents.clear();
+    // Working size up front, so steady frames never grow either vector:
+    // at most every enemy misses plus a hit and the game over per step
+    const std::size_t maxEnemies =
+        static_cast<std::size_t>(std::max(mConfig.maxEnemies, 0));
+    mEnemies.reserve(maxEnemies);
+    mEvents.reserve(maxEnemies + 2);
+    mSpawnTimer = mConfig.spawnInterval;
+    mDistance = 0.f;
+    mPoints = 0;
+    mHealth = mConfig.startHealth;
+    mMouseHeld = false;
+    mEndGame = false;
+    mFrame = 0;
+}
+
+void Simulation::step(float deltaTime, const SimInput& input) {
+    mEvents.clear();
+    if (mEndGame) return;
+    ++mFrame;
+
+    // The spawn timer counts frames, as it always has
+    if (mConfig.autoSpawn &&
+        mEnemies.size() < static_cast<std::size_t>(mConfig.maxEnemies)) {
+        if (mSpawnTimer >= mConfig.spawnInterval) {
+            spawnEnemy();
+            mSpawnTimer = 0.f;
+        } else {
+            mSpawnTimer += 1.f;
+        }
+    }
+
+    moveEnemies(deltaTime);
+
+    if (input.mouseDown) {
+        if (!mMouseHeld) {
+            mMouseHeld = true;
+            handleClick(input);
+        }
+    } else {
+        mMouseHeld = false;
+    }
+}
+
+void Simulation::spawnEnemy() {
+    const float x = static_cast<float>(mRandom.nextInt(mConfig.spawnWidth));
+    mDistance += mConfig.gravity;
+    if (mDistance >= 8.f) {
+        mDistance = 0.f;
+        spawnAt(x);
+    }
+}
+
+const SimEnemy* Simulation::findLowestEnemy() const {
+    const SimEnemy* lowest = nullptr;
+    for (const SimEnemy& enemy : mEnemies) {
+        if (!lowest || enemy.bounds.top > lowest->bounds.top) lowest = &enemy;
+    }
+    return lowest;
+}
+
+void Simulation::spawnAt(float x) {
+    mEnemies.push_back(
+        {Rect(Vec2(x, mConfig.spawnY), mConfig.enemySize), Rgba(0, 255, 0)});
+}
+
+void Simulation::moveEnemies(float deltaTime) {
+    const float fall = mConfig.gravity * deltaTime;
+    for (std::size_t i = 0; i < mEnemies.size();) {
+        SimEnemy& enemy = mEnemies[i];
+        enemy.bounds.top += fall;
+        if (enemy.bounds.top <= mConfig.worldSize.y) {
+            ++i;
+            continue;
+        }
+
+        mEvents.push_back({SimEventType::MISS, enemy.bounds.getCenter(),
+                           enemy.color});
+        mEnemies.erase(mEnemies.begin() + i);
+        mHealth--;
+        if (mHealth <= 0 && !mEndGame) {
+            mEndGame = true;
+            mEvents.push_back({SimEventType::GAME_OVER, Vec2(), Rgba()});
+        }
+    }
+}
+
+void Simulation::handleClick(const SimInput& input) {
+    if (input.clickBlocked) return;
+    for (std::size_t i = 0; i < mEnemies.size(); ++i) {
+        if (!mEnemies[i].bounds.contains(input.mouse)) continue;
+
+        mEvents.push_back({SimEventType::HIT, mEnemies[i].bounds.getCenter(),
+                           mEnemies[i].color});
+        mEnemies.erase(mEnemies.begin() + i);
+        mHealth++;
+        mPoints++;
+        return;
+    }
+}
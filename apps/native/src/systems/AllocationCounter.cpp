@@ -0,0 +1,73 @@
+#include "systems/AllocationCounter.h"
+
+#ifndef FALLING_FURY_ALLOC_TRACKING
+#error "AllocationCounter.cpp is only built with FALLING_FURY_ALLOC_TRACKING"
+#endif
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<std::uint64_t> gAllocations{0};
+std::atomic<std::uint64_t> gBytes{0};
+std::atomic<std::uint64_t> gFrees{0};
+std::atomic<std::uint64_t> gTagAllocations[ALLOCATION_TAG_COUNT];
+std::atomic<std::uint64_t> gTagBytes[ALLOCATION_TAG_COUNT];
+// Constant-initialized, so reading it never allocates or runs a TLS
+// constructor
+thread_local AllocationTag gTag = AllocationTag::UNTAGGED;
+
+void* countedAlloc(std::size_t size) {
+    const std::size_t tag = static_cast<std::size_t>(gTag);
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    gBytes.fetch_add(size, std::memory_order_relaxed);
+    gTagAllocations[tag].fetch_add(1, std::memory_order_relaxed);
+    gTagBytes[tag].fetch_add(size, std::memory_order_relaxed);
+    // malloc(0) may return nullptr, which operator new must not
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void countedFree(void* p) {
+    if (p) gFrees.fetch_add(1, std::memory_order_relaxed);
+    std::free(p);
+}
+}  // namespace
+
+std::uint64_t AllocationCounter::count() {
+    return gAllocations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::bytes() {
+    return gBytes.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::frees() {
+    return gFrees.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::count(AllocationTag tag) {
+    return gTagAllocations[static_cast<std::size_t>(tag)].load(
+        std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::bytes(AllocationTag tag) {
+    return gTagBytes[static_cast<std::size_t>(tag)].load(
+        std::memory_order_relaxed);
+}
+
+AllocationTag AllocationCounter::setTag(AllocationTag tag) {
+    const AllocationTag previous = gTag;
+    gTag = tag;
+    return previous;
+}
+
+// The nothrow forms forward to these; over-aligned allocations are not
+// counted
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
@@ -0,0 +1,91 @@
+/**
+ * @file ConcurrentResourceTableTest.cpp
+ * @brief Two threads acquiring the same evicted resource at once
+ *
+ * Both must get the same value from a single reload: a second load
+ * published over the first would retire a value the first thread's
+ * handle still points at. Exit code 1 on failure.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+#include "managers/ConcurrentResourceTable.h"
+
+namespace {
+
+using Table = ConcurrentResourceTable<int>;
+
+constexpr int ROUNDS = 200;
+constexpr std::size_t BYTES = 100;
+
+bool check(bool condition, const char* what, int round) {
+    if (!condition) {
+        std::fprintf(stderr, "ERROR::RESOURCETABLETEST::Round %d: %s\n", round,
+                     what);
+    }
+    return condition;
+}
+
+}  // namespace
+
+int main() {
+    std::atomic<int> loads{0};
+    // Slow enough that both threads are inside acquire() during the load
+    Table::Loader loader = [&loads] {
+        loads.fetch_add(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        Table::Loaded loaded;
+        loaded.value = std::make_unique<int>(42);
+        loaded.bytes = BYTES;
+        return loaded;
+    };
+
+    // Room for one of the two values
+    Table table(16);
+    table.setBudget(BYTES);
+    table.insert("shared", loader(), loader);
+    table.insert("other", loader(), loader);
+
+    bool ok = true;
+    for (int round = 0; round < ROUNDS && ok; ++round) {
+        // Touch "other" last so trim() evicts "shared"
+        table.acquire("other");
+        table.trim();
+        if (!check(table.find(ResourceId("shared")) == nullptr, "not evicted", round)) {
+            return 1;
+        }
+
+        loads = 0;
+        std::atomic<int> waiting{2};
+        ResourceHandle<int> first;
+        ResourceHandle<int> second;
+        auto acquire = [&](ResourceHandle<int>& handle) {
+            waiting.fetch_sub(1);
+            while (waiting.load() > 0) {
+            }
+            handle = table.acquire("shared");
+        };
+        std::thread a(acquire, std::ref(first));
+        std::thread b(acquire, std::ref(second));
+        a.join();
+        b.join();
+
+        ok = check(first && second, "acquire failed", round) &&
+             check(first.get() == second.get(), "two copies", round) &&
+             check(loads == 1, "loaded more than once", round) &&
+             check(*first == 42, "wrong value", round) &&
+             check(table.releaseRetired() == 0, "value retired", round);
+
+        // Let "shared" be evicted again next round
+        first = ResourceHandle<int>();
+        second = ResourceHandle<int>();
+    }
+    if (!ok) return 1;
+    std::printf("ConcurrentResourceTable: %d concurrent restores ok\n",
+                ROUNDS);
+    return 0;
+}
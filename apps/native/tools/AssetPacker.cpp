@@ -0,0 +1,128 @@
+/**
+ * @file AssetPacker.cpp
+ * @brief Build-time tool that bundles assets into a single .ffpk archive
+ *
+ * Usage: FallingFuryPacker <manifest> <output.ffpk>
+ *
+ * See managers/AssetManifest.h for the manifest format and
+ * managers/AssetPack.h for the archive layout.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "managers/AssetManifest.h"
+#include "managers/AssetPack.h"
+#include "managers/ResourceId.h"
+#include "systems/Lz4Lite.h"
+
+namespace {
+
+bool readFile(const std::string& path, std::vector<std::uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) return false;
+    data.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()),
+              static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+std::uint64_t alignUp(std::uint64_t value) {
+    return (value + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <manifest> <output.ffpk>\n";
+        return 1;
+    }
+
+    std::vector<ManifestItem> items;
+    if (!AssetManifest::read(argv[1], items)) return 1;
+
+    // Collision check: the same thing ResourceTable does at registration
+    ResourceTable<int> names;
+    for (const auto& item : items) {
+        if (!names.insert(item.name, 0)) return 1;
+    }
+
+    std::vector<PackEntry> entries(items.size());
+    std::vector<std::vector<std::uint8_t>> blobs(items.size());
+    std::uint64_t offset =
+        alignUp(sizeof(PackHeader) + items.size() * sizeof(PackEntry));
+
+    for (std::size_t i = 0; i < items.size(); ++i) {
+        const ManifestItem& item = items[i];
+        std::vector<std::uint8_t> raw;
+        if (!readFile(item.path, raw)) {
+            std::cerr << "ERROR::PACKER::Cannot read asset: " << item.path
+                      << "\n";
+            return 1;
+        }
+
+        PackEntry& entry = entries[i];
+        std::memset(&entry, 0, sizeof(entry));
+        entry.id = ResourceId(item.name).value;
+        entry.kind = item.kind;
+        entry.rawSize = raw.size();
+        std::strncpy(entry.name, item.name.c_str(), PACK_NAME_LENGTH - 1);
+
+        blobs[i] = std::move(raw);
+        if (item.compress) {
+            auto packed = Lz4Lite::compress(blobs[i].data(), blobs[i].size());
+            // Only worth a decode step at startup if it saves 10%
+            if (packed.size() * 10 < blobs[i].size() * 9) {
+                blobs[i] = std::move(packed);
+                entry.flags |= PACK_ENTRY_LZ4;
+            }
+        }
+
+        entry.offset = offset;
+        entry.storedSize = blobs[i].size();
+        offset = alignUp(offset + entry.storedSize);
+
+        std::cout << "  " << item.name << ": " << entry.rawSize << " -> "
+                  << entry.storedSize << " bytes"
+                  << (entry.isCompressed() ? " (lz4)" : "") << "\n";
+    }
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "ERROR::PACKER::Cannot write pack: " << argv[2] << "\n";
+        return 1;
+    }
+
+    PackHeader header;
+    std::memcpy(header.magic, PACK_MAGIC, sizeof(header.magic));
+    header.version = PACK_VERSION;
+    header.entryCount = static_cast<std::uint32_t>(entries.size());
+    header.reserved = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        // Zero padding up to the entry's aligned offset
+        std::uint64_t position = static_cast<std::uint64_t>(out.tellp());
+        std::vector<char> padding(entries[i].offset - position, 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        out.write(reinterpret_cast<const char*>(blobs[i].data()),
+                  static_cast<std::streamsize>(blobs[i].size()));
+    }
+
+    if (!out) {
+        std::cerr << "ERROR::PACKER::Write failed: " << argv[2] << "\n";
+        return 1;
+    }
+
+    std::cout << "Packed " << entries.size() << " assets into " << argv[2]
+              << " (" << offset << " bytes)\n";
+    return 0;
+}
@@ -0,0 +1,325 @@
+/**
+ * @file BenchFallingFury.cpp
+ * @brief Headless micro-benchmarks for the game's hot paths
+ *
+ * Usage: bench_falling_fury [--warmup N] [--reps N] [--min-ms MS]
+ *                           [--filter TEXT] [--label TEXT] [--json PATH]
+ *
+ * Covers object pooling, particles, enemy update and hit-testing, the
+ * core simulation step and bot planning, enemy creation, leaderboard inserts and HUD text
+ * formatting. Nothing opens a
+ * window or needs a GL context, so it runs on CI machines as well. Run it
+ * on two commits with --json and compare median_ns (differences smaller
+ * than a few MADs are noise).
+ *
+ * Score files are written to a scratch directory under the system temp
+ * directory, never to the real data/ directory.
+ */
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "entities/Enemy.h"
+#include "managers/ScoreManager.h"
+#include "sim/Bot.h"
+#include "sim/Simulation.h"
+#include "systems/HeadlessRun.h"
+#include "systems/MicroBenchmark.h"
+#include "systems/ObjectPool.h"
+#include "systems/ParticleSystem.h"
+
+namespace {
+
+constexpr float FRAME_TIME = 1.f / 60.f;
+constexpr float SCREEN_HEIGHT = 700.f;
+constexpr int ENEMY_COUNT = 30;  // Game's default max_enemies
+constexpr std::size_t POOL_BATCH = 64;
+
+struct PooledThing {
+    sf::Vector2f position;
+    float lifetime = 0.f;
+};
+
+void benchObjectPool(MicroBenchmark::Suite& suite) {
+    ObjectPool<PooledThing> pool(
+        POOL_BATCH, [] { return std::make_unique<PooledThing>(); },
+        [](PooledThing* thing) { *thing = PooledThing(); }, false);
+    std::vector<PooledThing*> taken;
+    taken.reserve(POOL_BATCH);
+
+    // Released in the order acquired, as things expire in spawn order
+    suite.run("object_pool/acquire_release_64", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            for (std::size_t k = 0; k < POOL_BATCH; ++k) {
+                taken.push_back(pool.acquire());
+            }
+            for (PooledThing* thing : taken) pool.release(thing);
+            taken.clear();
+        }
+    });
+}
+
+void benchParticles(MicroBenchmark::Suite& suite) {
+    ParticleSystem particles(200);
+    suite.run("particles/emit_click_effect", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            particles.clear();
+            particles.emitClickEffect(sf::Vector2f(500.f, 350.f),
+                                      sf::Color::Green);
+        }
+    });
+
+    // Steady state: one burst a frame keeps most of the pool alive
+    particles.clear();
+    suite.run("particles/update_200", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            if (particles.getActiveCount() < 150) {
+                particles.emitClickEffect(sf::Vector2f(500.f, 350.f),
+                                          sf::Color::Green);
+            }
+            particles.update(FRAME_TIME);
+        }
+    });
+}
+
+void benchEnemies(MicroBenchmark::Suite& suite) {
+    std::srand(42);
+    std::vector<std::unique_ptr<Enemy>> enemies;
+    for (int i = 0; i < ENEMY_COUNT; ++i) {
+        enemies.push_back(EnemyFactory::createRandomEnemy(
+            sf::Vector2f(static_cast<float>(std::rand() % 900),
+                         static_cast<float>(std::rand() % 600))));
+    }
+
+    suite.run("enemies/update_30", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            for (auto& enemy : enemies) {
+                enemy->update(FRAME_TIME);
+                if (enemy->isOffScreen(SCREEN_HEIGHT)) {
+                    enemy->setPosition(sf::Vector2f(enemy->getPosition().x, 0.f));
+                }
+            }
+        }
+    });
+
+    // Points sweep the screen so roughly as many tests hit as miss
+    suite.run("enemies/hit_test_30", [&](std::uint64_t n) {
+        int hits = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            const sf::Vector2f point(static_cast<float>(i * 37 % 1000),
+                                     static_cast<float>(i * 53 % 700));
+            for (const auto& enemy : enemies) {
+                if (enemy->isClicked(point)) ++hits;
+            }
+        }
+        MicroBenchmark::keep(hits);
+    });
+
+    // What Game::updateEnemies actually does with its plain rectangles
+    std::vector<sf::RectangleShape> shapes(ENEMY_COUNT);
+    for (int i = 0; i < ENEMY_COUNT; ++i) {
+        shapes[i].setSize(sf::Vector2f(100.f, 100.f));
+        shapes[i].setScale(0.5f, 0.5f);
+        shapes[i].setPosition(static_cast<float>(i * 30), i * 20.f);
+    }
+    suite.run("enemies/game_rects_move_and_hit_30", [&](std::uint64_t n) {
+        int hits = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            const sf::Vector2f mouse(static_cast<float>(i * 37 % 1000),
+                                     static_cast<float>(i * 53 % 700));
+            for (auto& shape : shapes) {
+                shape.move(0.f, 120.f * FRAME_TIME);
+                if (shape.getPosition().y > SCREEN_HEIGHT) {
+                    shape.setPosition(shape.getPosition().x, 0.f);
+                }
+                if (shape.getGlobalBounds().contains(mouse)) ++hits;
+            }
+        }
+        MicroBenchmark::keep(hits);
+    });
+}
+
+// The game rules from FallingFuryCore, with a click every 20 frames
+void benchSimulation(MicroBenchmark::Suite& suite) {
+    SimConfig config;
+    config.spawnInterval = 1.f;  // Fill up to max_enemies quickly
+    config.startHealth = 1 << 30;
+    Simulation sim(config, 42);
+    SimInput input;
+    suite.run("simulation/step_30", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            input.mouse = Vec2(static_cast<float>(i * 37 % 1000),
+                               static_cast<float>(i * 53 % 700));
+            input.mouseDown = i % 20 == 0;
+            sim.step(FRAME_TIME, input);
+        }
+        MicroBenchmark::keep(sim.getPoints());
+    });
+
+    // Planning over a full screen of enemies, as autoplay does each frame
+    Bot bot(BotSkill::casual(), 42);
+    suite.run("simulation/bot_think_30", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            SimInput thought = bot.think(sim, FRAME_TIME);
+            MicroBenchmark::keep(thought);
+        }
+    });
+}
+
+void benchFactory(MicroBenchmark::Suite& suite) {
+    std::srand(7);
+    suite.run("enemy_factory/create_random", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            std::unique_ptr<Enemy> enemy =
+                EnemyFactory::createRandomEnemy(sf::Vector2f(100.f, 100.f));
+            MicroBenchmark::keep(enemy);
+        }
+    });
+
+    // The same spawn and despawn through per-type pools
+    EnemyPool pool;
+    suite.run("enemy_pool/acquire_release_random", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            Enemy* enemy = pool.acquireRandom(sf::Vector2f(100.f, 100.f));
+            MicroBenchmark::keep(enemy);
+            pool.release(enemy);
+        }
+    });
+}
+
+void benchScores(MicroBenchmark::Suite& suite) {
+    ScoreManager& scores = ScoreManager::getInstance();
+    // Includes the sort and the file rewrite, as at game over
+    suite.run("score/add_to_leaderboard", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            scores.addToLeaderboard("Bench", static_cast<unsigned>(i % 500),
+                                    "2024-01-01");
+        }
+    });
+
+    for (int i = 0; i < 5; ++i) scores.addPoints(1);
+    suite.run("text/combo_string", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            std::string combo = scores.getComboString();
+            MicroBenchmark::keep(combo);
+        }
+    });
+}
+
+void benchText(MicroBenchmark::Suite& suite) {
+    int health = 10;
+    unsigned points = 1234;
+
+    // What Game::updateText used to do, without the score file read
+    suite.run("text/hud_stringstream", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            std::stringstream ss;
+            ss << "Health = " << health << "     "
+               << "Points = " << points << "     "
+               << "Max Point = " << 4321;
+            std::string text = ss.str();
+            MicroBenchmark::keep(text);
+        }
+    });
+
+    // ... and with it: Game::getData() opened data/data.txt every frame
+    {
+        std::ofstream seed("data/data.txt");
+        seed << 4321;
+    }
+    suite.run("text/hud_with_score_read", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            unsigned saved = 0;
+            std::ifstream input("data/data.txt");
+            input >> saved;
+            std::stringstream ss;
+            ss << "Health = " << health << "     "
+               << "Points = " << points << "     "
+               << "Max Point = " << std::to_string(saved);
+            std::string text = ss.str();
+            MicroBenchmark::keep(text);
+        }
+    });
+
+    // Game::updateText now: a stack buffer, no disk
+    suite.run("text/hud_snprintf", [&](std::uint64_t n) {
+        for (std::uint64_t i = 0; i < n; ++i) {
+            char text[96];
+            std::snprintf(text, sizeof(text),
+                          "Health = %d     Points = %u     Max Point = %u",
+                          health, points, 4321u);
+            MicroBenchmark::keep(text);
+        }
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    MicroBenchmark::Options options;
+    std::string jsonPath;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--warmup" && hasValue) {
+            options.warmup = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (arg == "--reps" && hasValue) {
+            options.repetitions =
+                static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (arg == "--min-ms" && hasValue) {
+            options.minRepetitionMs = std::atof(argv[++i]);
+        } else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--label" && hasValue) {
+            options.label = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--warmup N] [--reps N] [--min-ms MS]"
+                         " [--filter TEXT] [--label TEXT] [--json PATH]\n";
+            return 1;
+        }
+    }
+    // Relative to where we were started, not the scratch directory
+    if (!jsonPath.empty()) {
+        jsonPath = std::filesystem::absolute(jsonPath).string();
+    }
+    HeadlessRun::ScratchDirectory scratch("falling_fury_bench", "BENCH");
+    if (!scratch.isEntered()) return 1;
+
+    // The systems under test log to std::cout; results use stdio
+    HeadlessRun::NullBuffer discarded;
+    std::streambuf* console = std::cout.rdbuf(&discarded);
+
+    MicroBenchmark::Suite suite(options);
+    benchObjectPool(suite);
+    benchParticles(suite);
+    benchEnemies(suite);
+    benchSimulation(suite);
+    benchFactory(suite);
+    benchScores(suite);
+    benchText(suite);
+    ScoreManager::destroy();
+
+    std::cout.rdbuf(console);
+    if (!jsonPath.empty()) {
+        std::ofstream json(jsonPath);
+        if (!json.is_open()) {
+            std::cerr << "ERROR::BENCH::Cannot write " << jsonPath << "\n";
+            return 1;
+        }
+        suite.writeJson(json);
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file GlyphAtlasBaker.cpp
+ * @brief Build-time tool that pre-rasterizes font glyphs into an atlas
+ *
+ * Usage: FallingFuryAtlasBaker <font> <output.ffga> <size>[,<size>...]
+ *
+ * Rasterizes printable ASCII at each size with the same FreeType settings
+ * sf::Font uses, packs the bitmaps into one alpha atlas and writes it with
+ * the metrics and kerning pairs. See ui/GlyphAtlasFormat.h for the layout.
+ */
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_GLYPH_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "systems/Lz4Lite.h"
+#include "ui/GlyphAtlasFormat.h"
+
+namespace {
+
+constexpr unsigned ATLAS_WIDTH = 1024;
+
+struct BakedGlyph {
+    AtlasGlyphRecord record;
+    std::vector<std::uint8_t> pixels;  // width * height alpha
+};
+
+bool parseSizes(const std::string& text, std::vector<unsigned>& sizes) {
+    std::istringstream fields(text);
+    std::string field;
+    while (std::getline(fields, field, ',')) {
+        const int size = std::atoi(field.c_str());
+        if (size <= 0 || size > 255) return false;
+        sizes.push_back(static_cast<unsigned>(size));
+    }
+    return !sizes.empty();
+}
+
+/**
+ * @brief Rasterize one glyph the way sf::Font::loadGlyph does
+ */
+bool rasterize(FT_Face face, std::uint32_t codepoint, unsigned size,
+               BakedGlyph& baked) {
+    if (FT_Load_Char(face, codepoint,
+                     FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0) {
+        return false;
+    }
+
+    FT_Glyph glyphDesc;
+    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0) return false;
+    FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, nullptr, 1);
+    auto bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(glyphDesc);
+    const FT_Bitmap& bitmap = bitmapGlyph->bitmap;
+
+    AtlasGlyphRecord& record = baked.record;
+    std::memset(&record, 0, sizeof(record));
+    record.codepoint = codepoint;
+    record.characterSize = size;
+    record.advance = static_cast<float>(bitmapGlyph->root.advance.x >> 16);
+    record.left = static_cast<std::int16_t>(bitmapGlyph->left);
+    record.top = static_cast<std::int16_t>(-bitmapGlyph->top);
+    record.width = static_cast<std::uint16_t>(bitmap.width);
+    record.height = static_cast<std::uint16_t>(bitmap.rows);
+    record.lsbDelta = static_cast<std::int16_t>(face->glyph->lsb_delta);
+    record.rsbDelta = static_cast<std::int16_t>(face->glyph->rsb_delta);
+
+    baked.pixels.assign(static_cast<std::size_t>(bitmap.width) * bitmap.rows,
+                        0);
+    for (unsigned y = 0; y < bitmap.rows; ++y) {
+        const std::uint8_t* row = bitmap.buffer + y * bitmap.pitch;
+        for (unsigned x = 0; x < bitmap.width; ++x) {
+            std::uint8_t alpha;
+            if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO) {
+                alpha = ((row[x / 8]) & (1 << (7 - (x % 8)))) ? 255 : 0;
+            } else {
+                alpha = row[x];
+            }
+            baked.pixels[y * bitmap.width + x] = alpha;
+        }
+    }
+
+    FT_Done_Glyph(glyphDesc);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <font> <output.ffga> <size>[,<size>...]\n";
+        return 1;
+    }
+
+    std::vector<unsigned> sizes;
+    if (!parseSizes(argv[3], sizes)) {
+        std::cerr << "ERROR::ATLASBAKER::Invalid size list: " << argv[3]
+                  << "\n";
+        return 1;
+    }
+
+    FT_Library library;
+    FT_Face face;
+    if (FT_Init_FreeType(&library) != 0 ||
+        FT_New_Face(library, argv[1], 0, &face) != 0) {
+        std::cerr << "ERROR::ATLASBAKER::Cannot load font: " << argv[1]
+                  << "\n";
+        return 1;
+    }
+    FT_Select_Charmap(face, FT_ENCODING_UNICODE);
+
+    std::vector<AtlasSizeRecord> sizeRecords;
+    std::vector<BakedGlyph> glyphs;
+    std::vector<AtlasKerningRecord> kerning;
+    ShelfPacker packer(ATLAS_WIDTH);
+
+    for (unsigned size : sizes) {
+        FT_Set_Pixel_Sizes(face, 0, size);
+        sizeRecords.push_back(
+            {size, static_cast<float>(face->size->metrics.height) / 64.f});
+
+        for (std::uint32_t c = ATLAS_FIRST_CHAR; c <= ATLAS_LAST_CHAR; ++c) {
+            BakedGlyph baked;
+            if (!rasterize(face, c, size, baked)) {
+                std::cerr << "ERROR::ATLASBAKER::Cannot rasterize U+" << c
+                          << " at " << size << "px\n";
+                return 1;
+            }
+
+            unsigned x = 0, y = 0;
+            if (baked.record.width > 0 && baked.record.height > 0) {
+                packer.insert(baked.record.width + 2 * ATLAS_GLYPH_PADDING,
+                              baked.record.height + 2 * ATLAS_GLYPH_PADDING,
+                              x, y);
+                x += ATLAS_GLYPH_PADDING;
+                y += ATLAS_GLYPH_PADDING;
+            }
+            baked.record.x = static_cast<std::uint16_t>(x);
+            baked.record.y = static_cast<std::uint16_t>(y);
+            glyphs.push_back(std::move(baked));
+        }
+
+        if (FT_HAS_KERNING(face)) {
+            for (std::uint32_t a = ATLAS_FIRST_CHAR; a <= ATLAS_LAST_CHAR;
+                 ++a) {
+                for (std::uint32_t b = ATLAS_FIRST_CHAR; b <= ATLAS_LAST_CHAR;
+                     ++b) {
+                    FT_Vector offset{0, 0};
+                    FT_Get_Kerning(face, FT_Get_Char_Index(face, a),
+                                   FT_Get_Char_Index(face, b),
+                                   FT_KERNING_UNFITTED, &offset);
+                    if (offset.x != 0) {
+                        kerning.push_back({a, b, size,
+                                           static_cast<std::int32_t>(offset.x)});
+                    }
+                }
+            }
+        }
+    }
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+
+    // Round the height up so the texture has tidy dimensions
+    const unsigned height = (packer.getHeight() + 63) & ~63u;
+    std::vector<std::uint8_t> pixels(ATLAS_WIDTH * height, 0);
+    for (const BakedGlyph& glyph : glyphs) {
+        const AtlasGlyphRecord& r = glyph.record;
+        for (unsigned y = 0; y < r.height; ++y) {
+            std::memcpy(&pixels[(r.y + y) * ATLAS_WIDTH + r.x],
+                        &glyph.pixels[y * r.width], r.width);
+        }
+    }
+
+    // Mostly empty space, so this compresses well
+    std::vector<std::uint8_t> stored =
+        Lz4Lite::compress(pixels.data(), pixels.size());
+
+    AtlasHeader header;
+    std::memcpy(header.magic, ATLAS_MAGIC, sizeof(header.magic));
+    header.version = ATLAS_VERSION;
+    header.flags = ATLAS_PIXELS_LZ4;
+    header.width = static_cast<std::uint16_t>(ATLAS_WIDTH);
+    header.height = static_cast<std::uint16_t>(height);
+    header.sizeCount = static_cast<std::uint32_t>(sizeRecords.size());
+    header.glyphCount = static_cast<std::uint32_t>(glyphs.size());
+    header.kerningCount = static_cast<std::uint32_t>(kerning.size());
+    header.pixelBytes = static_cast<std::uint32_t>(stored.size());
+
+    std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "ERROR::ATLASBAKER::Cannot write atlas: " << argv[2]
+                  << "\n";
+        return 1;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(sizeRecords.data()),
+              static_cast<std::streamsize>(sizeRecords.size() *
+                                           sizeof(AtlasSizeRecord)));
+    for (const BakedGlyph& glyph : glyphs) {
+        out.write(reinterpret_cast<const char*>(&glyph.record),
+                  sizeof(AtlasGlyphRecord));
+    }
+    out.write(reinterpret_cast<const char*>(kerning.data()),
+              static_cast<std::streamsize>(kerning.size() *
+                                           sizeof(AtlasKerningRecord)));
+    out.write(reinterpret_cast<const char*>(stored.data()),
+              static_cast<std::streamsize>(stored.size()));
+
+    if (!out) {
+        std::cerr << "ERROR::ATLASBAKER::Write failed: " << argv[2] << "\n";
+        return 1;
+    }
+
+    std::cout << "Baked " << glyphs.size() << " glyphs, " << kerning.size()
+              << " kerning pairs into " << argv[2] << " (" << ATLAS_WIDTH
+              << "x" << height << ", " << stored.size() << " bytes)\n";
+    return 0;
+}
@@ -0,0 +1,368 @@
+/**
+ * @file PerfGate.cpp
+ * @brief Replays scenarios headlessly and fails on performance regressions
+ *
+ * Usage: perf_gate <scenario-dir> [--runs N] [--baseline FILE]
+ *                  [--save-baseline FILE] [--ab OTHER_PERF_GATE]
+ *                  [--alpha P] [--threshold PERCENT]
+ *
+ * Every run of every scenario happens in a fresh child process (so peak
+ * RSS belongs to that run alone) at the scenario's fixed timestep. Each
+ * child reports its frame-time distribution, time per subsystem,
+ * allocations and peak RSS.
+ *
+ * Runs are compared against either a baseline file written earlier with
+ * --save-baseline, or, better, a perf_gate binary built from the base
+ * commit (--ab). With --ab the two binaries alternate run by run (ABBA),
+ * so drift in machine load hits both sides alike. A timing metric is a
+ * regression when a one-sided Mann-Whitney test gives p < alpha AND the
+ * median moved by more than the threshold; allocations and peak RSS are
+ * near-deterministic and only use the threshold. Exit code 1 on any
+ * regression.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "sim/HeadlessGame.h"
+#include "sim/Scenario.h"
+#include "systems/AllocationCounter.h"
+#include "systems/PerfStats.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#endif
+
+namespace {
+
+constexpr const char* CHILD_FLAG = "--child";
+constexpr const char* METRIC_TAG = "PERF";
+
+// scenario -> metric -> one sample per run
+using Samples = std::map<std::string, std::map<std::string, std::vector<double>>>;
+
+enum class Gate { TIMING, SIZE, NONE };
+
+struct MetricInfo {
+    const char* name;
+    Gate gate;
+};
+
+const MetricInfo METRICS[] = {
+    {"frame_mean_us", Gate::TIMING},  {"frame_p50_us", Gate::TIMING},
+    {"frame_p99_us", Gate::TIMING},   {"frame_max_us", Gate::NONE},
+    {"simulation_us", Gate::TIMING},  {"particles_us", Gate::TIMING},
+    {"hud_us", Gate::TIMING},         {"allocs_per_frame", Gate::SIZE},
+    {"alloc_bytes_per_frame", Gate::SIZE}, {"peak_rss_kb", Gate::SIZE},
+    {"points", Gate::NONE},
+};
+
+long peakRssKb() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // Bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Child side: play one scenario and print "PERF <metric> <value>"
+ */
+int runChild(const std::string& path) {
+    Scenario scenario;
+    if (!Scenario::load(path, scenario)) return 1;
+
+    HeadlessGame game(scenario.config, scenario.seed, scenario.particlePool);
+    game.setTimed(true);
+    ScenarioPlayer player(scenario);
+
+    std::vector<double> frames;
+    frames.reserve(scenario.frames);
+    double simulationUs = 0.0, particlesUs = 0.0, hudUs = 0.0;
+    unsigned points = 0;
+
+    AllocationScope allocations;
+    while (!player.finished()) {
+        const auto start = std::chrono::steady_clock::now();
+        player.playFrame(game);
+        frames.push_back(std::chrono::duration<double, std::micro>(
+                             std::chrono::steady_clock::now() - start)
+                             .count());
+        const FrameTimings& timings = game.getTimings();
+        simulationUs += timings.simulationUs;
+        particlesUs += timings.particlesUs;
+        hudUs += timings.hudUs;
+        points = std::max(points, game.getSim().getPoints());
+    }
+    const double frameCount = std::max<std::size_t>(frames.size(), 1);
+    const double allocs = static_cast<double>(allocations.allocations());
+    const double bytes = static_cast<double>(allocations.bytes());
+
+    std::printf("%s frame_mean_us %.4f\n", METRIC_TAG, PerfStats::mean(frames));
+    std::printf("%s frame_p50_us %.4f\n", METRIC_TAG,
+                PerfStats::percentile(frames, 0.50));
+    std::printf("%s frame_p99_us %.4f\n", METRIC_TAG,
+                PerfStats::percentile(frames, 0.99));
+    std::printf("%s frame_max_us %.4f\n", METRIC_TAG,
+                PerfStats::percentile(frames, 1.0));
+    std::printf("%s simulation_us %.4f\n", METRIC_TAG, simulationUs / frameCount);
+    std::printf("%s particles_us %.4f\n", METRIC_TAG, particlesUs / frameCount);
+    std::printf("%s hud_us %.4f\n", METRIC_TAG, hudUs / frameCount);
+    std::printf("%s allocs_per_frame %.4f\n", METRIC_TAG, allocs / frameCount);
+    std::printf("%s alloc_bytes_per_frame %.4f\n", METRIC_TAG,
+                bytes / frameCount);
+    std::printf("%s peak_rss_kb %ld\n", METRIC_TAG, peakRssKb());
+    std::printf("%s points %u\n", METRIC_TAG,
+                std::max(points, game.getMaxPoint()));
+    return 0;
+}
+
+std::string selfPath(const char* argv0) {
+#ifdef __linux__
+    char self[4096];
+    const ssize_t length = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (length > 0) return std::string(self, static_cast<std::size_t>(length));
+#endif
+    return argv0;
+}
+
+/**
+ * @brief Parent side: run @p executable's child mode once
+ */
+bool launch(const std::string& executable, const std::string& scenarioPath,
+            std::map<std::string, double>& metrics) {
+    const std::string command = "\"" + executable + "\" " + CHILD_FLAG +
+                                " \"" + scenarioPath + "\"";
+    FILE* pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr) return false;
+
+    char line[512];
+    char name[128];
+    double value = 0.0;
+    while (std::fgets(line, sizeof(line), pipe) != nullptr) {
+        if (std::sscanf(line, "PERF %127s %lf", name, &value) == 2) {
+            metrics[name] = value;
+        }
+    }
+    return pclose(pipe) == 0 && !metrics.empty();
+}
+
+bool loadBaseline(const std::string& path, Samples& samples) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::PERFGATE::Cannot read baseline " << path << "\n";
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string scenario, metric;
+        fields >> scenario >> metric;
+        double value;
+        while (fields >> value) samples[scenario][metric].push_back(value);
+    }
+    return true;
+}
+
+bool saveBaseline(const std::string& path, const Samples& samples) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::PERFGATE::Cannot write baseline " << path << "\n";
+        return false;
+    }
+    file << "# perf_gate baseline: scenario metric sample...\n";
+    for (const auto& [scenario, metrics] : samples) {
+        for (const auto& [metric, values] : metrics) {
+            file << scenario << " " << metric;
+            for (double value : values) file << " " << value;
+            file << "\n";
+        }
+    }
+    std::cout << "Saved baseline: " << path << "\n";
+    return true;
+}
+
+/**
+ * @return Number of regressions
+ */
+int compare(const Samples& base, const Samples& current, double alpha,
+            double threshold) {
+    int regressions = 0;
+    std::printf("\n%-34s %12s %12s %9s %9s\n", "scenario/metric", "base",
+                "current", "change", "p");
+    for (const auto& [scenario, metrics] : current) {
+        const auto baseScenario = base.find(scenario);
+        if (baseScenario == base.end()) {
+            std::printf("%-34s (not in baseline)\n", scenario.c_str());
+            continue;
+        }
+        for (const MetricInfo& info : METRICS) {
+            const auto now = metrics.find(info.name);
+            const auto then = baseScenario->second.find(info.name);
+            if (now == metrics.end() || then == baseScenario->second.end()) {
+                continue;
+            }
+
+            const double baseMedian = PerfStats::median(then->second);
+            const double currentMedian = PerfStats::median(now->second);
+            const double change =
+                baseMedian != 0.0 ? (currentMedian - baseMedian) / baseMedian
+                                  : (currentMedian != 0.0 ? 1.0 : 0.0);
+            const double p =
+                PerfStats::mannWhitneyGreater(then->second, now->second);
+
+            const char* verdict = "";
+            if (info.gate == Gate::TIMING && p < alpha && change > threshold) {
+                verdict = "REGRESSION";
+            } else if (info.gate == Gate::SIZE && change > threshold) {
+                verdict = "REGRESSION";
+            } else if (info.gate == Gate::NONE &&
+                       std::strcmp(info.name, "points") == 0 &&
+                       change != 0.0) {
+                verdict = "behaviour changed";
+            }
+            if (std::strcmp(verdict, "REGRESSION") == 0) ++regressions;
+
+            const std::string label = scenario + "/" + info.name;
+            std::printf("%-34s %12.3f %12.3f %+8.1f%% %9.4f  %s\n",
+                        label.c_str(), baseMedian, currentMedian,
+                        change * 100.0, p, verdict);
+        }
+    }
+    return regressions;
+}
+
+void printSummary(const Samples& samples) {
+    std::printf("\n%-34s %12s %12s %12s\n", "scenario/metric", "median",
+                "min", "max");
+    for (const auto& [scenario, metrics] : samples) {
+        for (const MetricInfo& info : METRICS) {
+            const auto found = metrics.find(info.name);
+            if (found == metrics.end()) continue;
+            const std::vector<double>& values = found->second;
+            const std::string label = scenario + "/" + info.name;
+            std::printf("%-34s %12.3f %12.3f %12.3f\n", label.c_str(),
+                        PerfStats::median(values),
+                        *std::min_element(values.begin(), values.end()),
+                        *std::max_element(values.begin(), values.end()));
+        }
+    }
+}
+
+int usage(const char* argv0) {
+    std::cerr << "Usage: " << argv0
+              << " <scenario-dir> [--runs N] [--baseline FILE]"
+                 " [--save-baseline FILE] [--ab OTHER_PERF_GATE]"
+                 " [--alpha P] [--threshold PERCENT]\n";
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], CHILD_FLAG) == 0) {
+        return runChild(argv[2]);
+    }
+    if (argc < 2 || argv[1][0] == '-') return usage(argv[0]);
+
+    const std::string directory = argv[1];
+    int runs = 10;
+    std::string baselinePath, savePath, otherExecutable;
+    double alpha = 0.01;
+    double threshold = 0.05;
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--runs" && hasValue) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--baseline" && hasValue) {
+            baselinePath = argv[++i];
+        } else if (arg == "--save-baseline" && hasValue) {
+            savePath = argv[++i];
+        } else if (arg == "--ab" && hasValue) {
+            otherExecutable = argv[++i];
+        } else if (arg == "--alpha" && hasValue) {
+            alpha = std::atof(argv[++i]);
+        } else if (arg == "--threshold" && hasValue) {
+            threshold = std::atof(argv[++i]) / 100.0;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    const std::vector<std::string> scenarios = Scenario::list(directory);
+    if (scenarios.empty()) {
+        std::cerr << "ERROR::PERFGATE::No .scenario files in " << directory
+                  << "\n";
+        return 1;
+    }
+
+    const std::string self = selfPath(argv[0]);
+    const bool ab = !otherExecutable.empty();
+    Samples base;
+    Samples current;
+    if (!ab && !baselinePath.empty() && !loadBaseline(baselinePath, base)) {
+        return 1;
+    }
+
+    // Scenarios round-robin inside each run; with --ab the order of the
+    // two binaries flips every run
+    for (int run = 0; run < runs; ++run) {
+        for (const std::string& path : scenarios) {
+            Scenario scenario;
+            if (!Scenario::load(path, scenario)) return 1;
+
+            const bool otherFirst = ab && run % 2 == 0;
+            for (int side = 0; side < (ab ? 2 : 1); ++side) {
+                const bool other = ab && (side == 0) == otherFirst;
+                std::map<std::string, double> metrics;
+                if (!launch(other ? otherExecutable : self, path, metrics)) {
+                    std::cerr << "ERROR::PERFGATE::Run " << (run + 1) << " of "
+                              << scenario.name << " failed"
+                              << (other ? " (baseline binary)" : "") << "\n";
+                    return 1;
+                }
+                Samples& into = other ? base : current;
+                for (const auto& [metric, value] : metrics) {
+                    into[scenario.name][metric].push_back(value);
+                }
+            }
+        }
+        std::printf("run %d/%d done\n", run + 1, runs);
+        std::fflush(stdout);
+    }
+
+    printSummary(current);
+    if (!savePath.empty() && !saveBaseline(savePath, current)) return 1;
+    if (!ab && baselinePath.empty()) return 0;
+
+    const int regressions = compare(base, current, alpha, threshold);
+    std::printf("\nPERF GATE: %s (%d regression%s, alpha %.3g, threshold "
+                "%.1f%%)\n",
+                regressions ? "FAIL" : "PASS", regressions,
+                regressions == 1 ? "" : "s", alpha, threshold * 100.0);
+    return regressions ? 1 : 0;
+}